@@ -22,10 +22,21 @@
 #include "audio/chip.h"
 #include "audio/mixer.h"
 
+#include "common/config-manager.h"
+#include "common/thread.h"
 #include "common/timer.h"
 
 namespace Audio {
 
+namespace {
+
+enum {
+	/** The number of frames rendered ahead while holding the mixer mutex. */
+	kRenderAheadChunk = 256
+};
+
+} // End of anonymous namespace
+
 void Chip::start(TimerCallback *callback, int timerFrequency) {
 	_callback.reset(callback);
 	startCallbacks(timerFrequency);
@@ -97,7 +108,14 @@ EmulatedChip::EmulatedChip() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) { }
+	_handle(new Audio::SoundHandle()),
+	_renderAhead(false),
+	_ring(nullptr),
+	_ringFrames(0),
+	_renderThread(nullptr),
+	_renderWakeUp(nullptr),
+	_callbackThread(0),
+	_lastWriteTime(0) { }
 
 EmulatedChip::~EmulatedChip() {
 	// Stop callbacks, just in case. If it's still playing at this
@@ -112,28 +130,114 @@ EmulatedChip::~EmulatedChip() {
 int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
-	int step;
 
-	do {
-		step = len;
+	if (_renderAhead) {
+		uint32 pos = _playPos.load();
+		uint32 available = MIN<uint32>(_renderPos.load() - pos, len);
+
+		while (available) {
+			const uint32 index = pos % _ringFrames;
+			const uint32 step = MIN<uint32>(available, _ringFrames - index);
+			memcpy(buffer, _ring + index * stereoFactor, step * stereoFactor * sizeof(int16));
+
+			buffer += step * stereoFactor;
+			pos += step;
+			available -= step;
+			len -= step;
+		}
+
+		_playPos.store(pos);
+
+		// Let the render thread fill up the space just freed
+		_renderWakeUp->post();
+	}
+
+	// Render whatever the ring buffer could not provide in place
+	if (len) {
+		renderSamples(buffer, len);
+		_playPos.store(_renderPos.load());
+	}
+
+	return numSamples;
+}
+
+void EmulatedChip::renderSamples(int16 *buffer, int numFrames) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	uint32 pos = _renderPos.load();
+
+	while (numFrames) {
+		int step = numFrames;
 		if (step > (_nextTick >> FIXP_SHIFT))
 			step = (_nextTick >> FIXP_SHIFT);
 
+		if (_renderAhead)
+			step = applyQueuedWrites(step);
+
 		generateSamples(buffer, step * stereoFactor);
 
+		pos += step;
+		_renderPos.store(pos);
+
 		_nextTick -= step << FIXP_SHIFT;
 		if (!(_nextTick >> FIXP_SHIFT)) {
-			if (_callback && _callback->isValid())
+			if (_callback && _callback->isValid()) {
+				_callbackThread = Common::Thread::getCurrentId();
+				_inCallback.store(1);
 				(*_callback)();
+				_inCallback.store(0);
+			}
 
 			_nextTick += _samplesPerTick;
 		}
 
 		buffer += step * stereoFactor;
-		len -= step;
-	} while (len);
+		numFrames -= step;
+	}
+}
 
-	return numSamples;
+bool EmulatedChip::queueWrite(WriteType type, int a, int v) {
+	if (!_renderAhead)
+		return false;
+
+	QueuedWrite write;
+	write.type = type;
+	write.a = a;
+	write.v = v;
+
+	// Writes from the callback belong to the frame being rendered. Others
+	// are delayed by the length of the ring buffer, which is as far as
+	// rendering can be ahead of playback.
+	if (_inCallback.load() && _callbackThread == Common::Thread::getCurrentId())
+		write.time = _renderPos.load();
+	else
+		write.time = _playPos.load() + _ringFrames;
+
+	Common::StackLock lock(_writeMutex);
+
+	// Never reorder writes
+	if ((int32)(write.time - _lastWriteTime) < 0)
+		write.time = _lastWriteTime;
+	_lastWriteTime = write.time;
+
+	_writes.push(write);
+	return true;
+}
+
+uint32 EmulatedChip::applyQueuedWrites(uint32 maxFrames) {
+	const uint32 pos = _renderPos.load();
+
+	Common::StackLock lock(_writeMutex);
+
+	while (!_writes.empty()) {
+		const int32 delay = (int32)(_writes.front().time - pos);
+		if (delay > 0)
+			return MIN<uint32>(delay, maxFrames);
+
+		const QueuedWrite write = _writes.pop();
+		applyWrite(write.type, write.a, write.v);
+	}
+
+	return maxFrames;
 }
 
 int EmulatedChip::getRate() const {
@@ -142,11 +246,105 @@ int EmulatedChip::getRate() const {
 
 void EmulatedChip::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
+
+	if (supportsRenderAhead() && ConfMan.hasKey("opl_render_ahead") && ConfMan.getBool("opl_render_ahead"))
+		startRenderAhead();
+
 	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedChip::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+
+	if (_renderAhead)
+		stopRenderAhead();
+}
+
+void EmulatedChip::startRenderAhead() {
+	Audio::Mixer *mixer = g_system->getMixer();
+
+	// Stay up to two mixer buffers ahead. The size is a power of two, so
+	// that the positions can wrap around.
+	const uint32 minFrames = MAX<uint32>(mixer->getOutputBufSize(), kRenderAheadChunk) * 2;
+	_ringFrames = kRenderAheadChunk;
+	while (_ringFrames < minFrames)
+		_ringFrames <<= 1;
+
+	_ring = new int16[_ringFrames * (isStereo() ? 2 : 1)];
+	_playPos.store(0);
+	_renderPos.store(0);
+	_lastWriteTime = 0;
+
+	_stopRender.store(0);
+	_renderWakeUp = new Common::Semaphore();
+	_renderAhead = true;
+	_renderThread = new Common::Thread(renderThreadProc, this, "EmulatedChip");
+
+	// Without threads, everything is rendered in place
+	if (!_renderThread->isRunning()) {
+		_renderAhead = false;
+		delete _renderThread;
+		_renderThread = nullptr;
+		delete _renderWakeUp;
+		_renderWakeUp = nullptr;
+		delete[] _ring;
+		_ring = nullptr;
+	}
+}
+
+void EmulatedChip::stopRenderAhead() {
+	_stopRender.store(1);
+	_renderWakeUp->post();
+	delete _renderThread;
+	_renderThread = nullptr;
+	delete _renderWakeUp;
+	_renderWakeUp = nullptr;
+
+	_renderAhead = false;
+
+	// Writes still queued are not lost, so that the chip ends up in the
+	// state the caller expects
+	{
+		Common::StackLock lock(_writeMutex);
+		while (!_writes.empty()) {
+			const QueuedWrite write = _writes.pop();
+			applyWrite(write.type, write.a, write.v);
+		}
+	}
+
+	delete[] _ring;
+	_ring = nullptr;
+}
+
+void EmulatedChip::renderThreadProc(void *data) {
+	EmulatedChip *chip = (EmulatedChip *)data;
+	Common::Mutex &mutex = g_system->getMixer()->mutex();
+
+	while (!chip->_stopRender.load()) {
+		// Chip callbacks expect to be run with the mixer mutex held. Release
+		// it between chunks, so that the mixer is not blocked for long.
+		bool more = true;
+		while (more && !chip->_stopRender.load()) {
+			Common::StackLock lock(mutex);
+			more = chip->renderAhead();
+		}
+
+		// Sleep until the mixer has played some of the ring buffer
+		chip->_renderWakeUp->wait();
+	}
+}
+
+bool EmulatedChip::renderAhead() {
+	const uint32 pos = _renderPos.load();
+	const uint32 free = _ringFrames - (pos - _playPos.load());
+	if (!free)
+		return false;
+
+	const uint32 index = pos % _ringFrames;
+	const uint32 frames = MIN<uint32>(MIN<uint32>(free, _ringFrames - index), kRenderAheadChunk);
+	renderSamples(_ring + index * (isStereo() ? 2 : 1), frames);
+
+	return frames < free;
 }
 
 void EmulatedChip::setCallbackFrequency(int timerFrequency) {
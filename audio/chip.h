@@ -22,11 +22,19 @@
 #ifndef AUDIO_CHIP_H
 #define AUDIO_CHIP_H
 
+#include "common/atomic.h"
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
+#include "common/queue.h"
 
 #include "audio/audiostream.h"
 
+namespace Common {
+class Semaphore;
+class Thread;
+}
+
 namespace Audio {
 class SoundHandle;
 
@@ -108,6 +116,14 @@ private:
  *
  * This will send callbacks based on the number of samples
  * decoded in readBuffer().
+ *
+ * Chips supporting it can render ahead of the mixer when the
+ * "opl_render_ahead" setting is enabled. Samples are then generated on
+ * a thread of their own into a ring buffer, and readBuffer() only copies them
+ * out, falling back to rendering in place should the buffer run dry.
+ * Register writes from outside the timer callback are queued and applied
+ * at a fixed delay, one ring buffer length after the sample currently
+ * being played, so that their relative timing is preserved.
  */
 class EmulatedChip : virtual public Chip, protected Audio::AudioStream {
 protected:
@@ -142,6 +158,31 @@ protected:
 	 */
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
+	enum WriteType {
+		kWritePort,
+		kWriteRegister
+	};
+
+	/**
+	 * Whether the chip can render ahead of the mixer. Chips returning true
+	 * must pass all register writes through queueWrite().
+	 */
+	virtual bool supportsRenderAhead() const { return false; }
+
+	/**
+	 * Queue a register write if rendering ahead.
+	 *
+	 * @return true if the write was queued. applyWrite() will be called
+	 *         for it later on. If false, the caller must apply the write
+	 *         itself right away.
+	 */
+	bool queueWrite(WriteType type, int a, int v);
+
+	/**
+	 * Apply a write queued by queueWrite().
+	 */
+	virtual void applyWrite(WriteType type, int a, int v) {}
+
 private:
 	int _baseFreq;
 
@@ -149,6 +190,59 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+
+	struct QueuedWrite {
+		uint32 time;
+		WriteType type;
+		int a;
+		int v;
+	};
+
+	/** Whether samples are rendered on _renderThread. */
+	bool _renderAhead;
+
+	/** The ring buffer holding the samples from _playPos to _renderPos. */
+	int16 *_ring;
+	uint32 _ringFrames;
+
+	/** The frame played next. Read by other threads when queueing writes. */
+	Common::Atomic<uint32> _playPos;
+	/** The frame rendered next. */
+	Common::Atomic<uint32> _renderPos;
+
+	/** The thread filling the ring buffer, woken up by readBuffer() through _renderWakeUp. */
+	Common::Thread *_renderThread;
+	Common::Semaphore *_renderWakeUp;
+	Common::Atomic<uint32> _stopRender;
+	/** Whether the timer callback is running. */
+	Common::Atomic<uint32> _inCallback;
+	/**
+	 * The thread running the timer callback, so that register writes made by
+	 * other threads meanwhile are not taken for writes of the callback. Only
+	 * the callback thread can find its own id here, so reading it from other
+	 * threads while it changes does no harm.
+	 */
+	uintptr _callbackThread;
+
+	Common::Mutex _writeMutex;
+	Common::Queue<QueuedWrite> _writes;
+	uint32 _lastWriteTime;
+
+	/** Render @p numFrames frames, sending callbacks and applying queued writes. */
+	void renderSamples(int16 *buffer, int numFrames);
+	/** Apply the queued writes that are due, and return the number of frames until the next one. */
+	uint32 applyQueuedWrites(uint32 maxFrames);
+	/**
+	 * Render the next chunk into the ring buffer. Called with the mixer
+	 * mutex held.
+	 *
+	 * @return true if the ring buffer is not full yet.
+	 */
+	bool renderAhead();
+
+	void startRenderAhead();
+	void stopRenderAhead();
+	static void renderThreadProc(void *data);
 };
 
 } // End of namespace Audio
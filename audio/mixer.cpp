@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -36,13 +37,47 @@ namespace Audio {
 #pragma mark --- Channel classes ---
 #pragma mark -
 
+/**
+ * Passes reads through to another stream, measuring how long they take.
+ * Used while the mixer is being profiled.
+ */
+class ProfilingAudioStream : public AudioStream {
+public:
+	ProfilingAudioStream(AudioStream &stream) : _stream(stream), _micros(0), _starved(false) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const uint64 start = g_system->getMicros();
+		const int samples = _stream.readBuffer(buffer, numSamples);
+		_micros += g_system->getMicros() - start;
+
+		// Running out of data before the end means the producer can't keep up
+		if (samples < numSamples && !_stream.endOfStream())
+			_starved = true;
+
+		return samples;
+	}
+
+	bool isStereo() const override { return _stream.isStereo(); }
+	int getRate() const override { return _stream.getRate(); }
+	bool endOfData() const override { return _stream.endOfData(); }
+	bool endOfStream() const override { return _stream.endOfStream(); }
+
+	uint32 getMicros() const { return (uint32)_micros; }
+	bool isStarved() const { return _starved; }
+
+private:
+	AudioStream &_stream;
+	uint64 _micros;
+	bool _starved;
+};
+
 
 /**
  * Channel used by the default Mixer implementation.
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(MixerImpl *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, ResamplerQuality quality);
 	~Channel();
 
 	/**
@@ -168,11 +203,6 @@ public:
 	 */
 	void notifyGlobalVolChange() { updateChannelVolumes(); }
 
-	/**
-	 * Queries how long the channel has been playing.
-	 */
-	Timestamp getElapsedTime();
-
 	/**
 	 * Replaces the channel's stream with a version that loops indefinitely.
 	 */
@@ -195,6 +225,12 @@ public:
 	 */
 	SoundHandle getHandle() const { return _handle; }
 
+	/**
+	 * Sets the mixer slot state the channel publishes its playback
+	 * progress to.
+	 */
+	void setState(MixerImpl::ChannelState *state) { _state = state; }
+
 private:
 	const Mixer::SoundType _type;
 	SoundHandle _handle;
@@ -210,7 +246,14 @@ private:
 	void updateChannelVolumes();
 	st_volume_t _volL, _volR;
 
-	Mixer *_mixer;
+	MixerImpl *_mixer;
+	MixerImpl::ChannelState *_state;
+
+	/**
+	 * Makes the playback progress available to MixerImpl::getElapsedTime(),
+	 * which may be called from any thread.
+	 */
+	void publishProgress();
 
 	uint32 _samplesConsumed;
 	uint32 _samplesDecoded;
@@ -226,24 +269,52 @@ private:
 #pragma mark --- Mixer ---
 #pragma mark -
 
+MixerImpl::CommandQueueLock::CommandQueueLock(MixerImpl *mixer) : _mixer(mixer) {
+	_mixer->_commandMutex.lock();
+
+	// If the mixer callback has fallen behind (or is not running at all),
+	// carry out the queued commands here to make room. _commandMutex must
+	// not be held while waiting for _mutex, as the caller may already hold
+	// _mutex itself.
+	while (_mixer->_commandTail.load() - _mixer->_commandHead.load() >= COMMAND_QUEUE_SIZE) {
+		_mixer->_commandMutex.unlock();
+		_mixer->flushCommands();
+		_mixer->_commandMutex.lock();
+	}
+}
+
+MixerImpl::CommandQueueLock::~CommandQueueLock() {
+	_mixer->_commandMutex.unlock();
+}
+
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(0), _handleSeed(0), _soundTypeSettings(), _resamplerQuality(kResamplerLinear) {
 
 	assert(sampleRate > 0);
 
-	for (int i = 0; i != NUM_CHANNELS; i++)
+	if (ConfMan.hasKey("audio_resampler"))
+		_resamplerQuality = parseResamplerQuality(ConfMan.get("audio_resampler"));
+
+	static_assert((int)NUM_CHANNELS <= (int)MixerProfiler::kNumChannels, "The profiler must track all channels");
+	if (ConfMan.hasKey("audio_profiling"))
+		_profiler.setEnabled(ConfMan.getBool("audio_profiling"));
+
+	for (int i = 0; i != NUM_CHANNELS; i++) {
 		_channels[i] = nullptr;
+		_channelStates[i].handle.store(kFreeHandle);
+	}
 }
 
 MixerImpl::~MixerImpl() {
+	// Take over the channels which never made it to the mixer callback
+	processCommands();
+
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
 }
 
 void MixerImpl::setReady(bool ready) {
-	Common::StackLock lock(_mutex);
-
-	_mixerReady = ready;
+	_mixerReady.store(ready);
 }
 
 uint MixerImpl::getOutputRate() const {
@@ -258,29 +329,142 @@ uint MixerImpl::getOutputBufSize() const {
 	return _outBufSize;
 }
 
-void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
-	int index = -1;
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] == nullptr) {
-			index = i;
+void MixerImpl::queueCommand(Command::Type type, uint32 handle, int value, Channel *channel) {
+	// Must be called with a CommandQueueLock held
+	const uint32 tail = _commandTail.load();
+	Command &command = _commands[tail % COMMAND_QUEUE_SIZE];
+	command.type = type;
+	command.handle = handle;
+	command.value = value;
+	command.channel = channel;
+	_commandTail.store(tail + 1);
+}
+
+void MixerImpl::processCommands() {
+	// Must be called with _mutex held
+	uint32 head = _commandHead.load();
+	const uint32 tail = _commandTail.load();
+
+	while (head != tail) {
+		applyCommand(_commands[head % COMMAND_QUEUE_SIZE]);
+		_commandHead.store(++head);
+	}
+}
+
+void MixerImpl::flushCommands() {
+	Common::StackLock lock(_mutex);
+	processCommands();
+}
+
+void MixerImpl::queueCommandAndWait(Command::Type type, uint32 handle, int value) {
+	uint32 ticket;
+	{
+		CommandQueueLock lock(this);
+		queueCommand(type, handle, value);
+		ticket = _commandTail.load();
+	}
+
+	// Give the mixer callback two buffers' worth of time to pick the command
+	// up. It may not be running at all, or be waiting for a _mutex which the
+	// caller holds, so fall back to carrying the command out here.
+	const uint32 timeout = _outBufSize ? 2 * _outBufSize * 1000 / _sampleRate + 1 : 50;
+	const uint32 start = g_system->getMillis();
+	while ((int32)(ticket - _commandHead.load()) > 0) {
+		if (!_mixerReady.load() || g_system->getMillis() - start >= timeout) {
+			flushCommands();
 			break;
 		}
+		g_system->delayMillis(1);
 	}
-	if (index == -1) {
-		warning("MixerImpl::out of mixer slots");
-		delete chan;
+}
+
+void MixerImpl::applyCommand(const Command &command) {
+	const int index = command.handle % NUM_CHANNELS;
+
+	if (command.type == Command::kPlay) {
+		// The slot was claimed while it was free, so no channel can be in it
+		assert(!_channels[index]);
+		_channels[index] = command.channel;
+		return;
+	}
+
+	if (command.type == Command::kPauseAll) {
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr)
+				_channels[i]->pause(command.value != 0);
+		}
+		return;
+	}
+
+	if (command.type == Command::kUpdateVolumes) {
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] && _channels[i]->getType() == command.value)
+				_channels[i]->notifyGlobalVolChange();
+		}
+		return;
+	}
+
+	// Simply ignore requests for handles of sounds that already terminated
+	Channel *chan = _channels[index];
+	if (!chan || chan->getHandle()._val != command.handle)
 		return;
+
+	switch (command.type) {
+	case Command::kSetVolume:
+		chan->setVolume(command.value);
+		break;
+	case Command::kSetBalance:
+		chan->setBalance(command.value);
+		break;
+	case Command::kSetFaderL:
+		chan->setFaderL(command.value);
+		break;
+	case Command::kSetFaderR:
+		chan->setFaderR(command.value);
+		break;
+	case Command::kSetRate:
+		chan->setRate(command.value);
+		break;
+	case Command::kResetRate:
+		chan->resetRate();
+		break;
+	case Command::kPause:
+		chan->pause(command.value != 0);
+		break;
+	case Command::kLoop:
+		chan->loop();
+		break;
+	default:
+		break;
 	}
+}
 
-	_channels[index] = chan;
+MixerImpl::ChannelState *MixerImpl::getChannelState(SoundHandle handle) {
+	ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	if (handle._val == kFreeHandle || state.handle.load() != handle._val)
+		return nullptr;
+	return &state;
+}
+
+const MixerImpl::ChannelState *MixerImpl::getChannelState(SoundHandle handle) const {
+	const ChannelState &state = _channelStates[handle._val % NUM_CHANNELS];
+	if (handle._val == kFreeHandle || state.handle.load() != handle._val)
+		return nullptr;
+	return &state;
+}
 
-	SoundHandle chanHandle;
-	chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+Channel *MixerImpl::unlinkChannel(int index) {
+	// Must be called with _mutex held
+	Channel *chan = _channels[index];
+	_channels[index] = nullptr;
 
-	chan->setHandle(chanHandle);
-	_handleSeed++;
-	if (handle)
-		*handle = chanHandle;
+	// A new sound may have claimed the slot already, in which case the
+	// state belongs to it
+	if (chan) {
+		_channelStates[index].handle.compareExchange(chan->getHandle()._val, kFreeHandle);
+		_profiler.removeChannel(index);
+	}
+	return chan;
 }
 
 void MixerImpl::playStream(
@@ -291,52 +475,101 @@ void MixerImpl::playStream(
 			DisposeAfterUse::Flag autofreeStream,
 			bool permanent,
 			bool reverseStereo) {
-	Common::StackLock lock(_mutex);
-
 	if (stream == nullptr) {
 		warning("stream is 0");
 		return;
 	}
 
 
-	assert(_mixerReady);
+	assert(_mixerReady.load());
+
+#ifdef AUDIO_REVERSE_STEREO
+	reverseStereo = !reverseStereo;
+#endif
+
+	// Create the channel. This happens outside of any lock, so that setting
+	// up the rate converter never holds up the mixer.
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, _resamplerQuality);
+	chan->setVolume(volume);
+	chan->setBalance(balance);
+
+	int index = -1;
+
+	{
+		CommandQueueLock lock(this);
+
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			const uint32 slotHandle = _channelStates[i].handle.load();
 
-	// Prevent duplicate sounds
-	if (id != -1) {
-		for (int i = 0; i != NUM_CHANNELS; i++)
-			if (_channels[i] != nullptr && _channels[i]->getId() == id) {
+			// Prevent duplicate sounds
+			if (id != -1 && slotHandle != kFreeHandle && _channelStates[i].id.load() == id) {
 				// Delete the stream if were asked to auto-dispose it.
 				// Note: This could cause trouble if the client code does not
 				// yet expect the stream to be gone. The primary example to
 				// keep in mind here is QueuingAudioStream.
 				// Thus, as a quick rule of thumb, you should never, ever,
 				// try to play QueuingAudioStreams with a sound id.
-				if (autofreeStream == DisposeAfterUse::YES)
-					delete stream;
-				return;
+				index = -2;
+				break;
 			}
-	}
 
-#ifdef AUDIO_REVERSE_STEREO
-	reverseStereo = !reverseStereo;
-#endif
+			if (index == -1 && slotHandle == kFreeHandle)
+				index = i;
+		}
 
-	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
-	chan->setVolume(volume);
-	chan->setBalance(balance);
-	insertChannel(handle, chan);
+		if (index >= 0) {
+			SoundHandle chanHandle;
+			chanHandle._val = index + (_handleSeed * NUM_CHANNELS);
+			_handleSeed++;
+
+			ChannelState &state = _channelStates[index];
+			state.id.store(id);
+			state.type.store(type);
+			state.permanent.store(permanent);
+			state.volume.store(volume);
+			state.balance.store(balance);
+			state.faderL.store(255);
+			state.faderR.store(255);
+			state.streamRate.store(chan->getRate());
+			state.rate.store(chan->getRate());
+			state.samplesConsumed.store(0);
+			state.mixerTimeStamp.store(0);
+			state.pauseStartTime.store(0);
+			state.pauseTime.store(0);
+			state.paused.store(0);
+
+			chan->setHandle(chanHandle);
+			chan->setState(&state);
+
+			// Publishing the handle makes the channel visible to queries
+			state.handle.store(chanHandle._val);
+			queueCommand(Command::kPlay, chanHandle._val, 0, chan);
+
+			if (handle)
+				*handle = chanHandle;
+			return;
+		}
+	}
+
+	if (index == -1)
+		warning("MixerImpl::out of mixer slots");
+	delete chan;
 }
 
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	const bool profiling = _profiler.isEnabled();
+	const uint64 startMicros = profiling ? g_system->getMicros() : 0;
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
 
 	// Since the mixer callback has been called, the mixer must be ready...
-	_mixerReady = true;
+	_mixerReady.store(true);
+
+	processCommands();
 
 	//  zero the buf
 	memset(buf, 0, len);
@@ -355,8 +588,7 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		if (_channels[i]) {
 			if (_channels[i]->isFinished()) {
-				delete _channels[i];
-				_channels[i] = nullptr;
+				delete unlinkChannel(i);
 			} else if (!_channels[i]->isPaused()) {
 				tmp = _channels[i]->mix(buf, len);
 
@@ -365,154 +597,171 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 			}
 		}
 
+	if (profiling)
+		_profiler.addCallback((uint32)(g_system->getMicros() - startMicros), len, _sampleRate);
+
 	return res;
 }
 
 void MixerImpl::stopAll() {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && !_channels[i]->isPermanent()) {
-			delete _channels[i];
-			_channels[i] = nullptr;
+	Channel *stopped[NUM_CHANNELS];
+	int numStopped = 0;
+
+	{
+		Common::StackLock lock(_mutex);
+		processCommands();
+
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr && !_channels[i]->isPermanent())
+				stopped[numStopped++] = unlinkChannel(i);
 		}
 	}
+
+	// The streams are no longer referenced by the mixer, so they can be
+	// destroyed without holding up the mixer callback
+	for (int i = 0; i < numStopped; i++)
+		delete stopped[i];
 }
 
 void MixerImpl::stopID(int id) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			delete _channels[i];
-			_channels[i] = nullptr;
+	Channel *stopped[NUM_CHANNELS];
+	int numStopped = 0;
+
+	{
+		Common::StackLock lock(_mutex);
+		processCommands();
+
+		for (int i = 0; i != NUM_CHANNELS; i++) {
+			if (_channels[i] != nullptr && _channels[i]->getId() == id)
+				stopped[numStopped++] = unlinkChannel(i);
 		}
 	}
+
+	for (int i = 0; i < numStopped; i++)
+		delete stopped[i];
 }
 
 void MixerImpl::stopHandle(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 	// Simply ignore stop requests for handles of sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (!getChannelState(handle))
 		return;
 
-	delete _channels[index];
-	_channels[index] = nullptr;
+	Channel *stopped = nullptr;
+
+	{
+		Common::StackLock lock(_mutex);
+		processCommands();
+
+		const int index = handle._val % NUM_CHANNELS;
+		if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
+			stopped = unlinkChannel(index);
+	}
+
+	delete stopped;
 }
 
 void MixerImpl::muteSoundType(SoundType type, bool mute) {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	_soundTypeSettings[type].mute = mute;
+	_soundTypeSettings[type].mute.store(mute);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	CommandQueueLock lock(this);
+	queueCommand(Command::kUpdateVolumes, 0, type);
 }
 
 bool MixerImpl::isSoundTypeMuted(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
-	return _soundTypeSettings[type].mute;
+	return _soundTypeSettings[type].mute.load() != 0;
 }
 
 void MixerImpl::setChannelVolume(SoundHandle handle, byte volume) {
-	Common::StackLock lock(_mutex);
+	CommandQueueLock lock(this);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	ChannelState *state = getChannelState(handle);
+	if (!state)
 		return;
 
-	_channels[index]->setVolume(volume);
+	state->volume.store(volume);
+	queueCommand(Command::kSetVolume, handle._val, volume);
 }
 
 byte MixerImpl::getChannelVolume(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
-
-	return _channels[index]->getVolume();
+	const ChannelState *state = getChannelState(handle);
+	return state ? state->volume.load() : 0;
 }
 
 void MixerImpl::setChannelBalance(SoundHandle handle, int8 balance) {
-	Common::StackLock lock(_mutex);
+	CommandQueueLock lock(this);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	ChannelState *state = getChannelState(handle);
+	if (!state)
 		return;
 
-	_channels[index]->setBalance(balance);
+	state->balance.store(balance);
+	queueCommand(Command::kSetBalance, handle._val, balance);
 }
 
 int8 MixerImpl::getChannelBalance(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
-
-	return _channels[index]->getBalance();
+	const ChannelState *state = getChannelState(handle);
+	return state ? state->balance.load() : 0;
 }
 
 void MixerImpl::setChannelFaderL(SoundHandle handle, uint8 faderL) {
-	Common::StackLock lock(_mutex);
+	CommandQueueLock lock(this);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	ChannelState *state = getChannelState(handle);
+	if (!state)
 		return;
 
-	_channels[index]->setFaderL(faderL);
+	state->faderL.store(faderL);
+	queueCommand(Command::kSetFaderL, handle._val, faderL);
 }
 
 uint8 MixerImpl::getChannelFaderL(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
-
-	return _channels[index]->getFaderL();
+	const ChannelState *state = getChannelState(handle);
+	return state ? state->faderL.load() : 0;
 }
 
 void MixerImpl::setChannelFaderR(SoundHandle handle, uint8 faderR) {
-	Common::StackLock lock(_mutex);
+	CommandQueueLock lock(this);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	ChannelState *state = getChannelState(handle);
+	if (!state)
 		return;
 
-	_channels[index]->setFaderR(faderR);
+	state->faderR.store(faderR);
+	queueCommand(Command::kSetFaderR, handle._val, faderR);
 }
 
 uint8 MixerImpl::getChannelFaderR(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
-
-	return _channels[index]->getFaderR();
+	const ChannelState *state = getChannelState(handle);
+	return state ? state->faderR.load() : 0;
 }
 
 void MixerImpl::setChannelRate(SoundHandle handle, uint32 rate) {
-	Common::StackLock lock(_mutex);
+	CommandQueueLock lock(this);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	ChannelState *state = getChannelState(handle);
+	if (!state)
 		return;
 
-	_channels[index]->setRate(rate);
+	state->rate.store(rate);
+	queueCommand(Command::kSetRate, handle._val, rate);
 }
 
 uint32 MixerImpl::getChannelRate(SoundHandle handle) {
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return 0;
-
-	return _channels[index]->getRate();
+	const ChannelState *state = getChannelState(handle);
+	return state ? state->rate.load() : 0;
 }
 
 void MixerImpl::resetChannelRate(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	CommandQueueLock lock(this);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	ChannelState *state = getChannelState(handle);
+	if (!state)
 		return;
 
-	_channels[index]->resetRate();
+	state->rate.store(state->streamRate.load());
+	queueCommand(Command::kResetRate, handle._val);
 }
 
 uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
@@ -520,91 +769,111 @@ uint32 MixerImpl::getSoundElapsedTime(SoundHandle handle) {
 }
 
 Timestamp MixerImpl::getElapsedTime(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+	Audio::Timestamp ts(0, _sampleRate);
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
-		return Timestamp(0, _sampleRate);
+	const ChannelState *state = getChannelState(handle);
+	if (!state)
+		return ts;
 
-	return _channels[index]->getElapsedTime();
+	// Take a consistent snapshot of the progress published by the mixer
+	uint32 seq, samplesConsumed, mixerTimeStamp, pauseStartTime, pauseTime, paused;
+	do {
+		seq = state->progressSeq.load();
+		samplesConsumed = state->samplesConsumed.load();
+		mixerTimeStamp = state->mixerTimeStamp.load();
+		pauseStartTime = state->pauseStartTime.load();
+		pauseTime = state->pauseTime.load();
+		paused = state->paused.load();
+	} while ((seq & 1) || seq != state->progressSeq.load());
+
+	// The slot may have been taken over by another sound meanwhile
+	if (state->handle.load() != handle._val)
+		return ts;
+
+	if (mixerTimeStamp == 0)
+		return ts;
+
+	uint32 delta;
+	if (paused)
+		delta = pauseStartTime - mixerTimeStamp;
+	else
+		delta = g_system->getMillis(true) - mixerTimeStamp - pauseTime;
+
+	// Convert the number of samples into a time duration.
+
+	ts = ts.addFrames(samplesConsumed);
+	ts = ts.addMsecs(delta);
+
+	// In theory it would seem like a good idea to limit the approximation
+	// so that it never exceeds the theoretical upper bound set by
+	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
+	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
+	// isn't invoked at the regular intervals that I first imagined.
+
+	return ts;
 }
 
-void MixerImpl::loopChannel(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
+// Pausing and looping wait for their commands to be carried out: callers
+// expect getElapsedTime() to reflect them as soon as these return, and a
+// sound which is about to end must not be freed before it has been set to
+// loop.
 
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+void MixerImpl::loopChannel(SoundHandle handle) {
+	if (!getChannelState(handle))
 		return;
 
-	_channels[index]->loop();
+	queueCommandAndWait(Command::kLoop, handle._val);
 }
 
 void MixerImpl::pauseAll(bool paused) {
-	Common::StackLock lock(_mutex);
-	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr) {
-			_channels[i]->pause(paused);
-		}
-	}
+	queueCommandAndWait(Command::kPauseAll, 0, paused);
 }
 
 void MixerImpl::pauseID(int id, bool paused) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
-		if (_channels[i] != nullptr && _channels[i]->getId() == id) {
-			_channels[i]->pause(paused);
+		const uint32 slotHandle = _channelStates[i].handle.load();
+		if (slotHandle != kFreeHandle && _channelStates[i].id.load() == id) {
+			queueCommandAndWait(Command::kPause, slotHandle, paused);
 			return;
 		}
 	}
 }
 
 void MixerImpl::pauseHandle(SoundHandle handle, bool paused) {
-	Common::StackLock lock(_mutex);
-
 	// Simply ignore (un)pause requests for sounds that already terminated
-	const int index = handle._val % NUM_CHANNELS;
-	if (!_channels[index] || _channels[index]->getHandle()._val != handle._val)
+	if (!getChannelState(handle))
 		return;
 
-	_channels[index]->pause(paused);
+	queueCommandAndWait(Command::kPause, handle._val, paused);
 }
 
 bool MixerImpl::isSoundIDActive(int id) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getId() == id)
+		if (_channelStates[i].handle.load() != kFreeHandle && _channelStates[i].id.load() == id)
 			return true;
 	return false;
 }
 
 int MixerImpl::getSoundID(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-	const int index = handle._val % NUM_CHANNELS;
-	if (_channels[index] && _channels[index]->getHandle()._val == handle._val)
-		return _channels[index]->getId();
-	return 0;
+	const ChannelState *state = getChannelState(handle);
+	return state ? state->id.load() : 0;
 }
 
 bool MixerImpl::isSoundHandleActive(SoundHandle handle) {
-	Common::StackLock lock(_mutex);
-
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.updateSubsystems();
 #endif
 
-	const int index = handle._val % NUM_CHANNELS;
-	return _channels[index] && _channels[index]->getHandle()._val == handle._val;
+	return getChannelState(handle) != nullptr;
 }
 
 bool MixerImpl::hasActiveChannelOfType(SoundType type) {
-	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++)
-		if (_channels[i] && _channels[i]->getType() == type)
+		if (_channelStates[i].handle.load() != kFreeHandle && _channelStates[i].type.load() == type)
 			return true;
 	return false;
 }
@@ -618,19 +887,16 @@ void MixerImpl::setVolumeForSoundType(SoundType type, int volume) {
 	// TODO: Maybe we should do logarithmic (not linear) volume
 	// scaling? See also Player_V2::setMasterVolume
 
-	Common::StackLock lock(_mutex);
-	_soundTypeSettings[type].volume = volume;
+	_soundTypeSettings[type].volume.store(volume);
 
-	for (int i = 0; i != NUM_CHANNELS; ++i) {
-		if (_channels[i] && _channels[i]->getType() == type)
-			_channels[i]->notifyGlobalVolChange();
-	}
+	CommandQueueLock lock(this);
+	queueCommand(Command::kUpdateVolumes, 0, type);
 }
 
 int MixerImpl::getVolumeForSoundType(SoundType type) const {
 	assert(0 <= (int)type && (int)type < ARRAYSIZE(_soundTypeSettings));
 
-	return _soundTypeSettings[type].volume;
+	return _soundTypeSettings[type].volume.load();
 }
 
 
@@ -638,17 +904,16 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark --- Channel implementations ---
 #pragma mark -
 
-Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
-	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
+Channel::Channel(MixerImpl *mixer, Mixer::SoundType type, AudioStream *stream,
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, ResamplerQuality quality)
+	: _type(type), _mixer(mixer), _state(nullptr), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _faderL(255), _faderR(255), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
-	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
-	  _stream(stream, autofreeStream) {
+	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0), _stream(stream, autofreeStream) {
 	assert(mixer);
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), mixer->getOutputStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -754,34 +1019,22 @@ void Channel::pause(bool paused) {
 			_pauseStartTime = 0;
 		}
 	}
-}
-
-Timestamp Channel::getElapsedTime() {
-	const uint32 rate = _mixer->getOutputRate();
-	uint32 delta = 0;
-
-	Audio::Timestamp ts(0, rate);
-
-	if (_mixerTimeStamp == 0)
-		return ts;
 
-	if (isPaused())
-		delta = _pauseStartTime - _mixerTimeStamp;
-	else
-		delta = g_system->getMillis(true) - _mixerTimeStamp - _pauseTime;
-
-	// Convert the number of samples into a time duration.
-
-	ts = ts.addFrames(_samplesConsumed);
-	ts = ts.addMsecs(delta);
+	publishProgress();
+}
 
-	// In theory it would seem like a good idea to limit the approximation
-	// so that it never exceeds the theoretical upper bound set by
-	// _samplesDecoded. Meanwhile, back in the real world, doing so makes
-	// the Broken Sword cutscenes noticeably jerkier. I guess the mixer
-	// isn't invoked at the regular intervals that I first imagined.
+void Channel::publishProgress() {
+	if (!_state)
+		return;
 
-	return ts;
+	const uint32 seq = _state->progressSeq.load();
+	_state->progressSeq.store(seq + 1);
+	_state->samplesConsumed.store(_samplesConsumed);
+	_state->mixerTimeStamp.store(_mixerTimeStamp);
+	_state->pauseStartTime.store(_pauseStartTime);
+	_state->pauseTime.store(_pauseTime);
+	_state->paused.store(isPaused());
+	_state->progressSeq.store(seq + 2);
 }
 
 void Channel::loop() {
@@ -802,8 +1055,19 @@ int Channel::mix(int16 *data, uint len) {
 		_samplesConsumed = _samplesDecoded;
 		_mixerTimeStamp = g_system->getMillis(true);
 		_pauseTime = 0;
-		res = _converter->convert(*_stream, data, len, _volL, _volR);
+
+		MixerProfiler &profiler = _mixer->_profiler;
+		if (profiler.isEnabled()) {
+			ProfilingAudioStream stream(*_stream);
+			res = _converter->convert(stream, data, len, _volL, _volR);
+			profiler.addChannelMix(_handle._val % MixerImpl::NUM_CHANNELS, _handle._val, _id, _type,
+			                       _converter->getInputRate(), _stream->isStereo(), res, stream.getMicros(), stream.isStarved());
+		} else {
+			res = _converter->convert(*_stream, data, len, _volL, _volR);
+		}
+
 		_samplesDecoded += res;
+		publishProgress();
 	}
 
 	return res;
@@ -30,6 +30,7 @@ namespace Audio {
 
 class AudioStream;
 class Channel;
+class MixerProfiler;
 class Timestamp;
 
 /**
@@ -390,6 +391,13 @@ public:
 	 * @return The number of samples processed at each audio callback.
 	 */
 	virtual uint getOutputBufSize() const = 0;
+
+	/**
+	 * Return the profiler collecting timing statistics of the mixer.
+	 *
+	 * @return The profiler, or nullptr if the mixer does not support profiling.
+	 */
+	virtual MixerProfiler *getProfiler() { return nullptr; }
 };
 
 /** @} */
@@ -23,8 +23,11 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/atomic.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
+#include "audio/mixer_profiler.h"
+#include "audio/rate.h"
 
 namespace Audio {
 
@@ -57,35 +60,143 @@ namespace Audio {
  */
 class MixerImpl : public Mixer {
 private:
+	friend class Channel;
+
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		COMMAND_QUEUE_SIZE = 256
 	};
 
+	/** Handle value of a channel slot which is not in use. */
+	static const uint32 kFreeHandle = 0xffffffff;
+
 	Common::Mutex _mutex;
 
 	const uint _sampleRate;
 	const bool _stereo;
 	const uint _outBufSize;
-	bool _mixerReady;
+	Common::Atomic<uint32> _mixerReady;
 	uint32 _handleSeed;
 
 	struct SoundTypeSettings {
-		SoundTypeSettings() : mute(false), volume(kMaxMixerVolume) {}
+		SoundTypeSettings() : mute(0), volume(kMaxMixerVolume) {}
 
-		bool mute;
-		int volume;
+		Common::Atomic<int32> mute;
+		Common::Atomic<int32> volume;
 	};
 
 	SoundTypeSettings _soundTypeSettings[4];
+
+	/** The resampler used for new channels, from the "audio_resampler" setting. */
+	ResamplerQuality _resamplerQuality;
+
+	MixerProfiler _profiler;
+
+	/**
+	 * The channels being mixed. Only the mixer callback and code holding
+	 * _mutex while the command queue is drained may access these.
+	 */
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * The state of a channel slot as seen by the engine. The control
+	 * functions update it as soon as they queue a command, and the mixer
+	 * callback publishes the playback progress here, so that querying a
+	 * channel never has to wait for the mixer.
+	 */
+	struct ChannelState {
+		Common::Atomic<uint32> handle;
+		Common::Atomic<int32> id;
+		Common::Atomic<int32> type;
+		Common::Atomic<int32> permanent;
+		Common::Atomic<int32> volume;
+		Common::Atomic<int32> balance;
+		Common::Atomic<int32> faderL;
+		Common::Atomic<int32> faderR;
+		Common::Atomic<uint32> rate;
+		Common::Atomic<uint32> streamRate;
+
+		/**
+		 * Playback progress, see Channel::publishProgress(). Guarded by a
+		 * sequence counter which is odd while an update is in progress.
+		 */
+		Common::Atomic<uint32> progressSeq;
+		Common::Atomic<uint32> samplesConsumed;
+		Common::Atomic<uint32> mixerTimeStamp;
+		Common::Atomic<uint32> pauseStartTime;
+		Common::Atomic<uint32> pauseTime;
+		Common::Atomic<uint32> paused;
+	};
+
+	ChannelState _channelStates[NUM_CHANNELS];
+
+	/** A request from an engine thread, to be carried out by the mixer callback. */
+	struct Command {
+		enum Type {
+			kPlay,
+			kSetVolume,
+			kSetBalance,
+			kSetFaderL,
+			kSetFaderR,
+			kSetRate,
+			kResetRate,
+			kPause,
+			kPauseAll,
+			kLoop,
+			kUpdateVolumes
+		};
+
+		Type type;
+		uint32 handle;
+		int value;
+		Channel *channel;
+	};
+
+	/**
+	 * Single-producer/single-consumer ring of pending commands. Producers
+	 * serialize on _commandMutex, which the mixer callback never takes;
+	 * the consumer is whoever holds _mutex.
+	 */
+	Command _commands[COMMAND_QUEUE_SIZE];
+	Common::Atomic<uint32> _commandHead;
+	Common::Atomic<uint32> _commandTail;
+	Common::Mutex _commandMutex;
+
+	/** Locks _commandMutex for a producer, making sure there is room for one more command. */
+	class CommandQueueLock {
+	public:
+		explicit CommandQueueLock(MixerImpl *mixer);
+		~CommandQueueLock();
+
+	private:
+		MixerImpl *_mixer;
+	};
+
+	void queueCommand(Command::Type type, uint32 handle, int value = 0, Channel *channel = nullptr);
+	void processCommands();
+	void applyCommand(const Command &command);
+	void flushCommands();
+
+	/**
+	 * Queues a command and waits until the mixer callback has carried it
+	 * out, without contending with the callback for _mutex. If the callback
+	 * does not run in time, the command is carried out directly instead.
+	 */
+	void queueCommandAndWait(Command::Type type, uint32 handle, int value = 0);
+
+	/** Returns the state of the slot @p handle refers to, if the handle is still active. */
+	ChannelState *getChannelState(SoundHandle handle);
+	const ChannelState *getChannelState(SoundHandle handle) const;
+
+	/** Removes the channel in slot @p index, which must be deleted by the caller. */
+	Channel *unlinkChannel(int index);
 
 public:
 
 	MixerImpl(uint sampleRate, bool stereo = true, uint outBufSize = 0);
 	~MixerImpl();
 
-	virtual bool isReady() const { Common::StackLock lock(_mutex); return _mixerReady; }
+	virtual bool isReady() const { return _mixerReady.load() != 0; }
 
 	virtual Common::Mutex &mutex() { return _mutex; }
 
@@ -140,8 +251,7 @@ public:
 	virtual bool getOutputStereo() const;
 	virtual uint getOutputBufSize() const;
 
-protected:
-	void insertChannel(SoundHandle *handle, Channel *chan);
+	virtual MixerProfiler *getProfiler() { return &_profiler; }
 
 public:
 	/**
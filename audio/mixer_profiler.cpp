@@ -0,0 +1,249 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/mixer_profiler.h"
+
+#include "common/stream.h"
+#include "common/system.h"
+#include "common/util.h"
+
+namespace Audio {
+
+static const char *const soundTypeNames[] = { "plain", "music", "sfx", "speech" };
+
+MixerProfiler::MixerProfiler() : _enabled(0) {
+	reset();
+}
+
+void MixerProfiler::setEnabled(bool enabled) {
+	if (enabled && !isEnabled())
+		reset();
+	_enabled.store(enabled);
+}
+
+void MixerProfiler::reset() {
+	Common::StackLock lock(_mutex);
+
+	_startMicros = g_system->getMicros();
+	_numCallbacks = 0;
+	_numOverruns = 0;
+	_numUnderruns = 0;
+	_totalCallbackMicros = 0;
+	_maxCallbackMicros = 0;
+	_lastNumFrames = 0;
+	_lastOutputRate = 0;
+	memset(_histogram, 0, sizeof(_histogram));
+	memset(_channelUsed, 0, sizeof(_channelUsed));
+	_numFinished = 0;
+	_nextFinished = 0;
+}
+
+int MixerProfiler::getBucketIndex(uint32 micros) {
+	int bucket = 0;
+	for (uint32 limit = kFirstBucketMicros; micros >= limit && bucket < kNumHistogramBuckets - 1; limit <<= 1)
+		bucket++;
+	return bucket;
+}
+
+void MixerProfiler::addCallback(uint32 micros, uint32 numFrames, uint outputRate) {
+	Common::StackLock lock(_mutex);
+
+	_numCallbacks++;
+	_totalCallbackMicros += micros;
+	_maxCallbackMicros = MAX(_maxCallbackMicros, micros);
+	_histogram[getBucketIndex(micros)]++;
+	_lastNumFrames = numFrames;
+	_lastOutputRate = outputRate;
+
+	// Taking longer than the buffer lasts is bound to starve the device
+	if (outputRate && (uint64)micros * outputRate > (uint64)numFrames * 1000000)
+		_numOverruns++;
+}
+
+void MixerProfiler::addChannelMix(int index, uint32 handle, int id, Mixer::SoundType type, uint32 rate, bool stereo,
+                                  uint32 frames, uint32 readMicros, bool starved) {
+	assert(0 <= index && index < kNumChannels);
+
+	Common::StackLock lock(_mutex);
+
+	ChannelStats &stats = _channels[index];
+	if (!_channelUsed[index] || stats.handle != handle) {
+		_channelUsed[index] = true;
+		memset(&stats, 0, sizeof(stats));
+		stats.handle = handle;
+	}
+
+	stats.id = id;
+	stats.type = type;
+	stats.rate = rate;
+	stats.stereo = stereo;
+	stats.calls++;
+	stats.frames += frames;
+	stats.readMicros += readMicros;
+	stats.maxReadMicros = MAX(stats.maxReadMicros, readMicros);
+	if (starved)
+		stats.starvations++;
+}
+
+void MixerProfiler::removeChannel(int index) {
+	assert(0 <= index && index < kNumChannels);
+
+	Common::StackLock lock(_mutex);
+
+	if (!_channelUsed[index])
+		return;
+
+	_finished[_nextFinished] = _channels[index];
+	_nextFinished = (_nextFinished + 1) % kNumFinishedChannels;
+	_numFinished = MIN<int>(_numFinished + 1, kNumFinishedChannels);
+	_channelUsed[index] = false;
+}
+
+void MixerProfiler::addUnderrun() {
+	Common::StackLock lock(_mutex);
+	_numUnderruns++;
+}
+
+uint32 MixerProfiler::getNumCallbacks() const {
+	Common::StackLock lock(_mutex);
+	return _numCallbacks;
+}
+
+uint32 MixerProfiler::getNumOverruns() const {
+	Common::StackLock lock(_mutex);
+	return _numOverruns;
+}
+
+uint32 MixerProfiler::getNumUnderruns() const {
+	Common::StackLock lock(_mutex);
+	return _numUnderruns;
+}
+
+uint32 MixerProfiler::getHistogramBucket(int bucket) const {
+	assert(0 <= bucket && bucket < kNumHistogramBuckets);
+
+	Common::StackLock lock(_mutex);
+	return _histogram[bucket];
+}
+
+bool MixerProfiler::getChannelStats(int index, ChannelStats &stats) const {
+	assert(0 <= index && index < kNumChannels);
+
+	Common::StackLock lock(_mutex);
+	if (!_channelUsed[index])
+		return false;
+
+	stats = _channels[index];
+	return true;
+}
+
+void MixerProfiler::appendChannel(Common::String &report, const ChannelStats &stats, uint outputRate) {
+	const double avgMicros = stats.calls ? (double)stats.readMicros / stats.calls : 0.0;
+
+	// The share of the real time the stream needs for decoding
+	double load = 0.0;
+	if (stats.frames && outputRate)
+		load = 100.0 * stats.readMicros / ((double)stats.frames * 1000000.0 / outputRate);
+
+	report += Common::String::format("  %08x %6d %-6s %6u %2d %7u %9.1f %8u %6.2f%% %6u\n",
+		stats.handle, stats.id, soundTypeNames[stats.type], stats.rate, stats.stereo ? 2 : 1,
+		stats.calls, avgMicros, stats.maxReadMicros, load, stats.starvations);
+}
+
+Common::String MixerProfiler::getReport() const {
+	// Take a copy of the statistics, so that the mixer thread is not held
+	// up while the report is formatted
+	uint64 startMicros, totalCallbackMicros;
+	uint32 numCallbacks, numOverruns, numUnderruns, maxCallbackMicros, lastNumFrames;
+	uint lastOutputRate;
+	uint32 histogram[kNumHistogramBuckets];
+	ChannelStats active[kNumChannels];
+	ChannelStats finished[kNumFinishedChannels];
+	int numActive = 0, numFinished;
+
+	{
+		Common::StackLock lock(_mutex);
+
+		startMicros = _startMicros;
+		totalCallbackMicros = _totalCallbackMicros;
+		numCallbacks = _numCallbacks;
+		numOverruns = _numOverruns;
+		numUnderruns = _numUnderruns;
+		maxCallbackMicros = _maxCallbackMicros;
+		lastNumFrames = _lastNumFrames;
+		lastOutputRate = _lastOutputRate;
+		memcpy(histogram, _histogram, sizeof(histogram));
+
+		for (int i = 0; i < kNumChannels; i++) {
+			if (_channelUsed[i])
+				active[numActive++] = _channels[i];
+		}
+
+		numFinished = _numFinished;
+		for (int i = 0; i < _numFinished; i++)
+			finished[i] = _finished[(_nextFinished - _numFinished + i + kNumFinishedChannels) % kNumFinishedChannels];
+	}
+
+	Common::String report;
+
+	const double seconds = (g_system->getMicros() - startMicros) / 1000000.0;
+	report += Common::String::format("Mixer profile of the last %.1f s%s\n", seconds, isEnabled() ? "" : " (profiling disabled)");
+
+	const double deadlineMs = lastOutputRate ? lastNumFrames * 1000.0 / lastOutputRate : 0.0;
+	report += Common::String::format("Callbacks: %u, %u frames at %u Hz (%.2f ms per buffer)\n",
+		numCallbacks, lastNumFrames, lastOutputRate, deadlineMs);
+
+	const double avgMs = numCallbacks ? totalCallbackMicros / 1000.0 / numCallbacks : 0.0;
+	report += Common::String::format("Callback time: average %.3f ms, maximum %.3f ms\n", avgMs, maxCallbackMicros / 1000.0);
+	report += Common::String::format("Callbacks over deadline: %u, device underruns: %u\n", numOverruns, numUnderruns);
+
+	report += "Callback time histogram:\n";
+	uint32 lower = 0, upper = kFirstBucketMicros;
+	for (int i = 0; i < kNumHistogramBuckets; i++) {
+		if (i == kNumHistogramBuckets - 1)
+			report += Common::String::format("  %6.2f ms -          : %u\n", lower / 1000.0, histogram[i]);
+		else
+			report += Common::String::format("  %6.2f ms - %6.2f ms: %u\n", lower / 1000.0, upper / 1000.0, histogram[i]);
+		lower = upper;
+		upper <<= 1;
+	}
+
+	const char *header = "  handle       id type     rate ch   calls  avg (us) max (us)   load starved\n";
+
+	report += "Active channels:\n";
+	report += header;
+	for (int i = 0; i < numActive; i++)
+		appendChannel(report, active[i], lastOutputRate);
+
+	report += "Finished channels:\n";
+	report += header;
+	for (int i = 0; i < numFinished; i++)
+		appendChannel(report, finished[i], lastOutputRate);
+
+	return report;
+}
+
+void MixerProfiler::writeReport(Common::WriteStream &stream) const {
+	const Common::String report = getReport();
+	stream.write(report.c_str(), report.size());
+}
+
+} // End of namespace Audio
@@ -0,0 +1,174 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_MIXER_PROFILER_H
+#define AUDIO_MIXER_PROFILER_H
+
+#include "common/scummsys.h"
+#include "common/atomic.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+#include "audio/mixer.h"
+
+namespace Common {
+class WriteStream;
+}
+
+namespace Audio {
+
+/**
+ * @defgroup audio_mixer_profiler Mixer profiler
+ * @ingroup audio
+ *
+ * @brief Timing statistics of the audio mixer.
+ * @{
+ */
+
+/**
+ * Collects timing statistics of the mixer callback, to find out which
+ * sound makes the mixer miss its deadline.
+ *
+ * It records how long each mixer callback takes, how long each channel
+ * spends reading from its AudioStream, how often a stream could not
+ * provide data in time, and how often the backend ran out of audio.
+ *
+ * Profiling is disabled by default, in which case the mixer skips all
+ * measurements. It can be enabled with the "audio_profiling" setting or
+ * the "mixer_profile" debugger command.
+ */
+class MixerProfiler {
+public:
+	enum {
+		/** Number of callback duration histogram buckets. */
+		kNumHistogramBuckets = 12,
+		/** Upper bound, in microseconds, of the first histogram bucket. */
+		kFirstBucketMicros = 64,
+		/** Number of channel slots tracked. */
+		kNumChannels = 32,
+		/** Number of finished channels kept for the report. */
+		kNumFinishedChannels = 16
+	};
+
+	/** Statistics of a single sound. */
+	struct ChannelStats {
+		uint32 handle;
+		int id;
+		Mixer::SoundType type;
+		uint32 rate;
+		bool stereo;
+
+		uint32 calls;          /*!< Number of times the channel was mixed. */
+		uint64 frames;         /*!< Number of frames produced. */
+		uint64 readMicros;     /*!< Total time spent reading from the stream. */
+		uint32 maxReadMicros;  /*!< Longest time spent reading in a single callback. */
+		uint32 starvations;    /*!< Number of callbacks the stream ran out of data mid-stream. */
+	};
+
+	MixerProfiler();
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const { return _enabled.load() != 0; }
+
+	/** Discard all statistics collected so far. */
+	void reset();
+
+	/**
+	 * @name Recording
+	 * Called by the mixer and the backends while profiling is enabled.
+	 * @{
+	 */
+
+	/** Record a mixer callback of @p micros microseconds, for @p numFrames frames at @p outputRate Hz. */
+	void addCallback(uint32 micros, uint32 numFrames, uint outputRate);
+
+	/** Record that the channel in slot @p index was mixed. */
+	void addChannelMix(int index, uint32 handle, int id, Mixer::SoundType type, uint32 rate, bool stereo,
+	                   uint32 frames, uint32 readMicros, bool starved);
+
+	/** Record that the channel in slot @p index is gone. */
+	void removeChannel(int index);
+
+	/** Record that the audio device ran out of data. */
+	void addUnderrun();
+
+	/** @} */
+
+	/**
+	 * @name Querying
+	 * @{
+	 */
+
+	uint32 getNumCallbacks() const;
+	uint32 getNumOverruns() const;
+	uint32 getNumUnderruns() const;
+	uint32 getHistogramBucket(int bucket) const;
+
+	/** Return the histogram bucket a callback of @p micros microseconds is counted in. */
+	static int getBucketIndex(uint32 micros);
+
+	/**
+	 * Get the statistics of the sound in slot @p index.
+	 *
+	 * @return false if the slot has not been used since the last reset.
+	 */
+	bool getChannelStats(int index, ChannelStats &stats) const;
+
+	/** Return a human readable report of all statistics. */
+	Common::String getReport() const;
+
+	/** Write the report to @p stream. */
+	void writeReport(Common::WriteStream &stream) const;
+
+	/** @} */
+
+private:
+	Common::Atomic<uint32> _enabled;
+
+	/** Guards the statistics, which are written by the mixer thread. */
+	mutable Common::Mutex _mutex;
+
+	uint64 _startMicros;
+
+	uint32 _numCallbacks;
+	uint32 _numOverruns;
+	uint32 _numUnderruns;
+	uint64 _totalCallbackMicros;
+	uint32 _maxCallbackMicros;
+	uint32 _lastNumFrames;
+	uint _lastOutputRate;
+	uint32 _histogram[kNumHistogramBuckets];
+
+	bool _channelUsed[kNumChannels];
+	ChannelStats _channels[kNumChannels];
+
+	ChannelStats _finished[kNumFinishedChannels];
+	int _numFinished;
+	int _nextFinished;
+
+	static void appendChannel(Common::String &report, const ChannelStats &stats, uint outputRate);
+};
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -20,11 +20,14 @@ MODULE_OBJS := \
 	miles_adlib.o \
 	miles_midi.o \
 	mixer.o \
+	mixer_profiler.o \
 	mpu401.o \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
 	rate.o \
+	rate_sinc.o \
+	soundcache.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -66,6 +69,19 @@ MODULE_OBJS := \
 	softsynth/eas.o \
 	softsynth/pcspk.o
 
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	rate_neon.o
+endif
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	rate_sse2.o
+endif
+ifdef SCUMMVM_AVX2
+MODULE_OBJS += \
+	rate_avx2.o
+endif
+
 ifndef DISABLE_NUKED_OPL
 MODULE_OBJS += \
 	softsynth/opl/nuked.o
@@ -29,22 +29,14 @@
 
 #include "audio/audiostream.h"
 #include "audio/rate.h"
+#include "audio/rate_intern.h"
 #include "audio/mixer.h"
+#include "common/str.h"
+#include "common/system.h"
 #include "common/util.h"
 
 namespace Audio {
 
-/**
- * The default fractional type in frac.h (with 16 fractional bits) limits
- * the rate conversion code to 65536Hz audio: we need to able to handle
- * 192kHz audio, so we use fewer fractional bits in this code.
- */
-enum {
-	FRAC_BITS_LOW = 14,
-	FRAC_ONE_LOW = (1L << FRAC_BITS_LOW),
-	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
-};
-
 template<bool inStereo, bool outStereo, bool reverseStereo>
 class RateConverter_Impl : public RateConverter {
 private:
@@ -58,6 +50,12 @@ private:
 	 */
 	st_sample_t _buffer[512];
 
+	/**
+	 * Resampled input, gathered before volume is applied and the result
+	 * is mixed into the output buffer.
+	 */
+	st_sample_t _mixBuffer[512];
+
 	/** Current position inside the buffer */
 	const st_sample_t *_bufferPos;
 
@@ -112,30 +110,13 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::copyConvert(AudioStr
 				return (outBuffer - outStart) / (outStereo ? 2 : 1);
 		}
 
-		// Mix the data into the output buffer
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
-		_bufferSize -= (inStereo ? 2 : 1);
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// Output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// Output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-			outBuffer += 2;
-		} else {
-			// Output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+		// Mix as much of the buffered data as fits into the output buffer
+		const st_size_t frames = MIN<st_size_t>(_bufferSize / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		RateMixer::mix<inStereo, outStereo, reverseStereo>(outBuffer, _bufferPos, frames, volL, volR);
 
-			outBuffer += 1;
-		}
+		_bufferPos += frames * (inStereo ? 2 : 1);
+		_bufferSize -= frames * (inStereo ? 2 : 1);
+		outBuffer += frames * (outStereo ? 2 : 1);
 	}
 
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
@@ -152,50 +133,52 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::simpleConvert(AudioS
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
 	while (outBuffer < outEnd) {
-		// Read enough input samples so that _outPos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
-
-				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
-			}
-
-			_bufferSize -= (inStereo ? 2 : 1);
-			_outPos--;
-
-			if (_outPos >= 0) {
-				_bufferPos += (inStereo ? 2 : 1);
-			}
-		} while (_outPos >= 0);
-
-		st_sample_t inL, inR;
-		inL = *_bufferPos++;
-		inR = (inStereo ? *_bufferPos++ : inL);
+		// Gather the resampled input into the mix buffer first, so that
+		// volume and clamping can be applied to the whole block at once
+		const st_size_t maxFrames = MIN<st_size_t>(ARRAYSIZE(_mixBuffer) / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *mixPos = _mixBuffer;
+		st_sample_t *mixEnd = _mixBuffer + maxFrames * (inStereo ? 2 : 1);
+		bool endOfInput = false;
+
+		while (mixPos < mixEnd) {
+			// Read enough input samples so that _outPos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (_bufferSize == 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+					if (_bufferSize <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+
+				_bufferSize -= (inStereo ? 2 : 1);
+				_outPos--;
+
+				if (_outPos >= 0) {
+					_bufferPos += (inStereo ? 2 : 1);
+				}
+			} while (_outPos >= 0);
+
+			if (endOfInput)
+				break;
+
+			*mixPos++ = *_bufferPos++;
+			if (inStereo)
+				*mixPos++ = *_bufferPos++;
 
-		// Increment output position
-		_outPos += outPos_inc;
-
-		st_sample_t outL, outR;
-		outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-		outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-		if (outStereo) {
-			// output left channel
-			clampedAdd(outBuffer[reverseStereo    ], outL);
-
-			// output right channel
-			clampedAdd(outBuffer[reverseStereo ^ 1], outR);
+			// Increment output position
+			_outPos += outPos_inc;
+		}
 
-			outBuffer += 2;
-		} else {
-			// output mono channel
-			clampedAdd(outBuffer[0], (outL + outR) / 2);
+		const st_size_t frames = (mixPos - _mixBuffer) / (inStereo ? 2 : 1);
+		RateMixer::mix<inStereo, outStereo, reverseStereo>(outBuffer, _mixBuffer, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
 
-			outBuffer += 1;
-		}
+		if (endOfInput)
+			break;
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -210,61 +193,61 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::interpolateConvert(A
 	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
 
 	while (outBuffer < outEnd) {
-		// Read enough input samples so that _outPosFrac < 0
-		while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
-			// Check if we have to refill the buffer
-			if (_bufferSize == 0) {
-				_bufferPos = _buffer;
-				_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
-
-				if (_bufferSize <= 0)
-					return (outBuffer - outStart) / (outStereo ? 2 : 1);
+		// Gather the interpolated input into the mix buffer first, so that
+		// volume and clamping can be applied to the whole block at once
+		const st_size_t maxFrames = MIN<st_size_t>(ARRAYSIZE(_mixBuffer) / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *mixPos = _mixBuffer;
+		st_sample_t *mixEnd = _mixBuffer + maxFrames * (inStereo ? 2 : 1);
+		bool endOfInput = false;
+
+		while (mixPos < mixEnd) {
+			// Read enough input samples so that _outPosFrac < 0
+			while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+				// Check if we have to refill the buffer
+				if (_bufferSize == 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+
+					if (_bufferSize <= 0) {
+						endOfInput = true;
+						break;
+					}
+				}
+
+				_bufferSize -= (inStereo ? 2 : 1);
+				_inLastL = _inCurL;
+				_inCurL = *_bufferPos++;
+
+				if (inStereo) {
+					_inLastR = _inCurR;
+					_inCurR = *_bufferPos++;
+				}
+
+				_outPosFrac -= FRAC_ONE_LOW;
 			}
 
-			_bufferSize -= (inStereo ? 2 : 1);
-			_inLastL = _inCurL;
-			_inCurL = *_bufferPos++;
+			if (endOfInput)
+				break;
 
-			if (inStereo) {
-				_inLastR = _inCurR;
-				_inCurR = *_bufferPos++;
-			}
+			// Loop as long as the _outPos trails behind, and as long as there is
+			// still space in the mix buffer.
+			while (_outPosFrac < (frac_t)FRAC_ONE_LOW && mixPos < mixEnd) {
+				// Interpolate
+				*mixPos++ = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (inStereo)
+					*mixPos++ = (st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
-			_outPosFrac -= FRAC_ONE_LOW;
+				// Increment output position
+				_outPosFrac += outPos_inc;
+			}
 		}
 
-		// Loop as long as the _outPos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (_outPosFrac < (frac_t)FRAC_ONE_LOW && outBuffer < outEnd) {
-			// Interpolate
-			st_sample_t inL, inR;
-			inL = (st_sample_t)(_inLastL + (((_inCurL - _inLastL) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			inR = (inStereo ?
-						(st_sample_t)(_inLastR + (((_inCurR - _inLastR) * _outPosFrac + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						inL);
-
-			st_sample_t outL, outR;
-			outL = (inL * (int)volL) / Audio::Mixer::kMaxMixerVolume;
-			outR = (inR * (int)volR) / Audio::Mixer::kMaxMixerVolume;
-
-			if (outStereo) {
-				// Output left channel
-				clampedAdd(outBuffer[reverseStereo    ], outL);
-
-				// Output right channel
-				clampedAdd(outBuffer[reverseStereo ^ 1], outR);
-
-				outBuffer += 2;
-			} else {
-				// Output mono channel
-				clampedAdd(outBuffer[0], (outL + outR) / 2);
-
-				outBuffer += 1;
-			}
+		const st_size_t frames = (mixPos - _mixBuffer) / (inStereo ? 2 : 1);
+		RateMixer::mix<inStereo, outStereo, reverseStereo>(outBuffer, _mixBuffer, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
 
-			// Increment output position
-			_outPosFrac += outPos_inc;
-		}
+		if (endOfInput)
+			break;
 	}
 	return (outBuffer - outStart) / (outStereo ? 2 : 1);
 }
@@ -297,7 +280,36 @@ int RateConverter_Impl<inStereo, outStereo, reverseStereo>::convert(AudioStream
 	}
 }
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+RateMixer::MixFunc RateMixer::mixFunc = nullptr;
+
+void RateMixer::selectMixFunc() {
+	mixFunc = mixNone;
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) mixFunc = mixNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) mixFunc = mixSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) mixFunc = mixAVX2;
+#endif
+#endif
+}
+
+ResamplerQuality parseResamplerQuality(const Common::String &name) {
+	if (name.equalsIgnoreCase("sinc"))
+		return kResamplerSinc;
+	return kResamplerLinear;
+}
+
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, ResamplerQuality quality) {
+	// The sinc converter is used even while the rates match, since a channel
+	// may change its rate later and swapping converters would lose the input
+	// they have buffered
+	if (quality == kResamplerSinc)
+		return makeSincRateConverter(inRate, outRate, inStereo, outStereo, reverseStereo);
+
 	if (inStereo) {
 		if (outStereo) {
 			if (reverseStereo)
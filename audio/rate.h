@@ -24,6 +24,10 @@
 
 #include "common/frac.h"
 
+namespace Common {
+class String;
+}
+
 namespace Audio {
 /**
  * @defgroup audio_rate Sample rate
@@ -104,7 +108,33 @@ public:
 	virtual bool needsDraining() const = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+/**
+ * The algorithm a RateConverter uses when the input and output rates differ.
+ */
+enum ResamplerQuality {
+	/** Linear interpolation, or sample skipping for integer ratios. Cheap, but aliases. */
+	kResamplerLinear,
+	/** Band-limited polyphase FIR filter. Several times more expensive than linear. */
+	kResamplerSinc
+};
+
+/**
+ * Parse the name of a resampler as used by the "audio_resampler" configuration key.
+ * Unknown names map to kResamplerLinear.
+ */
+ResamplerQuality parseResamplerQuality(const Common::String &name);
+
+/**
+ * Create a RateConverter.
+ *
+ * @param inRate		The sample rate of the input stream.
+ * @param outRate		The sample rate to convert to.
+ * @param inStereo		Whether the input stream is stereo.
+ * @param outStereo		Whether the output buffer is stereo.
+ * @param reverseStereo	Whether to swap the left and right channels.
+ * @param quality		The resampling algorithm to use when the rates differ.
+ */
+RateConverter *makeRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo, ResamplerQuality quality = kResamplerLinear);
 
 /** @} */
 } // End of namespace Audio
@@ -0,0 +1,112 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_AVX2
+
+#include "audio/rate_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Audio {
+
+/**
+ * Multiply sixteen samples with the volumes in vol and divide by
+ * Mixer::kMaxMixerVolume, rounding towards zero like the generic code.
+ */
+static FORCEINLINE __m256i avx2_scale(__m256i in, __m256i vol) {
+	const __m256i lo = _mm256_mullo_epi16(in, vol);
+	const __m256i hi = _mm256_mulhi_epi16(in, vol);
+	__m256i prod0 = _mm256_unpacklo_epi16(lo, hi);
+	__m256i prod1 = _mm256_unpackhi_epi16(lo, hi);
+
+	prod0 = _mm256_srai_epi32(_mm256_add_epi32(prod0, _mm256_srli_epi32(_mm256_srai_epi32(prod0, 31), 24)), 8);
+	prod1 = _mm256_srai_epi32(_mm256_add_epi32(prod1, _mm256_srli_epi32(_mm256_srai_epi32(prod1, 31), 24)), 8);
+
+	// Unpacking and packing both work within 128-bit lanes, so this
+	// restores the original sample order
+	return _mm256_packs_epi32(prod0, prod1);
+}
+
+static FORCEINLINE void avx2_mix(st_sample_t *dst, __m256i in, __m256i vol) {
+	__m256i out = _mm256_loadu_si256((const __m256i *)dst);
+	out = _mm256_adds_epi16(out, avx2_scale(in, vol));
+	_mm256_storeu_si256((__m256i *)dst, out);
+}
+
+st_size_t RateMixer::mixAVX2(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout) {
+	if (!canUseSIMD(volL, volR))
+		return 0;
+
+	const __m256i volLR = _mm256_setr_epi16(volL, volR, volL, volR, volL, volR, volL, volR,
+	                                        volL, volR, volL, volR, volL, volR, volL, volR);
+
+	if (layout == kLayoutMonoToStereo) {
+		// Each block expands sixteen mono samples into thirty-two output samples
+		for (st_size_t i = 0; i < numFrames / 16; i++) {
+			const __m256i in = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i *)src), _MM_SHUFFLE(3, 1, 2, 0));
+			avx2_mix(dst, _mm256_unpacklo_epi16(in, in), volLR);
+			avx2_mix(dst + 16, _mm256_unpackhi_epi16(in, in), volLR);
+			src += 16;
+			dst += 32;
+		}
+		return numFrames - numFrames % 16;
+	}
+
+	if (layout == kLayoutStereoReversed) {
+		const __m256i volRL = _mm256_setr_epi16(volR, volL, volR, volL, volR, volL, volR, volL,
+		                                        volR, volL, volR, volL, volR, volL, volR, volL);
+
+		for (st_size_t i = 0; i < numFrames / 8; i++) {
+			__m256i in = _mm256_loadu_si256((const __m256i *)src);
+			in = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+			avx2_mix(dst, in, volRL);
+			src += 16;
+			dst += 16;
+		}
+		return numFrames - numFrames % 8;
+	}
+
+	for (st_size_t i = 0; i < numFrames / 8; i++) {
+		avx2_mix(dst, _mm256_loadu_si256((const __m256i *)src), volLR);
+		src += 16;
+		dst += 16;
+	}
+	return numFrames - numFrames % 8;
+}
+
+} // End of namespace Audio
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // SCUMMVM_AVX2
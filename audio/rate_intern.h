@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RATE_INTERN_H
+#define AUDIO_RATE_INTERN_H
+
+#include "audio/rate.h"
+#include "audio/mixer.h"
+
+class RateMixerTestSuite;
+
+namespace Audio {
+
+/**
+ * The default fractional type in frac.h (with 16 fractional bits) limits
+ * the rate conversion code to 65536Hz audio: we need to able to handle
+ * 192kHz audio, so we use fewer fractional bits in this code.
+ */
+enum {
+	FRAC_BITS_LOW = 14,
+	FRAC_ONE_LOW = (1L << FRAC_BITS_LOW),
+	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
+};
+
+/**
+ * Applies the channel volume to a block of samples and adds the result,
+ * with saturation, to the mixer output buffer.
+ *
+ * This is the innermost loop of every rate converter, so it is routed
+ * through SIMD implementations when the CPU supports them. The SIMD
+ * variants handle the stereo output layouts and the bulk of the buffer;
+ * whatever they leave over is mixed by the generic implementation, which
+ * is also the reference the SIMD variants must match bit for bit.
+ */
+class RateMixer {
+public:
+	/**
+	 * Mix @p numFrames frames from @p src into @p dst.
+	 *
+	 * @param dst		The output buffer, holding numFrames frames in the output layout.
+	 * @param src		The input samples, holding numFrames frames in the input layout.
+	 * @param numFrames	The number of sample frames to process.
+	 * @param volL		Volume for left channel.
+	 * @param volR		Volume for right channel.
+	 */
+	template<bool inStereo, bool outStereo, bool reverseStereo>
+	static void mix(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+		if (outStereo) {
+			if (!mixFunc)
+				selectMixFunc();
+
+			const Layout layout = inStereo ? (reverseStereo ? kLayoutStereoReversed : kLayoutStereo) : kLayoutMonoToStereo;
+			const st_size_t done = mixFunc(dst, src, numFrames, volL, volR, layout);
+			dst += done * 2;
+			src += done * (inStereo ? 2 : 1);
+			numFrames -= done;
+		}
+
+		mixGeneric<inStereo, outStereo, reverseStereo>(dst, src, numFrames, volL, volR);
+	}
+
+private:
+	enum Layout {
+		kLayoutStereo,
+		kLayoutStereoReversed,
+		kLayoutMonoToStereo
+	};
+
+	/**
+	 * A SIMD mixing function. It processes as many whole vectors as it can
+	 * and returns the number of frames it consumed; the caller mixes the
+	 * remainder with mixGeneric().
+	 */
+	typedef st_size_t (*MixFunc)(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout);
+	static MixFunc mixFunc;
+
+	static void selectMixFunc();
+
+	static st_size_t mixNone(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout) {
+		return 0;
+	}
+#ifdef SCUMMVM_NEON
+	static st_size_t mixNEON(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout);
+#endif
+#ifdef SCUMMVM_SSE2
+	static st_size_t mixSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout);
+#endif
+#ifdef SCUMMVM_AVX2
+	static st_size_t mixAVX2(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout);
+#endif
+
+	/**
+	 * The SIMD variants multiply with 16-bit lanes, so they are only used
+	 * for volumes in the range the mixer actually produces.
+	 */
+	static bool canUseSIMD(st_volume_t volL, st_volume_t volR) {
+		return volL <= Mixer::kMaxMixerVolume && volR <= Mixer::kMaxMixerVolume;
+	}
+
+	template<bool inStereo, bool outStereo, bool reverseStereo>
+	static void mixGeneric(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR) {
+		while (numFrames--) {
+			st_sample_t inL, inR;
+			inL = *src++;
+			inR = (inStereo ? *src++ : inL);
+
+			st_sample_t outL, outR;
+			outL = (inL * (int)volL) / Mixer::kMaxMixerVolume;
+			outR = (inR * (int)volR) / Mixer::kMaxMixerVolume;
+
+			if (outStereo) {
+				// Output left channel
+				clampedAdd(dst[reverseStereo    ], outL);
+
+				// Output right channel
+				clampedAdd(dst[reverseStereo ^ 1], outR);
+
+				dst += 2;
+			} else {
+				// Output mono channel
+				clampedAdd(dst[0], (outL + outR) / 2);
+
+				dst += 1;
+			}
+		}
+	}
+
+	friend class ::RateMixerTestSuite;
+};
+
+/**
+ * Create a RateConverter using a band-limited polyphase FIR filter.
+ * @see kResamplerSinc
+ */
+RateConverter *makeSincRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo);
+
+} // End of namespace Audio
+
+#endif
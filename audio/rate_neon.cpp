@@ -0,0 +1,112 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "audio/rate_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Audio {
+
+/**
+ * Multiply four samples with the volumes in vol and divide by
+ * Mixer::kMaxMixerVolume, rounding towards zero like the generic code.
+ */
+static inline int16x4_t neon_scale(int16x4_t in, int16x4_t vol) {
+	int32x4_t prod = vmull_s16(in, vol);
+	prod = vaddq_s32(prod, vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_s32(vshrq_n_s32(prod, 31)), 24)));
+	return vshrn_n_s32(prod, 8);
+}
+
+static inline void neon_mix(st_sample_t *dst, int16x8_t in, int16x4_t vol) {
+	const int16x8_t scaled = vcombine_s16(neon_scale(vget_low_s16(in), vol), neon_scale(vget_high_s16(in), vol));
+	vst1q_s16(dst, vqaddq_s16(vld1q_s16(dst), scaled));
+}
+
+st_size_t RateMixer::mixNEON(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout) {
+	if (!canUseSIMD(volL, volR))
+		return 0;
+
+	const int16 volLR[4] = { (int16)volL, (int16)volR, (int16)volL, (int16)volR };
+	const int16 volRL[4] = { (int16)volR, (int16)volL, (int16)volR, (int16)volL };
+
+	if (layout == kLayoutMonoToStereo) {
+		// Each block expands eight mono samples into sixteen output samples
+		const int16x4_t vol = vld1_s16(volLR);
+
+		for (st_size_t i = 0; i < numFrames / 8; i++) {
+			const int16x8x2_t in = vzipq_s16(vld1q_s16(src), vld1q_s16(src));
+			neon_mix(dst, in.val[0], vol);
+			neon_mix(dst + 8, in.val[1], vol);
+			src += 8;
+			dst += 16;
+		}
+		return numFrames - numFrames % 8;
+	}
+
+	if (layout == kLayoutStereoReversed) {
+		const int16x4_t vol = vld1_s16(volRL);
+
+		for (st_size_t i = 0; i < numFrames / 4; i++) {
+			neon_mix(dst, vrev32q_s16(vld1q_s16(src)), vol);
+			src += 8;
+			dst += 8;
+		}
+		return numFrames - numFrames % 4;
+	}
+
+	const int16x4_t vol = vld1_s16(volLR);
+
+	for (st_size_t i = 0; i < numFrames / 4; i++) {
+		neon_mix(dst, vld1q_s16(src), vol);
+		src += 8;
+		dst += 8;
+	}
+	return numFrames - numFrames % 4;
+}
+
+} // End of namespace Audio
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
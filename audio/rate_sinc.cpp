@@ -0,0 +1,308 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/audiostream.h"
+#include "audio/rate.h"
+#include "audio/rate_intern.h"
+#include "common/util.h"
+
+#include <math.h>
+
+#if defined(SCUMMVM_SSE2) && defined(__x86_64__)
+#include <emmintrin.h>
+#define SINC_DOT_PRODUCT_SSE2
+#elif defined(SCUMMVM_NEON) && (defined(__aarch64__) || defined(__ARM_NEON))
+#include <arm_neon.h>
+#define SINC_DOT_PRODUCT_NEON
+#endif
+
+namespace Audio {
+
+enum {
+	/** Number of input samples contributing to each output sample. */
+	kSincTaps = 32,
+	/** The tap lined up with the output position for filter phase 0. */
+	kSincCenter = kSincTaps / 2 - 1,
+	/** The fractional input position is rounded to one of 2^kSincPhaseBits filter phases. */
+	kSincPhaseBits = 7,
+	kSincPhases = 1 << kSincPhaseBits,
+	/** Fixed point precision of the filter coefficients. */
+	kSincCoefBits = 14
+};
+
+/**
+ * Cutoff frequency of the filter, relative to the lower of the two sample
+ * rates. Placing it a bit below Nyquist leaves room for the transition band.
+ */
+static const double kSincCutoff = 0.45;
+
+static inline int32 sincDotProduct(const int16 *samples, const int16 *coefs) {
+#if defined(SINC_DOT_PRODUCT_SSE2)
+	__m128i sum = _mm_setzero_si128();
+	for (int i = 0; i < kSincTaps; i += 8)
+		sum = _mm_add_epi32(sum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(samples + i)), _mm_loadu_si128((const __m128i *)(coefs + i))));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+	return _mm_cvtsi128_si32(sum);
+#elif defined(SINC_DOT_PRODUCT_NEON)
+	int32x4_t sum = vdupq_n_s32(0);
+	for (int i = 0; i < kSincTaps; i += 4)
+		sum = vmlal_s16(sum, vld1_s16(samples + i), vld1_s16(coefs + i));
+	const int32x2_t half = vadd_s32(vget_low_s32(sum), vget_high_s32(sum));
+	return vget_lane_s32(vpadd_s32(half, half), 0);
+#else
+	int32 sum = 0;
+	for (int i = 0; i < kSincTaps; i++)
+		sum += samples[i] * coefs[i];
+	return sum;
+#endif
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+class SincRateConverter : public RateConverter {
+private:
+	/** Input and output rates */
+	st_rate_t _inRate, _outRate;
+
+	/** The intermediate input cache. */
+	st_sample_t _buffer[512];
+
+	/** Current position inside the buffer */
+	const st_sample_t *_bufferPos;
+
+	/** Size of data currently loaded into the buffer */
+	int _bufferSize;
+
+	/** Filtered output, gathered before volume is applied and the result is mixed. */
+	st_sample_t _mixBuffer[512];
+
+	/** Fractional position of the output stream in input stream unit */
+	frac_t _outPosFrac;
+
+	/**
+	 * The last kSincTaps input samples of each channel. Every sample is
+	 * stored twice, kSincTaps apart, so that the filter window starting at
+	 * _historyPos is always contiguous in memory.
+	 */
+	st_sample_t _historyL[kSincTaps * 2];
+	st_sample_t _historyR[kSincTaps * 2];
+	uint _historyPos;
+
+	/** Number of input samples still in the history that have not been output yet. */
+	uint _tailSamples;
+
+	/** The cutoff the coefficients were computed for, in cycles per input sample. */
+	double _cutoff;
+
+	/** Filter coefficients, kSincTaps for each phase. The extra phase is the next input sample's phase 0. */
+	int16 _coefs[(kSincPhases + 1) * kSincTaps];
+
+	void updateCoefficients();
+	void pushFrame(st_sample_t inL, st_sample_t inR);
+
+public:
+	SincRateConverter(st_rate_t inputRate, st_rate_t outputRate);
+	virtual ~SincRateConverter() {}
+
+	int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) override;
+
+	void setInputRate(st_rate_t inputRate) override { _inRate = inputRate; updateCoefficients(); }
+	void setOutputRate(st_rate_t outputRate) override { _outRate = outputRate; updateCoefficients(); }
+
+	st_rate_t getInputRate() const override { return _inRate; }
+	st_rate_t getOutputRate() const override { return _outRate; }
+
+	bool needsDraining() const override { return _bufferSize > 0 || _tailSamples != 0; }
+};
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+SincRateConverter<inStereo, outStereo, reverseStereo>::SincRateConverter(st_rate_t inputRate, st_rate_t outputRate) :
+	_inRate(inputRate),
+	_outRate(outputRate),
+	_bufferPos(nullptr),
+	_bufferSize(0),
+	// Read ahead half a window, so that the first output sample is
+	// centered on the first input sample instead of being delayed
+	_outPosFrac(FRAC_ONE_LOW * (kSincTaps / 2 + 1)),
+	_historyPos(0),
+	_tailSamples(0),
+	_cutoff(0.0) {
+	memset(_historyL, 0, sizeof(_historyL));
+	memset(_historyR, 0, sizeof(_historyR));
+	updateCoefficients();
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::updateCoefficients() {
+	// When downsampling, the cutoff has to move down with the output rate
+	// to keep the filter from aliasing
+	double cutoff = kSincCutoff;
+	if (_inRate > _outRate)
+		cutoff = cutoff * _outRate / _inRate;
+
+	if (cutoff == _cutoff)
+		return;
+	_cutoff = cutoff;
+
+	// Output position t lies between history samples kSincTaps / 2 - 1
+	// and kSincTaps / 2, so tap i sits at distance (i - center - phase)
+	const int center = kSincCenter;
+	const double halfWidth = kSincTaps / 2;
+
+	for (int phase = 0; phase <= kSincPhases; phase++) {
+		int16 *coefs = _coefs + phase * kSincTaps;
+		double taps[kSincTaps];
+		double sum = 0.0;
+
+		for (int i = 0; i < kSincTaps; i++) {
+			const double x = i - center - (double)phase / kSincPhases;
+			const double sinc = (x == 0.0) ? 1.0 : sin(2.0 * M_PI * cutoff * x) / (2.0 * M_PI * cutoff * x);
+			// Blackman window
+			const double window = 0.42 + 0.5 * cos(M_PI * x / halfWidth) + 0.08 * cos(2.0 * M_PI * x / halfWidth);
+			taps[i] = sinc * (fabs(x) < halfWidth ? window : 0.0);
+			sum += taps[i];
+		}
+
+		// Normalize each phase to unity gain, and put any rounding error
+		// into the largest tap so constant input passes through unchanged
+		int total = 0, largest = 0;
+		for (int i = 0; i < kSincTaps; i++) {
+			coefs[i] = (int16)floor(taps[i] / sum * (1 << kSincCoefBits) + 0.5);
+			total += coefs[i];
+			if (coefs[i] > coefs[largest])
+				largest = i;
+		}
+		coefs[largest] += (1 << kSincCoefBits) - total;
+	}
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+void SincRateConverter<inStereo, outStereo, reverseStereo>::pushFrame(st_sample_t inL, st_sample_t inR) {
+	_historyL[_historyPos] = _historyL[_historyPos + kSincTaps] = inL;
+	if (inStereo)
+		_historyR[_historyPos] = _historyR[_historyPos + kSincTaps] = inR;
+	_historyPos = (_historyPos + 1) % kSincTaps;
+}
+
+template<bool inStereo, bool outStereo, bool reverseStereo>
+int SincRateConverter<inStereo, outStereo, reverseStereo>::convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t volL, st_volume_t volR) {
+	assert(input.isStereo() == inStereo);
+
+	// How much to increment _outPosFrac by
+	frac_t outPos_inc = (_inRate << FRAC_BITS_LOW) / _outRate;
+
+	// Matching rates leave nothing to filter
+	const bool passThrough = (_inRate == _outRate);
+
+	st_sample_t *outStart, *outEnd;
+	outStart = outBuffer;
+	outEnd = outBuffer + numSamples * (outStereo ? 2 : 1);
+
+	while (outBuffer < outEnd) {
+		const st_size_t maxFrames = MIN<st_size_t>(ARRAYSIZE(_mixBuffer) / (inStereo ? 2 : 1), (outEnd - outBuffer) / (outStereo ? 2 : 1));
+		st_sample_t *mixPos = _mixBuffer;
+		st_sample_t *mixEnd = _mixBuffer + maxFrames * (inStereo ? 2 : 1);
+		bool endOfInput = false;
+
+		while (mixPos < mixEnd) {
+			// Feed the filter until the output position lies within its window
+			while ((frac_t)FRAC_ONE_LOW <= _outPosFrac) {
+				// Check if we have to refill the buffer
+				if (_bufferSize <= 0) {
+					_bufferPos = _buffer;
+					_bufferSize = input.readBuffer(_buffer, ARRAYSIZE(_buffer));
+				}
+
+				if (_bufferSize > 0) {
+					_bufferSize -= (inStereo ? 2 : 1);
+					const st_sample_t inL = *_bufferPos++;
+					const st_sample_t inR = inStereo ? *_bufferPos++ : inL;
+					pushFrame(inL, inR);
+					_tailSamples = kSincTaps / 2;
+				} else if (_tailSamples && input.endOfStream()) {
+					// Flush the samples still inside the filter window
+					pushFrame(0, 0);
+					_tailSamples--;
+				} else {
+					_bufferSize = 0;
+					endOfInput = true;
+					break;
+				}
+
+				_outPosFrac -= FRAC_ONE_LOW;
+			}
+
+			if (endOfInput)
+				break;
+
+			// Loop as long as the _outPos trails behind, and as long as there is
+			// still space in the mix buffer.
+			while (_outPosFrac < (frac_t)FRAC_ONE_LOW && mixPos < mixEnd) {
+				const int phase = (_outPosFrac + (1 << (FRAC_BITS_LOW - kSincPhaseBits - 1))) >> (FRAC_BITS_LOW - kSincPhaseBits);
+
+				if (passThrough && phase == 0) {
+					// The output lines up with an input sample, so it is
+					// copied as is instead of being filtered
+					*mixPos++ = _historyL[_historyPos + kSincCenter];
+					if (inStereo)
+						*mixPos++ = _historyR[_historyPos + kSincCenter];
+				} else {
+					const int16 *coefs = _coefs + phase * kSincTaps;
+					const int32 round = 1 << (kSincCoefBits - 1);
+
+					*mixPos++ = (st_sample_t)CLIP<int32>((sincDotProduct(_historyL + _historyPos, coefs) + round) >> kSincCoefBits, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+					if (inStereo)
+						*mixPos++ = (st_sample_t)CLIP<int32>((sincDotProduct(_historyR + _historyPos, coefs) + round) >> kSincCoefBits, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+				}
+
+				// Increment output position
+				_outPosFrac += outPos_inc;
+			}
+		}
+
+		const st_size_t frames = (mixPos - _mixBuffer) / (inStereo ? 2 : 1);
+		RateMixer::mix<inStereo, outStereo, reverseStereo>(outBuffer, _mixBuffer, frames, volL, volR);
+		outBuffer += frames * (outStereo ? 2 : 1);
+
+		if (endOfInput)
+			break;
+	}
+	return (outBuffer - outStart) / (outStereo ? 2 : 1);
+}
+
+RateConverter *makeSincRateConverter(st_rate_t inRate, st_rate_t outRate, bool inStereo, bool outStereo, bool reverseStereo) {
+	if (inStereo) {
+		if (outStereo) {
+			if (reverseStereo)
+				return new SincRateConverter<true, true, true>(inRate, outRate);
+			else
+				return new SincRateConverter<true, true, false>(inRate, outRate);
+		} else
+			return new SincRateConverter<true, false, false>(inRate, outRate);
+	} else {
+		if (outStereo) {
+			return new SincRateConverter<false, true, false>(inRate, outRate);
+		} else
+			return new SincRateConverter<false, false, false>(inRate, outRate);
+	}
+}
+
+} // End of namespace Audio
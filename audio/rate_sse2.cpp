@@ -0,0 +1,117 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_SSE2
+
+#include "audio/rate_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Audio {
+
+/**
+ * Multiply eight samples with the volumes in vol and divide by
+ * Mixer::kMaxMixerVolume, rounding towards zero like the generic code.
+ */
+static FORCEINLINE __m128i sse2_scale(__m128i in, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(in, vol);
+	const __m128i hi = _mm_mulhi_epi16(in, vol);
+	__m128i prod0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i prod1 = _mm_unpackhi_epi16(lo, hi);
+
+	prod0 = _mm_srai_epi32(_mm_add_epi32(prod0, _mm_srli_epi32(_mm_srai_epi32(prod0, 31), 24)), 8);
+	prod1 = _mm_srai_epi32(_mm_add_epi32(prod1, _mm_srli_epi32(_mm_srai_epi32(prod1, 31), 24)), 8);
+	return _mm_packs_epi32(prod0, prod1);
+}
+
+static FORCEINLINE void sse2_mix(st_sample_t *dst, __m128i in, __m128i vol) {
+	__m128i out = _mm_loadu_si128((const __m128i *)dst);
+	out = _mm_adds_epi16(out, sse2_scale(in, vol));
+	_mm_storeu_si128((__m128i *)dst, out);
+}
+
+st_size_t RateMixer::mixSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t numFrames, st_volume_t volL, st_volume_t volR, Layout layout) {
+	if (!canUseSIMD(volL, volR))
+		return 0;
+
+	if (layout == kLayoutMonoToStereo) {
+		// Each block expands eight mono samples into sixteen output samples
+		const __m128i vol = _mm_setr_epi16(volL, volR, volL, volR, volL, volR, volL, volR);
+
+		for (st_size_t i = 0; i < numFrames / 8; i++) {
+			const __m128i in = _mm_loadu_si128((const __m128i *)src);
+			sse2_mix(dst, _mm_unpacklo_epi16(in, in), vol);
+			sse2_mix(dst + 8, _mm_unpackhi_epi16(in, in), vol);
+			src += 8;
+			dst += 16;
+		}
+		return numFrames - numFrames % 8;
+	}
+
+	if (layout == kLayoutStereoReversed) {
+		const __m128i vol = _mm_setr_epi16(volR, volL, volR, volL, volR, volL, volR, volL);
+
+		for (st_size_t i = 0; i < numFrames / 4; i++) {
+			__m128i in = _mm_loadu_si128((const __m128i *)src);
+			in = _mm_shufflehi_epi16(_mm_shufflelo_epi16(in, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+			sse2_mix(dst, in, vol);
+			src += 8;
+			dst += 8;
+		}
+		return numFrames - numFrames % 4;
+	}
+
+	const __m128i vol = _mm_setr_epi16(volL, volR, volL, volR, volL, volR, volL, volR);
+
+	for (st_size_t i = 0; i < numFrames / 4; i++) {
+		sse2_mix(dst, _mm_loadu_si128((const __m128i *)src), vol);
+		src += 8;
+		dst += 8;
+	}
+	return numFrames - numFrames % 4;
+}
+
+} // End of namespace Audio
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
+
+#endif // SCUMMVM_SSE2
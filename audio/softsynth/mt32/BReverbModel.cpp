@@ -37,6 +37,11 @@ static const Bit32u PROCESS_DELAY = 1;
 static const Bit32u MODE_3_ADDITIONAL_DELAY = 1;
 static const Bit32u MODE_3_FEEDBACK_DELAY = 1;
 
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+// Number of samples each stage of the reverb processes at a time
+static const Bit32u REVERB_BLOCK_LENGTH = 64;
+#endif // ScummVM local patch end
+
 // Avoid denormals degrading performance, using biased input
 static const FloatSample BIAS = 1e-20f;
 
@@ -365,9 +370,18 @@ public:
 		this->buffer[this->index] = weirdMul(last, filterFactor, 0xC0) - filterIn;
 	}
 
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+	// The output positions never exceed the buffer size, so one conditional subtraction
+	// wraps the index around. This is much cheaper than a division.
+	Sample getOutputAt(const Bit32u outIndex) const {
+		const Bit32u position = this->size + this->index - outIndex;
+		return this->buffer[position < this->size ? position : position - this->size];
+	}
+#else
 	Sample getOutputAt(const Bit32u outIndex) const {
 		return this->buffer[(this->size + this->index - outIndex) % this->size];
 	}
+#endif // ScummVM local patch end
 
 	void setFeedbackFactor(const Bit8u useFeedbackFactor) {
 		feedbackFactor = useFeedbackFactor;
@@ -565,6 +579,87 @@ public:
 			return;
 		}
 
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+		// Each stage of the reverb processes a whole block before the next one does,
+		// which keeps the loops short and lets compilers vectorise the simple ones.
+		Sample block[REVERB_BLOCK_LENGTH];
+		while (numSamples > 0) {
+			const Bit32u blockLength = numSamples > REVERB_BLOCK_LENGTH ? REVERB_BLOCK_LENGTH : numSamples;
+			numSamples -= blockLength;
+
+			for (Bit32u i = 0; i < blockLength; i++) {
+				Sample dry;
+
+				if (tapDelayMode) {
+					dry = halveSample(inLeft[i]) + halveSample(inRight[i]);
+				} else {
+					dry = quarterSample(inLeft[i]) + quarterSample(inRight[i]);
+				}
+
+				// Looks like dryAmp doesn't change in MT-32 but it does in CM-32L / LAPC-I
+				block[i] = weirdMul(addDCBias(dry), dryAmp, 0xFF);
+			}
+			inLeft += blockLength;
+			inRight += blockLength;
+
+			if (tapDelayMode) {
+				TapDelayCombFilter<Sample> *comb = static_cast<TapDelayCombFilter<Sample> *>(*combs);
+				for (Bit32u i = 0; i < blockLength; i++) {
+					comb->process(block[i]);
+					if (outLeft != NULL) {
+						*(outLeft++) = weirdMul(comb->getLeftOutput(), wetLevel, 0xFF);
+					}
+					if (outRight != NULL) {
+						*(outRight++) = weirdMul(comb->getRightOutput(), wetLevel, 0xFF);
+					}
+				}
+				continue;
+			}
+
+			DelayWithLowPassFilter<Sample> * const entranceDelay = static_cast<DelayWithLowPassFilter<Sample> *>(combs[0]);
+			for (Bit32u i = 0; i < blockLength; i++) {
+				// If the output position is equal to the comb size, get it now in order not to lose it
+				const Sample link = entranceDelay->getOutputAt(currentSettings.combSizes[0] - 1);
+
+				// Entrance LPF. Note, comb.process() differs a bit here.
+				entranceDelay->process(block[i]);
+
+				block[i] = addAllpassNoise(link);
+			}
+
+			for (Bit32u allpass = 0; allpass < currentSettings.numberOfAllpasses; allpass++) {
+				AllpassFilter<Sample> * const filter = allpasses[allpass];
+				for (Bit32u i = 0; i < blockLength; i++) {
+					block[i] = filter->process(block[i]);
+				}
+			}
+
+			for (Bit32u i = 0; i < blockLength; i++) {
+				const Sample link = block[i];
+
+				// If the output position is equal to the comb size, get it now in order not to lose it
+				Sample outL1 = combs[1]->getOutputAt(currentSettings.outLPositions[0] - 1);
+
+				combs[1]->process(link);
+				combs[2]->process(link);
+				combs[3]->process(link);
+
+				if (outLeft != NULL) {
+					Sample outL2 = combs[2]->getOutputAt(currentSettings.outLPositions[1]);
+					Sample outL3 = combs[3]->getOutputAt(currentSettings.outLPositions[2]);
+					Sample outSample = mixCombs(outL1, outL2, outL3);
+					*(outLeft++) = weirdMul(outSample, wetLevel, 0xFF);
+				}
+				if (outRight != NULL) {
+					Sample outR1 = combs[1]->getOutputAt(currentSettings.outRPositions[0]);
+					Sample outR2 = combs[2]->getOutputAt(currentSettings.outRPositions[1]);
+					Sample outR3 = combs[3]->getOutputAt(currentSettings.outRPositions[2]);
+					Sample outSample = mixCombs(outR1, outR2, outR3);
+					*(outRight++) = weirdMul(outSample, wetLevel, 0xFF);
+				}
+			}
+		} // while (numSamples > 0)
+#else
 		while ((numSamples--) > 0) {
 			Sample dry;
 
@@ -620,6 +715,7 @@ public:
 				}
 			} // if (tapDelayMode)
 		} // while ((numSamples--) > 0)
+#endif // ScummVM local patch end
 	} // produceOutput
 
 	bool process(const IntSample *inLeft, const IntSample *inRight, IntSample *outLeft, IntSample *outRight, Bit32u numSamples);
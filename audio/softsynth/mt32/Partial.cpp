@@ -34,6 +34,11 @@ namespace MT32Emu {
 static const Bit8u PAN_NUMERATOR_MASTER[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7};
 static const Bit8u PAN_NUMERATOR_SLAVE[]  = {0, 1, 2, 3, 4, 5, 6, 7, 7, 7, 7, 7, 7, 7, 7};
 
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+// Number of samples generated before they are panned and mixed into the output buffers
+static const Bit32u PARTIAL_BLOCK_LENGTH = 64;
+#endif // ScummVM local patch end
+
 // We assume the pan is applied using the same 13-bit multiplier circuit that is also used for ring modulation
 // because of the observed sample overflow, so the panSetting values are likely mapped in a similar way via a LUT.
 // FIXME: Sample analysis suggests that the use of panSetting is linear, but there are some quirks that still need to be resolved.
@@ -332,6 +337,40 @@ bool Partial::generateNextSample(LA32PairImpl *la32PairImpl) {
 	return true;
 }
 
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+static inline IntSample clampSampleEx(IntSampleEx sampleEx) {
+	// Same as Synth::clipSampleEx(), but written in a form compilers can vectorise
+	return IntSample(sampleEx < -0x8000 ? -0x8000 : (sampleEx > 0x7FFF ? 0x7FFF : sampleEx));
+}
+
+void Partial::mixBlock(IntSample *leftBuf, IntSample *rightBuf, const IntSample *block, Bit32u length) const {
+	// FIXME: LA32 may produce distorted sound in case if the absolute value of maximal amplitude of the input exceeds 8191
+	// when the panning value is non-zero. Most probably the distortion occurs in the same way it does with ring modulation,
+	// and it seems to be caused by limited precision of the common multiplication circuit.
+	// From analysis of this overflow, it is obvious that the right channel output is actually found
+	// by subtraction of the left channel output from the input.
+	// Though, it is unknown whether this overflow is exploited somewhere.
+
+	const IntSampleEx leftPan = leftPanValue;
+	const IntSampleEx rightPan = rightPanValue;
+	for (Bit32u i = 0; i < length; i++) {
+		const IntSampleEx sample = block[i];
+		const IntSampleEx leftOut = ((sample * leftPan) >> 13) + IntSampleEx(leftBuf[i]);
+		const IntSampleEx rightOut = ((sample * rightPan) >> 13) + IntSampleEx(rightBuf[i]);
+		leftBuf[i] = clampSampleEx(leftOut);
+		rightBuf[i] = clampSampleEx(rightOut);
+	}
+}
+
+void Partial::mixBlock(FloatSample *leftBuf, FloatSample *rightBuf, const FloatSample *block, Bit32u length) const {
+	const Bit32s leftPan = leftPanValue;
+	const Bit32s rightPan = rightPanValue;
+	for (Bit32u i = 0; i < length; i++) {
+		leftBuf[i] += (block[i] * leftPan) / 14.0f;
+		rightBuf[i] += (block[i] * rightPan) / 14.0f;
+	}
+}
+#else
 void Partial::produceAndMixSample(IntSample *&leftBuf, IntSample *&rightBuf, LA32IntPartialPair *la32IntPair) {
 	IntSampleEx sample = la32IntPair->nextOutSample();
 
@@ -355,16 +394,36 @@ void Partial::produceAndMixSample(FloatSample *&leftBuf, FloatSample *&rightBuf,
 	*(leftBuf++) += leftOut;
 	*(rightBuf++) += rightOut;
 }
+#endif // ScummVM local patch end
 
 template <class Sample, class LA32PairImpl>
 bool Partial::doProduceOutput(Sample *leftBuf, Sample *rightBuf, Bit32u length, LA32PairImpl *la32PairImpl) {
 	if (!canProduceOutput()) return false;
 	alreadyOutputed = true;
 
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+	// The LA32 state can only advance sample by sample, but the generated samples
+	// are panned and mixed a block at a time, which is considerably faster.
+	Sample block[PARTIAL_BLOCK_LENGTH];
+	bool active = true;
+	for (sampleNum = 0; active && sampleNum < length;) {
+		const Bit32u blockStart = sampleNum;
+		const Bit32u blockEnd = (length - blockStart > PARTIAL_BLOCK_LENGTH) ? blockStart + PARTIAL_BLOCK_LENGTH : length;
+		for (; sampleNum < blockEnd; sampleNum++) {
+			if (!generateNextSample(la32PairImpl)) {
+				active = false;
+				break;
+			}
+			block[sampleNum - blockStart] = la32PairImpl->nextOutSample();
+		}
+		mixBlock(leftBuf + blockStart, rightBuf + blockStart, block, sampleNum - blockStart);
+	}
+#else
 	for (sampleNum = 0; sampleNum < length; sampleNum++) {
 		if (!generateNextSample(la32PairImpl)) break;
 		produceAndMixSample(leftBuf, rightBuf, la32PairImpl);
 	}
+#endif // ScummVM local patch end
 	sampleNum = 0;
 	return true;
 }
@@ -88,8 +88,13 @@ private:
 	bool canProduceOutput();
 	template <class LA32PairImpl>
 	bool generateNextSample(LA32PairImpl *la32PairImpl);
+#if MT32EMU_SCUMMVM_BLOCK_RENDERING // ScummVM local patch begin, see README.ScummVM
+	void mixBlock(IntSample *leftBuf, IntSample *rightBuf, const IntSample *block, Bit32u length) const;
+	void mixBlock(FloatSample *leftBuf, FloatSample *rightBuf, const FloatSample *block, Bit32u length) const;
+#else
 	void produceAndMixSample(IntSample *&leftBuf, IntSample *&rightBuf, LA32IntPartialPair *la32IntPair);
 	void produceAndMixSample(FloatSample *&leftBuf, FloatSample *&rightBuf, LA32FloatPartialPair *la32FloatPair);
+#endif // ScummVM local patch end
 
 public:
 	bool alreadyOutputed;
@@ -87,6 +87,13 @@
 #define MT32EMU_BOSS_REVERB_PRECISE_MODE 0
 #endif
 
+// ScummVM local patch, see README.ScummVM.
+// 0: Partials and the reverb are rendered sample by sample, like upstream does.
+// 1: Partials and the reverb are rendered in blocks of samples. Faster, and the output is identical.
+#ifndef MT32EMU_SCUMMVM_BLOCK_RENDERING
+#define MT32EMU_SCUMMVM_BLOCK_RENDERING 1
+#endif
+
 namespace MT32Emu {
 
 typedef Bit16s IntSample;
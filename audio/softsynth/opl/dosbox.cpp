@@ -165,6 +165,7 @@ bool OPL::init() {
 	free();
 
 	memset(&_reg, 0, sizeof(_reg));
+	memset(&_timerReg, 0, sizeof(_timerReg));
 	ARRAYCLEAR(_chip);
 
 	_emulator = new DBOPL::Chip();
@@ -188,6 +189,68 @@ void OPL::reset() {
 }
 
 void OPL::write(int port, int val) {
+	if (writeTimer(port, val))
+		return;
+
+	if (!queueWrite(kWritePort, port, val))
+		doWrite(port, val);
+}
+
+bool OPL::writeTimer(int port, int val) {
+	// The timers are polled by the caller, so writes to them are not queued
+	// along with the others but carried out right away. This needs the
+	// register selection as the caller sees it, which is tracked here.
+	if (!(port & 1)) {
+		switch (_type) {
+		case Config::kOpl2:
+			_timerReg.normal = val & 0xff;
+			break;
+		case Config::kOpl3:
+			// Writes to the secondary register set never reach the timers.
+			// The emulator only maps them to it in OPL3 mode, which is left
+			// to the queued writes to decide.
+			_timerReg.normal = (port & 2) ? 0x100 : (val & 0xff);
+			break;
+		case Config::kDualOpl2:
+			if (!(port & 0x8)) {
+				_timerReg.dual[(port & 2) >> 1] = val & 0xff;
+			} else {
+				_timerReg.dual[0] = val & 0xff;
+				_timerReg.dual[1] = val & 0xff;
+			}
+			break;
+		default:
+			break;
+		}
+		return false;
+	}
+
+	switch (_type) {
+	case Config::kOpl2:
+	case Config::kOpl3:
+		return _chip[0].write(_timerReg.normal, val);
+	case Config::kDualOpl2:
+		if (!(port & 0x8))
+			return _chip[(port & 2) >> 1].write(_timerReg.dual[(port & 2) >> 1], val);
+
+		// A write to both chips may hit the timers of only one of them, in
+		// which case the other one is sent its own write
+		if (_chip[0].write(_timerReg.dual[0], val)) {
+			if (!_chip[1].write(_timerReg.dual[1], val))
+				write((port & ~0xA) | 2, val);
+			return true;
+		}
+		if (_chip[1].write(_timerReg.dual[1], val)) {
+			write(port & ~0xA, val);
+			return true;
+		}
+		return false;
+	default:
+		return false;
+	}
+}
+
+void OPL::doWrite(int port, int val) {
 	if (port&1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -236,6 +299,25 @@ void OPL::write(int port, int val) {
 }
 
 void OPL::writeReg(int r, int v) {
+	if (writeTimerReg(r, v))
+		return;
+
+	if (!queueWrite(kWriteRegister, r, v))
+		doWriteReg(r, v);
+}
+
+bool OPL::writeTimerReg(int r, int v) {
+	// Like writeTimer(). Only OPL3 has registers past 0xff, and register
+	// writes go to both chips in dual OPL2 mode.
+	const uint32 reg = (_type == Config::kOpl3) ? r : (r & 0xff);
+	if (!_chip[0].write(reg, v))
+		return false;
+	if (_type == Config::kDualOpl2)
+		_chip[1].write(reg, v);
+	return true;
+}
+
+void OPL::doWriteReg(int r, int v) {
 	int tempReg = 0;
 	switch (_type) {
 	case Config::kOpl2:
@@ -251,21 +333,21 @@ void OPL::writeReg(int r, int v) {
 		if (_type == Config::kOpl3 && r >= 0x100) {
 			// We need to set the register we want to write to via port 0x222,
 			// since we want to write to the secondary register set.
-			write(0x222, r);
+			doWrite(0x222, r);
 			// Do the real writing to the register
-			write(0x223, v);
+			doWrite(0x223, v);
 		} else {
 			// We need to set the register we want to write to via port 0x388
-			write(0x388, r);
+			doWrite(0x388, r);
 			// Do the real writing to the register
-			write(0x389, v);
+			doWrite(0x389, v);
 		}
 
 		// Restore the old register
 		if (_type == Config::kOpl3 && tempReg >= 0x100) {
-			write(0x222, tempReg & ~0x100);
+			doWrite(0x222, tempReg & ~0x100);
 		} else {
-			write(0x388, tempReg);
+			doWrite(0x388, tempReg);
 		}
 		break;
 	default:
@@ -273,6 +355,13 @@ void OPL::writeReg(int r, int v) {
 	};
 }
 
+void OPL::applyWrite(WriteType type, int a, int v) {
+	if (type == kWritePort)
+		doWrite(a, v);
+	else
+		doWriteReg(a, v);
+}
+
 void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 	// Make sure you don't use opl3 features
 	// Don't allow write to disable opl3
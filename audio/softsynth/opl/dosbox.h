@@ -80,8 +80,21 @@ private:
 		uint8 dual[2];
 	} _reg;
 
+	/**
+	 * The register selected from the caller's point of view, which is ahead
+	 * of _reg while writes are queued. Used to apply timer writes right away.
+	 */
+	union {
+		uint16 normal;
+		uint8 dual[2];
+	} _timerReg;
+
 	void free();
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
+	bool writeTimer(int port, int val);
+	bool writeTimerReg(int r, int v);
+	void doWrite(int a, int v);
+	void doWriteReg(int r, int v);
 public:
 	OPL(Config::OplType type);
 	~OPL();
@@ -97,6 +110,8 @@ public:
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+	bool supportsRenderAhead() const override { return true; }
+	void applyWrite(WriteType type, int a, int v) override;
 };
 
 } // End of namespace DOSBox
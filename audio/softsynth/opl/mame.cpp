@@ -68,11 +68,20 @@ void OPL::reset() {
 }
 
 void OPL::write(int a, int v) {
-	MAME::OPLWrite(_opl, a, v);
+	if (!queueWrite(kWritePort, a, v))
+		MAME::OPLWrite(_opl, a, v);
 }
 
 void OPL::writeReg(int r, int v) {
-	MAME::OPLWriteReg(_opl, r, v);
+	if (!queueWrite(kWriteRegister, r, v))
+		MAME::OPLWriteReg(_opl, r, v);
+}
+
+void OPL::applyWrite(WriteType type, int a, int v) {
+	if (type == kWritePort)
+		MAME::OPLWrite(_opl, a, v);
+	else
+		MAME::OPLWriteReg(_opl, a, v);
 }
 
 void OPL::generateSamples(int16 *buffer, int length) {
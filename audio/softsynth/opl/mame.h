@@ -191,6 +191,8 @@ public:
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+	bool supportsRenderAhead() const override { return true; }
+	void applyWrite(WriteType type, int a, int v) override;
 };
 
 } // End of namespace MAME
@@ -1555,6 +1555,11 @@ void OPL::reset() {
 }
 
 void OPL::write(int port, int val) {
+	if (!queueWrite(kWritePort, port, val))
+		doWrite(port, val);
+}
+
+void OPL::doWrite(int port, int val) {
 	if (port & 1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -1603,9 +1608,21 @@ void OPL::write(int port, int val) {
 
 
 void OPL::writeReg(int r, int v) {
+	if (!queueWrite(kWriteRegister, r, v))
+		doWriteReg(r, v);
+}
+
+void OPL::doWriteReg(int r, int v) {
 	OPL3_WriteRegBuffered(&chip, (uint16_t)r, (uint8_t)v);
 }
 
+void OPL::applyWrite(WriteType type, int a, int v) {
+	if (type == kWritePort)
+		doWrite(a, v);
+	else
+		doWriteReg(a, v);
+}
+
 void OPL::dualWrite(uint8 index, uint8 reg, uint8 val) {
 	// Make sure you don't use opl3 features
 	// Don't allow write to disable opl3
@@ -171,6 +171,8 @@ private:
 	opl3_chip chip;
 	uint address[2];
 	void dualWrite(uint8 index, uint8 reg, uint8 val);
+	void doWrite(int a, int v);
+	void doWriteReg(int r, int v);
 
 public:
 	OPL(Config::OplType type);
@@ -187,6 +189,8 @@ public:
 
 protected:
 	void generateSamples(int16 *buffer, int length);
+	bool supportsRenderAhead() const override { return true; }
+	void applyWrite(WriteType type, int a, int v) override;
 };
 
 }
@@ -0,0 +1,308 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/soundcache.h"
+#include "audio/audiostream.h"
+
+#include "common/config-manager.h"
+#include "common/stream.h"
+#include "common/util.h"
+
+namespace Common {
+DECLARE_SINGLETON(Audio::SoundCacheManager);
+}
+
+namespace Audio {
+
+/**
+ * A stream reading the decoded samples of a cached sound.
+ */
+class CachedSoundStream : public SeekableAudioStream {
+public:
+	CachedSoundStream(const SoundCacheManager::SoundPtr &sound) :
+		_sound(sound), _samples(sound->samples), _numSamples(sound->numSamples), _rate(sound->rate), _stereo(sound->stereo), _pos(0) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const uint32 samples = MIN<uint32>(numSamples, _numSamples - _pos);
+		memcpy(buffer, _samples + _pos, samples * sizeof(int16));
+		_pos += samples;
+		return samples;
+	}
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { return _pos >= _numSamples; }
+
+	bool seek(const Timestamp &where) override {
+		if (where > getLength()) {
+			_pos = _numSamples;
+			return false;
+		}
+
+		_pos = convertTimeToStreamPos(where, _rate, _stereo).totalNumberOfFrames();
+		return true;
+	}
+
+	Timestamp getLength() const override { return Timestamp(0, _numSamples / (_stereo ? 2 : 1), _rate); }
+
+private:
+	// Keeps the samples alive if the sound is evicted while playing
+	SoundCacheManager::SoundPtr _sound;
+
+	const int16 *_samples;
+	const uint32 _numSamples;
+	const int _rate;
+	const bool _stereo;
+	uint32 _pos;
+};
+
+/**
+ * Plays a sound straight from its decoder, keeping a copy of the samples
+ * read. Once the sound has been played to the end, the copy is added to the
+ * cache. The copy is dropped if the sound is seeked in, or if it exceeds the
+ * size limit, in which case the sound is remembered as too large.
+ */
+class CachingSoundStream : public SeekableAudioStream {
+public:
+	CachingSoundStream(const Common::String &key, SeekableAudioStream *stream, uint32 maxSize, uint32 cacheSize) :
+		_key(key), _stream(stream), _maxSamples((maxSize / sizeof(int16)) & ~1), _cacheSize(cacheSize),
+		_samples(nullptr), _numSamples(0), _capacity(0), _recording(true) {
+		// Allocate the whole sound up front if the decoder knows its length,
+		// so that the mixer thread does not need to
+		const uint32 length = stream->getLength().totalNumberOfFrames() * (stream->isStereo() ? 2 : 1);
+		if (length)
+			reserve(MIN<uint32>(length, _maxSamples));
+	}
+
+	~CachingSoundStream() override {
+		free(_samples);
+		delete _stream;
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const int read = _stream->readBuffer(buffer, numSamples);
+		if (_recording) {
+			if (read > 0)
+				record(buffer, read);
+			if (_recording && _stream->endOfData())
+				finish();
+		}
+		return read;
+	}
+
+	bool isStereo() const override { return _stream->isStereo(); }
+	int getRate() const override { return _stream->getRate(); }
+	bool endOfData() const override { return _stream->endOfData(); }
+	bool endOfStream() const override { return _stream->endOfStream(); }
+
+	bool seek(const Timestamp &where) override {
+		// Only a recording of the whole sound can be cached
+		if (_numSamples || where.totalNumberOfFrames())
+			stopRecording();
+		return _stream->seek(where);
+	}
+
+	Timestamp getLength() const override { return _stream->getLength(); }
+
+private:
+	const Common::String _key;
+	SeekableAudioStream *_stream;
+	const uint32 _maxSamples;
+	const uint32 _cacheSize;
+
+	int16 *_samples;
+	uint32 _numSamples;
+	uint32 _capacity;
+	bool _recording;
+
+	bool reserve(uint32 capacity) {
+		int16 *samples = (int16 *)realloc(_samples, capacity * sizeof(int16));
+		if (!samples)
+			return false;
+		_samples = samples;
+		_capacity = capacity;
+		return true;
+	}
+
+	void record(const int16 *buffer, uint32 numSamples) {
+		if (_numSamples + numSamples > _capacity) {
+			if (_numSamples + numSamples > _maxSamples) {
+				SoundCacheMan.markUncacheable(_key);
+				stopRecording();
+				return;
+			}
+
+			const uint32 capacity = MIN<uint32>(MAX<uint32>(MAX<uint32>(_capacity * 2, _numSamples + numSamples), 4096), _maxSamples);
+			if (!reserve(capacity)) {
+				stopRecording();
+				return;
+			}
+		}
+
+		memcpy(_samples + _numSamples, buffer, numSamples * sizeof(int16));
+		_numSamples += numSamples;
+	}
+
+	void finish() {
+		if (_numSamples < _capacity)
+			reserve(MAX<uint32>(_numSamples, 1));
+
+		SoundCacheMan.add(_key, new SoundCacheManager::Sound(_samples, _numSamples, _stream->getRate(), _stream->isStereo()), _cacheSize);
+		_samples = nullptr;
+		_recording = false;
+	}
+
+	void stopRecording() {
+		free(_samples);
+		_samples = nullptr;
+		_numSamples = _capacity = 0;
+		_recording = false;
+	}
+};
+
+SoundCacheManager::SoundCacheManager() : _size(0), _hits(0), _misses(0) {
+}
+
+Common::String SoundCacheManager::makeKey(const Common::Path &member, uint32 offset) {
+	return Common::String::format("%s:%u", member.toString('/').c_str(), offset);
+}
+
+uint32 SoundCacheManager::getMaxSize() {
+	int size = kDefaultCacheSize;
+	if (ConfMan.hasKey("sound_cache_size"))
+		size = ConfMan.getInt("sound_cache_size");
+
+	return MAX(size, 0) * 1024;
+}
+
+SeekableAudioStream *SoundCacheManager::makeSoundStream(const SoundPtr &sound) {
+	return new CachedSoundStream(sound);
+}
+
+SeekableAudioStream *SoundCacheManager::getStream(const Common::Path &member, uint32 offset) {
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator i = _entries.find(makeKey(member, offset));
+	if (i == _entries.end())
+		return nullptr;
+
+	// Move the sound to the most recently used end
+	_lru.erase(i->_value.lruPos);
+	_lru.push_back(i->_key);
+	i->_value.lruPos = --_lru.end();
+
+	_hits++;
+	return makeSoundStream(i->_value.sound);
+}
+
+SeekableAudioStream *SoundCacheManager::makeStream(const Common::Path &member, uint32 offset,
+                                                   Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse,
+                                                   DecoderFunc decoder) {
+	SeekableAudioStream *cached = getStream(member, offset);
+	if (cached) {
+		if (disposeAfterUse == DisposeAfterUse::YES)
+			delete stream;
+		return cached;
+	}
+
+	const Common::String key = makeKey(member, offset);
+	const uint32 maxSize = getMaxSize();
+	bool cacheable;
+	{
+		Common::StackLock lock(_mutex);
+		_misses++;
+		cacheable = maxSize && !_uncacheable.contains(key);
+	}
+
+	SeekableAudioStream *audioStream = decoder(stream, disposeAfterUse);
+	if (!audioStream || !cacheable)
+		return audioStream;
+
+	// Give up early if the stream reports its length
+	const uint32 length = audioStream->getLength().totalNumberOfFrames();
+	if ((uint64)length * (audioStream->isStereo() ? 2 : 1) * sizeof(int16) > maxSize / 4) {
+		markUncacheable(key);
+		return audioStream;
+	}
+
+	return new CachingSoundStream(key, audioStream, maxSize / 4, maxSize);
+}
+
+void SoundCacheManager::add(const Common::String &key, Sound *sound, uint32 maxSize) {
+	SoundPtr soundPtr(sound);
+
+	Common::StackLock lock(_mutex);
+
+	// The same sound may have been played to the end twice
+	if (_entries.contains(key))
+		return;
+
+	Entry &entry = _entries[key];
+	entry.sound = soundPtr;
+	_lru.push_back(key);
+	entry.lruPos = --_lru.end();
+	_size += sound->numSamples * sizeof(int16);
+
+	evict(maxSize);
+}
+
+void SoundCacheManager::markUncacheable(const Common::String &key) {
+	Common::StackLock lock(_mutex);
+	_uncacheable[key] = true;
+}
+
+void SoundCacheManager::evict(uint32 maxSize) {
+	while (_size > maxSize && !_lru.empty()) {
+		EntryMap::iterator i = _entries.find(_lru.front());
+		assert(i != _entries.end());
+
+		_size -= i->_value.sound->numSamples * sizeof(int16);
+		_entries.erase(i);
+		_lru.pop_front();
+	}
+}
+
+void SoundCacheManager::clear() {
+	Common::StackLock lock(_mutex);
+
+	_entries.clear();
+	_lru.clear();
+	_uncacheable.clear();
+	_size = 0;
+	_hits = _misses = 0;
+}
+
+uint32 SoundCacheManager::getSize() const {
+	Common::StackLock lock(_mutex);
+	return _size;
+}
+
+uint SoundCacheManager::getNumSounds() const {
+	Common::StackLock lock(_mutex);
+	return _entries.size();
+}
+
+uint SoundCacheManager::getNumUncacheable() const {
+	Common::StackLock lock(_mutex);
+	return _uncacheable.size();
+}
+
+} // End of namespace Audio
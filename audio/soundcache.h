@@ -0,0 +1,184 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_SOUNDCACHE_H
+#define AUDIO_SOUNDCACHE_H
+
+#include "common/scummsys.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/path.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/types.h"
+
+namespace Common {
+class SeekableReadStream;
+}
+
+namespace Audio {
+
+/**
+ * @defgroup audio_soundcache Sound cache
+ * @ingroup audio
+ *
+ * @brief Cache of decoded sound effects.
+ * @{
+ */
+
+class CachedSoundStream;
+class SeekableAudioStream;
+
+/**
+ * Keeps the decoded samples of recently played compressed sounds in
+ * memory, so that playing the same sound effect again does not decode it
+ * again.
+ *
+ * Sounds are identified by the archive member they are stored in and
+ * their offset in it. The cache hands out SeekableAudioStreams reading
+ * from the decoded samples, which stay valid even if the sound is evicted
+ * meanwhile.
+ *
+ * The first time a sound is played, it is played straight from its
+ * decoder, and the samples are added to the cache once it has been played
+ * to the end. Playback thus never waits for a whole sound to be decoded.
+ *
+ * The total size of the decoded samples is limited by the
+ * "sound_cache_size" setting, in kilobytes; the least recently used
+ * sounds are evicted first. Sounds larger than a quarter of the limit,
+ * such as music or long speech, are never cached, and are remembered so
+ * that they are not recorded again. Setting the size to 0 disables the
+ * cache.
+ *
+ * The cache is emptied when the engine exits.
+ */
+class SoundCacheManager : public Common::Singleton<SoundCacheManager> {
+public:
+	/** A decoder function such as makeVorbisStream(), makeMP3Stream() or makeFLACStream(). */
+	typedef SeekableAudioStream *(*DecoderFunc)(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse);
+
+	/** The default value of the "sound_cache_size" setting, in kilobytes. */
+	static const int kDefaultCacheSize = 4096;
+
+	/**
+	 * Return a stream playing a cached sound.
+	 *
+	 * @param member	The archive member holding the compressed sound.
+	 * @param offset	Offset of the sound in the member.
+	 * @return A new stream, or nullptr if the sound is not in the cache.
+	 */
+	SeekableAudioStream *getStream(const Common::Path &member, uint32 offset);
+
+	/**
+	 * Return a stream playing a compressed sound, decoding it into the
+	 * cache unless it is in the cache already.
+	 *
+	 * @param member			The archive member holding the compressed sound.
+	 * @param offset			Offset of the sound in the member.
+	 * @param stream			The compressed sound data. It is only read if the sound is not cached yet.
+	 * @param disposeAfterUse	Whether to delete @p stream after use.
+	 * @param decoder			The function decoding the compressed sound.
+	 * @return A new stream, or nullptr if the sound could not be decoded.
+	 *         If the sound is too large to be cached, this is the stream
+	 *         created by @p decoder.
+	 */
+	SeekableAudioStream *makeStream(const Common::Path &member, uint32 offset,
+	                                Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse,
+	                                DecoderFunc decoder);
+
+	/** Evict all sounds, forget which are too large to be cached and reset the statistics. */
+	void clear();
+
+	/** Return the total size of the cached samples, in bytes. */
+	uint32 getSize() const;
+
+	/** Return the number of cached sounds. */
+	uint getNumSounds() const;
+
+	/** Return the number of sounds known to be too large to be cached. */
+	uint getNumUncacheable() const;
+
+	uint32 getNumHits() const { return _hits; }
+	uint32 getNumMisses() const { return _misses; }
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	friend class CachedSoundStream;
+	friend class CachingSoundStream;
+	SoundCacheManager();
+
+	/** The decoded samples of a sound, shared by the cache and the streams playing it. */
+	struct Sound {
+		Sound(int16 *samples_, uint32 numSamples_, int rate_, bool stereo_) :
+			samples(samples_), numSamples(numSamples_), rate(rate_), stereo(stereo_) {}
+		~Sound() { free(samples); }
+
+		int16 *samples;
+		uint32 numSamples;
+		int rate;
+		bool stereo;
+	};
+
+	typedef Common::SharedPtr<Sound> SoundPtr;
+	typedef Common::List<Common::String> LRUList;
+
+	struct Entry {
+		SoundPtr sound;
+		LRUList::iterator lruPos;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+	typedef Common::HashMap<Common::String, bool> KeySet;
+
+	/** Cached sounds, and their keys from the least to the most recently used. */
+	EntryMap _entries;
+	LRUList _lru;
+
+	/** Sounds which turned out to be too large to be cached. */
+	KeySet _uncacheable;
+
+	uint32 _size;
+	uint32 _hits;
+	uint32 _misses;
+
+	mutable Common::Mutex _mutex;
+
+	static Common::String makeKey(const Common::Path &member, uint32 offset);
+	static uint32 getMaxSize();
+
+	/** Add a sound which has been played to the end, evicting others to stay within @p maxSize bytes. */
+	void add(const Common::String &key, Sound *sound, uint32 maxSize);
+	void markUncacheable(const Common::String &key);
+
+	void evict(uint32 maxSize);
+	static SeekableAudioStream *makeSoundStream(const SoundPtr &sound);
+};
+
+/** Shortcut for accessing the sound cache manager. */
+#define SoundCacheMan		Audio::SoundCacheManager::instance()
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
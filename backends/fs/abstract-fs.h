@@ -172,6 +172,14 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Indicates whether the streams created by createReadStream() can be
+	 * read from another thread than the one which created them.
+	 *
+	 * @return bool true if the streams can be read in the background, false otherwise.
+	 */
+	virtual bool supportsBackgroundRead() const { return false; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
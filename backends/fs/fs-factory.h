@@ -72,6 +72,13 @@ public:
 	 * root.
 	 */
 	virtual Common::String getSystemFullPath(const Common::String& path) const { return path; }
+
+	/**
+	 * Called on the main thread before an engine is run, so that the factory
+	 * can pick up the settings of the game. Nodes may be used from other
+	 * threads while the game runs, so they must not read settings themselves.
+	 */
+	virtual void engineInit() {}
 };
 
 #endif /*FILESYSTEM_FACTORY_H*/
@@ -64,4 +64,8 @@ AbstractFSNode *POSIXFilesystemFactory::makeFileNodePath(const Common::String &p
 	assert(!path.empty());
 	return new POSIXFilesystemNode(path);
 }
+
+void POSIXFilesystemFactory::engineInit() {
+	POSIXFilesystemNode::updateMappingSettings();
+}
 #endif
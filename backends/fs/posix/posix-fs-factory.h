@@ -34,6 +34,9 @@ protected:
 	AbstractFSNode *makeRootFileNode() const override;
 	AbstractFSNode *makeCurrentDirectoryFileNode() const override;
 	AbstractFSNode *makeFileNodePath(const Common::String &path) const override;
+
+public:
+	void engineInit() override;
 };
 
 #endif /*POSIX_FILESYSTEM_FACTORY_H*/
@@ -33,7 +33,9 @@
 
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
+#include "backends/fs/posix/posix-mmapstream.h"
 #include "common/algorithm.h"
+#include "common/config-manager.h"
 
 #include <sys/param.h>
 #include <sys/stat.h>
@@ -275,7 +277,40 @@ AbstractFSNode *POSIXFilesystemNode::getParent() const {
 	return makeNode(Common::String(start, end));
 }
 
+bool POSIXFilesystemNode::_mmapGameData = false;
+Common::String POSIXFilesystemNode::_mmapExcludedPath;
+
+void POSIXFilesystemNode::updateMappingSettings() {
+	// Reading a mapped file which another program truncates meanwhile
+	// crashes with SIGBUS, so mapping is opt-in
+	_mmapGameData = ConfMan.hasKey("mmap_game_data") && ConfMan.getBool("mmap_game_data");
+
+	// Savefiles are rewritten while the game runs
+	_mmapExcludedPath.clear();
+	if (ConfMan.hasKey("savepath")) {
+		_mmapExcludedPath = ConfMan.getPath("savepath").toString(Common::Path::kNativeSeparator);
+		if (!_mmapExcludedPath.hasSuffix("/"))
+			_mmapExcludedPath += '/';
+	}
+}
+
+bool POSIXFilesystemNode::isMappable() const {
+	if (!_mmapGameData)
+		return false;
+
+	return _mmapExcludedPath.empty() || !_path.hasPrefix(_mmapExcludedPath);
+}
+
 Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
+	// Large game data files may be mapped into memory, so that engines
+	// reading their resources from them neither copy them through stdio nor
+	// make any system calls. Others, or if mapping fails, are read with stdio.
+	if (isMappable()) {
+		Common::SeekableReadStream *stream = PosixMmapStream::makeFromPath(getPath());
+		if (stream)
+			return stream;
+	}
+
 	return PosixIoStream::makeFromPath(getPath(), StdioStream::WriteMode_Read);
 }
 
@@ -60,6 +60,7 @@ public:
 	bool isDirectory() const override { return _isDirectory; }
 	bool isReadable() const override;
 	bool isWritable() const override;
+	bool supportsBackgroundRead() const override { return true; }
 
 	AbstractFSNode *getChild(const Common::String &n) const override;
 	bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override;
@@ -75,6 +76,25 @@ protected:
 	 * Tests and sets the _isValid and _isDirectory flags, using the stat() function.
 	 */
 	virtual void setFlags();
+
+	/**
+	 * Whether reading the file may map it into memory: only if the
+	 * "mmap_game_data" setting allows it, and never for savefiles.
+	 */
+	bool isMappable() const;
+
+public:
+	/**
+	 * Read the settings isMappable() depends on. They are cached, since
+	 * streams may be created on other threads, which must not access the
+	 * configuration. Called by POSIXFilesystemFactory::engineInit().
+	 */
+	static void updateMappingSettings();
+
+private:
+	static bool _mmapGameData;
+	/** The save path, with a trailing separator. Files below it are never mapped. */
+	static Common::String _mmapExcludedPath;
 };
 
 namespace Posix {
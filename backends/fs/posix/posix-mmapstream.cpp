@@ -0,0 +1,91 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/posix/posix-mmapstream.h"
+
+#ifdef HAS_MMAP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+PosixMmapStream::Mapping::~Mapping() {
+	munmap(data, size);
+}
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size < (off_t)kMinMappedSize || st.st_size > (off_t)kMaxMappedSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	const size_t size = st.st_size;
+	void *data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after closing the file
+	close(fd);
+
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	MappingPtr mapping(new Mapping(data, size));
+	return new PosixMmapStream(mapping, (const byte *)data, size);
+}
+
+#else
+
+PosixMmapStream::Mapping::~Mapping() {
+}
+
+PosixMmapStream *PosixMmapStream::makeFromPath(const Common::String &path) {
+	return nullptr;
+}
+
+#endif
+
+PosixMmapStream::PosixMmapStream(const MappingPtr &mapping, const byte *data, uint32 size) :
+		Common::MemoryReadStream(data, size, DisposeAfterUse::NO), _mapping(mapping), _data(data) {
+}
+
+Common::SeekableReadStream *PosixMmapStream::readStream(uint32 dataSize) {
+	const uint32 position = pos();
+	const uint32 available = size() - position;
+
+	if (dataSize > available) {
+		// Hit the end of the stream, just like read() does
+		dataSize = available;
+		byte dummy;
+		seek(0, SEEK_END);
+		read(&dummy, 1);
+	} else {
+		seek(dataSize, SEEK_CUR);
+	}
+
+	return new PosixMmapStream(_mapping, _data + position, dataSize);
+}
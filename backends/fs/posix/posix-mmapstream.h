@@ -0,0 +1,74 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_FS_POSIX_POSIXMMAPSTREAM_H
+#define BACKENDS_FS_POSIX_POSIXMMAPSTREAM_H
+
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/str.h"
+
+/**
+ * A read stream over a file mapped into memory with mmap().
+ *
+ * Reading needs no system calls, and readStream() returns views into the
+ * mapping instead of copying the data, which helps engines slicing their
+ * resources out of large bundle files. The views keep the mapping alive,
+ * so they stay valid after this stream is deleted.
+ */
+class PosixMmapStream final : public Common::MemoryReadStream {
+public:
+	enum {
+		/** Smaller files are read with stdio, for which mapping is not worth it. */
+		kMinMappedSize = 1024 * 1024,
+		/** Larger files are read with stdio, so as to not use up the address space. */
+		kMaxMappedSize = sizeof(void *) >= 8 ? 0x7FFFFFFF : 256 * 1024 * 1024
+	};
+
+	/**
+	 * Map the file at @p path into memory.
+	 *
+	 * @return The new stream, or nullptr if mapping the file failed or its
+	 *         size is out of the range of mapped files.
+	 */
+	static PosixMmapStream *makeFromPath(const Common::String &path);
+
+	Common::SeekableReadStream *readStream(uint32 dataSize) override;
+
+private:
+	/** A mapped file, unmapped when the last stream using it is gone. */
+	struct Mapping {
+		Mapping(void *data_, size_t size_) : data(data_), size(size_) {}
+		~Mapping();
+
+		void *data;
+		size_t size;
+	};
+
+	typedef Common::SharedPtr<Mapping> MappingPtr;
+
+	PosixMmapStream(const MappingPtr &mapping, const byte *data, uint32 size);
+
+	MappingPtr _mapping;
+	const byte *_data;
+};
+
+#endif
@@ -86,6 +86,17 @@ public:
 	virtual void setPalette(const byte *colors, uint start, uint num) = 0;
 	virtual void grabPalette(byte *colors, uint start, uint num) const = 0;
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+#ifdef USE_RGB_COLOR
+		const int bytesPerPixel = getScreenFormat().bytesPerPixel;
+#else
+		const int bytesPerPixel = 1;
+#endif
+		for (uint i = 0; i < count; i++) {
+			const Common::Rect &r = rects[i];
+			copyRectToScreen((const byte *)buf + r.top * pitch + r.left * bytesPerPixel, pitch, r.left, r.top, r.width(), r.height());
+		}
+	}
 	virtual Graphics::Surface *lockScreen() = 0;
 	virtual void unlockScreen() = 0;
 	virtual void fillScreen(uint32 col) = 0;
@@ -1752,6 +1752,45 @@ void SurfaceSdlGraphicsManager::copyRectToScreen(const void *buf, int pitch, int
 	SDL_UnlockSurface(_screen);
 }
 
+void SurfaceSdlGraphicsManager::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	assert(_transactionMode == kTransactionNone);
+	assert(buf);
+
+	if (_screen == nullptr) {
+		warning("SurfaceSdlGraphicsManager::copyRectsToScreen: _screen == NULL");
+		return;
+	}
+
+	Common::StackLock lock(_graphicsMutex);	// Lock the mutex until this function ends
+
+	// Try to lock the screen surface once for all the rects
+	if (!lockSurface(_screen))
+		error("SDL_LockSurface failed: %s", SDL_GetError());
+
+	const int bytesPerPixel = _screenFormat.bytesPerPixel;
+	for (uint i = 0; i < count; i++) {
+		const Common::Rect &r = rects[i];
+		int h = r.height();
+
+		assert(r.left >= 0 && r.right <= _videoMode.screenWidth);
+		assert(r.top >= 0 && r.bottom <= _videoMode.screenHeight);
+		assert(r.width() > 0 && h > 0);
+
+		addDirtyRect(r.left, r.top, r.width(), h, false);
+
+		const byte *src = (const byte *)buf + r.top * pitch + r.left * bytesPerPixel;
+		byte *dst = (byte *)_screen->pixels + r.top * _screen->pitch + r.left * bytesPerPixel;
+		do {
+			memcpy(dst, src, r.width() * bytesPerPixel);
+			src += pitch;
+			dst += _screen->pitch;
+		} while (--h);
+	}
+
+	// Unlock the screen surface
+	SDL_UnlockSurface(_screen);
+}
+
 Graphics::Surface *SurfaceSdlGraphicsManager::lockScreen() {
 	assert(_transactionMode == kTransactionNone);
 
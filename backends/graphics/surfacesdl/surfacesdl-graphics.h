@@ -102,6 +102,7 @@ protected:
 #endif
 public:
 	void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override;
+	void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) override;
 	Graphics::Surface *lockScreen() override;
 	void unlockScreen() override;
 	void fillScreen(uint32 col) override;
@@ -24,6 +24,7 @@
 #if defined(SDL_BACKEND)
 
 #include "backends/mixer/sdl/sdl-mixer.h"
+#include "audio/mixer_profiler.h"
 #include "common/debug.h"
 #include "common/system.h"
 #include "common/config-manager.h"
@@ -37,7 +38,7 @@
 #define SAMPLES_PER_SEC 44100
 #endif
 
-SdlMixerManager::SdlMixerManager() : _isSubsystemInitialized(false), _isAudioOpen(false) {
+SdlMixerManager::SdlMixerManager() : _isSubsystemInitialized(false), _isAudioOpen(false), _lastCallbackMicros(0) {
 }
 
 SdlMixerManager::~SdlMixerManager() {
@@ -235,6 +236,23 @@ void SdlMixerManager::startAudio() {
 
 void SdlMixerManager::callbackHandler(byte *samples, int len) {
 	assert(_mixer);
+
+	Audio::MixerProfiler *profiler = _mixer->getProfiler();
+	if (profiler->isEnabled()) {
+		// SDL asks for the next buffer once the previous one is mostly
+		// played. If the request comes much later than one buffer after
+		// the last one, the device has been playing silence meanwhile.
+		const uint64 now = g_system->getMicros();
+		const uint32 numFrames = len / (_obtained.channels * 2);
+		const uint64 period = (uint64)numFrames * 1000000 / _obtained.freq;
+
+		if (_lastCallbackMicros && now - _lastCallbackMicros > period * 3 / 2)
+			profiler->addUnderrun();
+		_lastCallbackMicros = now;
+	} else {
+		_lastCallbackMicros = 0;
+	}
+
 	_mixer->mixCallback(samples, len);
 }
 
@@ -87,6 +87,12 @@ protected:
 	bool _isSubsystemInitialized;
 	bool _isAudioOpen;
 
+	/**
+	 * Start time of the previous callback while the mixer is being
+	 * profiled, used to detect the device running out of data.
+	 */
+	uint64 _lastCallbackMicros;
+
 #if SDL_VERSION_ATLEAST(3, 0, 0)
 	SDL_AudioStream *_stream = nullptr;
 #endif
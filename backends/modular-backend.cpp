@@ -172,6 +172,10 @@ void ModularGraphicsBackend::copyRectToScreen(const void *buf, int pitch, int x,
 	_graphicsManager->copyRectToScreen(buf, pitch, x, y, w, h);
 }
 
+void ModularGraphicsBackend::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	_graphicsManager->copyRectsToScreen(buf, pitch, rects, count);
+}
+
 Graphics::Surface *ModularGraphicsBackend::lockScreen() {
 	return _graphicsManager->lockScreen();
 }
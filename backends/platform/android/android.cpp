@@ -67,6 +67,7 @@
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 
@@ -906,6 +907,26 @@ Common::MutexInternal *OSystem_Android::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_Android::createThread(void (*proc)(void *data), void *data, const char *name) {
+	return createPthreadThreadInternal(proc, data, name);
+}
+
+Common::SemaphoreInternal *OSystem_Android::createSemaphore(uint initialCount) {
+	return createPthreadSemaphoreInternal(initialCount);
+}
+
+uint OSystem_Android::getNumCPUs() {
+	return getPthreadNumCPUs();
+}
+
+void OSystem_Android::yieldThread() {
+	pthreadYield();
+}
+
+uintptr OSystem_Android::getThreadId() {
+	return pthreadGetThreadId();
+}
+
 void OSystem_Android::quit() {
 	ENTER();
 
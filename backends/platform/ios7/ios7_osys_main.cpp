@@ -51,6 +51,7 @@
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
 #include "backends/fs/chroot/chroot-fs-factory.h"
 #include "backends/fs/posix/posix-fs.h"
 #include "audio/mixer.h"
@@ -359,6 +360,26 @@ Common::MutexInternal *OSystem_iOS7::createMutex() {
 	return createPthreadMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_iOS7::createThread(void (*proc)(void *data), void *data, const char *name) {
+	return createPthreadThreadInternal(proc, data, name);
+}
+
+Common::SemaphoreInternal *OSystem_iOS7::createSemaphore(uint initialCount) {
+	return createPthreadSemaphoreInternal(initialCount);
+}
+
+uint OSystem_iOS7::getNumCPUs() {
+	return getPthreadNumCPUs();
+}
+
+void OSystem_iOS7::yieldThread() {
+	pthreadYield();
+}
+
+uintptr OSystem_iOS7::getThreadId() {
+	return pthreadGetThreadId();
+}
+
 void OSystem_iOS7::quit() {
 }
 
@@ -125,6 +125,11 @@ public:
 	uint32 getMillis(bool skipRecord = false) override;
 	void delayMillis(uint msecs) override;
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *data), void *data, const char *name) override;
+	Common::SemaphoreInternal *createSemaphore(uint initialCount) override;
+	uint getNumCPUs() override;
+	void yieldThread() override;
+	uintptr getThreadId() override;
 
 	static void mixCallback(void *sys, byte *samples, int len);
 	virtual void setupMixer(void);
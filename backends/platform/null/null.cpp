@@ -51,14 +51,29 @@ typedef void (*sighandler_t)(int);
 #include "backends/mutex/null/null-mutex.h"
 #include "base/main.h"
 
+// The tests of threaded code need real threads. Builds of the SDL backend
+// run them on SDL threads, so that the SDL implementation gets tested too.
+#if defined(SDL_BACKEND) && defined(NULL_DRIVER_USE_FOR_TEST)
+#define NULL_DRIVER_USE_THREADS 1
+#define NULL_DRIVER_USE_SDL_THREADS 1
+#include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threads/sdl/sdl-threads.h"
+#include "backends/platform/sdl/sdl-sys.h"
+#elif defined(POSIX) && defined(NULL_DRIVER_USE_FOR_TEST)
+#define NULL_DRIVER_USE_THREADS 1
+#define NULL_DRIVER_USE_PTHREADS 1
+#include "backends/mutex/pthread/pthread-mutex.h"
+#include "backends/threads/pthread/pthread-threads.h"
+#endif
+
 #ifndef NULL_DRIVER_USE_FOR_TEST
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
 #include "backends/mixer/null/null-mixer.h"
-#include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
 #endif
+#include "backends/graphics/null/null-graphics.h"
 
 /*
  * Include header files needed for the getFilesystemFactory() method.
@@ -85,7 +100,17 @@ public:
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
+#ifdef NULL_DRIVER_USE_THREADS
+	virtual Common::ThreadInternal *createThread(Common::ThreadProc proc, void *data, const char *name);
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialCount);
+	virtual uint getNumCPUs();
+	virtual void yieldThread();
+	virtual uintptr getThreadId();
+#endif
 	virtual uint32 getMillis(bool skipRecord = false);
+#ifdef POSIX
+	virtual uint64 getMicros();
+#endif
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
 
@@ -119,6 +144,12 @@ OSystem_NULL::OSystem_NULL(bool silenceLogs) :
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	// Codecs pick their output format from the screen
+	_graphicsManager = new NullGraphicsManager();
+	_graphicsManager->initSize(320, 200);
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -187,9 +218,59 @@ bool OSystem_NULL::pollEvent(Common::Event &event) {
 }
 
 Common::MutexInternal *OSystem_NULL::createMutex() {
+#if defined(NULL_DRIVER_USE_SDL_THREADS)
+	return createSdlMutexInternal();
+#elif defined(NULL_DRIVER_USE_PTHREADS)
+	return createPthreadMutexInternal();
+#else
 	return new NullMutexInternal();
+#endif
+}
+
+#if defined(NULL_DRIVER_USE_SDL_THREADS)
+Common::ThreadInternal *OSystem_NULL::createThread(Common::ThreadProc proc, void *data, const char *name) {
+	return createSdlThreadInternal(proc, data, name);
+}
+
+Common::SemaphoreInternal *OSystem_NULL::createSemaphore(uint initialCount) {
+	return createSdlSemaphoreInternal(initialCount);
+}
+
+uint OSystem_NULL::getNumCPUs() {
+	// Test with worker threads on single core machines as well
+	return MAX<uint>(getSdlNumCPUs(), 4);
+}
+
+void OSystem_NULL::yieldThread() {
+	SDL_Delay(0);
 }
 
+uintptr OSystem_NULL::getThreadId() {
+	return getSdlThreadId();
+}
+#elif defined(NULL_DRIVER_USE_PTHREADS)
+Common::ThreadInternal *OSystem_NULL::createThread(Common::ThreadProc proc, void *data, const char *name) {
+	return createPthreadThreadInternal(proc, data, name);
+}
+
+Common::SemaphoreInternal *OSystem_NULL::createSemaphore(uint initialCount) {
+	return createPthreadSemaphoreInternal(initialCount);
+}
+
+uint OSystem_NULL::getNumCPUs() {
+	// Test with worker threads on single core machines as well
+	return MAX<uint>(getPthreadNumCPUs(), 4);
+}
+
+void OSystem_NULL::yieldThread() {
+	pthreadYield();
+}
+
+uintptr OSystem_NULL::getThreadId() {
+	return pthreadGetThreadId();
+}
+#endif
+
 uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #ifdef POSIX
 	timeval curTime;
@@ -205,6 +286,16 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+#ifdef POSIX
+uint64 OSystem_NULL::getMicros() {
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)(curTime.tv_sec - _startTime.tv_sec) * 1000000 + (curTime.tv_usec - _startTime.tv_usec);
+}
+#endif
+
 void OSystem_NULL::delayMillis(uint msecs) {
 #ifdef POSIX
 	usleep(msecs * 1000);
@@ -221,6 +221,11 @@ Common::MutexInternal *OSystem_Emscripten::createMutex() {
 	return new NullMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_Emscripten::createThread(void (*proc)(void *data), void *data, const char *name) {
+	// The mutexes do nothing, so no other threads may run
+	return nullptr;
+}
+
 void OSystem_Emscripten::addSysArchivesToSearchSet(Common::SearchSet &s, int priority) {
 	// Add the global DATA_PATH (and some sub-folders) to the directory search list 
 	// Note: gui-icons folder is added in GuiManager::initIconsSet 
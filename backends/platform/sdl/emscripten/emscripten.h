@@ -53,6 +53,7 @@ public:
 	GraphicsManagerType getDefaultGraphicsManager() const override;
 #endif
 	Common::MutexInternal *createMutex() override;
+	Common::ThreadInternal *createThread(void (*proc)(void *data), void *data, const char *name) override;
 	void exportFile(const Common::Path &filename);
 	void delayMillis(uint msecs) override;
 	void init() override;
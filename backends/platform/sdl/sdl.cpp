@@ -46,6 +46,7 @@
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threads/sdl/sdl-threads.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -840,6 +841,26 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(void (*proc)(void *data), void *data, const char *name) {
+	return createSdlThreadInternal(proc, data, name);
+}
+
+Common::SemaphoreInternal *OSystem_SDL::createSemaphore(uint initialCount) {
+	return createSdlSemaphoreInternal(initialCount);
+}
+
+uint OSystem_SDL::getNumCPUs() {
+	return getSdlNumCPUs();
+}
+
+void OSystem_SDL::yieldThread() {
+	SDL_Delay(0);
+}
+
+uintptr OSystem_SDL::getThreadId() {
+	return getSdlThreadId();
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
@@ -850,6 +871,18 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	return SDL_GetTicksNS() / 1000;
+#else
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	const uint64 counter = SDL_GetPerformanceCounter();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#endif
+}
+#endif
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
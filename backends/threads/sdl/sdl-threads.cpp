@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threads/sdl/sdl-threads.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/textconsole.h"
+#include "common/util.h"
+
+class SdlThreadInternal final : public Common::ThreadInternal {
+public:
+	SdlThreadInternal(Common::ThreadProc proc, void *data, const char *name);
+	~SdlThreadInternal() override;
+
+	bool isValid() const { return _thread != nullptr; }
+
+private:
+	static int SDLCALL threadFunc(void *arg);
+
+	SDL_Thread *_thread;
+	Common::ThreadProc _proc;
+	void *_data;
+};
+
+SdlThreadInternal::SdlThreadInternal(Common::ThreadProc proc, void *data, const char *name) : _proc(proc), _data(data) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	_thread = SDL_CreateThread(threadFunc, name, this);
+#else
+	_thread = SDL_CreateThread(threadFunc, this);
+#endif
+	if (!_thread)
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+}
+
+SdlThreadInternal::~SdlThreadInternal() {
+	if (_thread)
+		SDL_WaitThread(_thread, nullptr);
+}
+
+int SDLCALL SdlThreadInternal::threadFunc(void *arg) {
+	SdlThreadInternal *thread = (SdlThreadInternal *)arg;
+	thread->_proc(thread->_data);
+	return 0;
+}
+
+
+class SdlSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	SdlSemaphoreInternal(uint initialCount) { _semaphore = SDL_CreateSemaphore(initialCount); }
+	~SdlSemaphoreInternal() override { SDL_DestroySemaphore(_semaphore); }
+
+	bool isValid() const { return _semaphore != nullptr; }
+
+	void post() override {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_SignalSemaphore(_semaphore);
+#else
+		SDL_SemPost(_semaphore);
+#endif
+	}
+	void wait() override {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+		SDL_WaitSemaphore(_semaphore);
+#else
+		SDL_SemWait(_semaphore);
+#endif
+	}
+
+private:
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	SDL_Semaphore *_semaphore;
+#else
+	SDL_sem *_semaphore;
+#endif
+};
+
+
+Common::ThreadInternal *createSdlThreadInternal(Common::ThreadProc proc, void *data, const char *name) {
+	SdlThreadInternal *thread = new SdlThreadInternal(proc, data, name);
+	if (!thread->isValid()) {
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createSdlSemaphoreInternal(uint initialCount) {
+	SdlSemaphoreInternal *semaphore = new SdlSemaphoreInternal(initialCount);
+	if (!semaphore->isValid()) {
+		delete semaphore;
+		return nullptr;
+	}
+	return semaphore;
+}
+
+uint getSdlNumCPUs() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	return MAX(SDL_GetNumLogicalCPUCores(), 1);
+#elif SDL_VERSION_ATLEAST(2, 0, 0)
+	return MAX(SDL_GetCPUCount(), 1);
+#else
+	return 1;
+#endif
+}
+
+uintptr getSdlThreadId() {
+#if SDL_VERSION_ATLEAST(3, 0, 0)
+	return (uintptr)SDL_GetCurrentThreadID();
+#else
+	return (uintptr)SDL_ThreadID();
+#endif
+}
+
+#endif
@@ -336,6 +336,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("enable_unsupported_game_warning", true);
 	ConfMan.registerDefault("enable_unsupported_addon_warning", true);
 
+	// Map large game data files into memory on POSIX systems
+	ConfMan.registerDefault("mmap_game_data", false);
+
 #if defined(USE_FLUIDSYNTH) || defined(USE_FLUIDLITE)
 	ConfMan.registerDefault("soundfont", "Roland_SC-55.sf2");
 #endif
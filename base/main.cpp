@@ -43,10 +43,12 @@
 #include "common/events.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
+#include "common/prefetch.h"
 #ifdef ENABLE_EVENTRECORDER
 #include "common/recorderfile.h"
 #endif
 #include "common/system.h"
+#include "common/taskpool.h"
 #include "common/textconsole.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -59,6 +61,7 @@
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"  /* for music manager */
+#include "audio/soundcache.h"
 
 #include "graphics/cursorman.h"
 #include "graphics/fontman.h"
@@ -68,6 +71,7 @@
 #endif
 #include "graphics/scalerplugin.h"
 
+#include "backends/fs/fs-factory.h"
 #include "backends/keymapper/action.h"
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/keymapper.h"
@@ -308,6 +312,7 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 
 	// Inform backend that the engine is about to be run
 	system.engineInit();
+	system.getFilesystemFactory()->engineInit();
 
 	// Purge queued input events that may remain from the GUI (such as key-up)
 	system.getEventManager()->purgeKeyboardEvents();
@@ -332,6 +337,14 @@ static Common::Error runGame(const Plugin *enginePlugin, OSystem &system, const
 	// Reset the file/directory mappings
 	SearchMan.clear();
 
+	// Drop the sounds decoded from the game files
+	if (Audio::SoundCacheManager::hasInstance())
+		SoundCacheMan.clear();
+
+	// Drop the game files loaded ahead of time, which were not used
+	if (Common::PrefetchManager::hasInstance())
+		PrefetchMan.clear();
+
 #ifdef USE_TRANSLATION
 	TransMan.setLanguage(previousLanguage);
 	Common::TextToSpeechManager *ttsMan;
@@ -895,6 +908,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	//I think it's important to destroy it after ConnectionManager
 	Cloud::CloudManager::destroy();
 #endif
+	Common::TaskPool::destroy();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
 	Common::ConfigManager::destroy();
@@ -903,11 +917,13 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #ifdef ENABLE_EVENTRECORDER
 	GUI::EventRecorder::destroy();
 #endif
+	Common::PrefetchManager::destroy();
 	Common::SearchManager::destroy();
 #ifdef USE_TRANSLATION
 	Common::MainTranslationManager::destroy();
 #endif
 	MusicManager::destroy();
+	Audio::SoundCacheManager::destroy();
 	Graphics::CursorManager::destroy();
 	Graphics::FontManager::destroy();
 #ifdef USE_FREETYPE2
@@ -25,6 +25,7 @@
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/memstream.h"
+#include "common/prefetch.h"
 #include "common/punycode.h"
 #include "common/debug.h"
 
@@ -41,6 +42,10 @@ bool ArchiveMember::isInMacArchive() const {
 	return false;
 }
 
+bool ArchiveMember::supportsBackgroundRead() const {
+	return false;
+}
+
 bool ArchiveMember::isDirectory() const {
 	return false;
 }
@@ -123,6 +128,27 @@ SeekableReadStream *Archive::createReadStreamForMemberAltStream(const Path &path
 	return nullptr;
 }
 
+Archive::~Archive() {
+	if (PrefetchManager::hasInstance())
+		PrefetchMan.removeRequests(this);
+}
+
+PrefetchRequestPtr Archive::prefetch(const Array<Path> &paths) const {
+	PrefetchRequestPtr request(new PrefetchRequest(this));
+
+	for (const Path &path : paths) {
+		if (!hasFile(path))
+			continue;
+
+		ArchiveMemberPtr member = getMember(path);
+		if (member && !member->isDirectory())
+			request->addMember(path, member);
+	}
+
+	PrefetchMan.addRequest(request);
+	return request;
+}
+
 Common::Error Archive::dumpArchive(const Path &destPath) {
 	Common::ArchiveMemberList files;
 
@@ -308,6 +334,14 @@ uint MemcachingCaseInsensitiveArchive::CacheKey_Hash::operator()(const CacheKey
 	return static_cast<uint>(x.path.hashIgnoreCase() * 1000003u) ^ static_cast<uint>(x.altStreamType);
 }
 
+SearchSet::~SearchSet() {
+	// Stop the prefetch requests before the archives they read from go away
+	if (PrefetchManager::hasInstance())
+		PrefetchMan.removeRequests(this);
+
+	clear();
+}
+
 SearchSet::ArchiveNodeList::iterator SearchSet::find(const String &name) {
 	ArchiveNodeList::iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
@@ -579,6 +613,12 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	if (PrefetchManager::hasInstance()) {
+		SeekableReadStream *stream = PrefetchMan.takeStream(this, path);
+		if (stream)
+			return stream;
+	}
+
 	for (const auto &archive : _list) {
 		SeekableReadStream *stream = archive._arc->createReadStreamForMember(path);
 		if (stream)
@@ -45,6 +45,7 @@ namespace Common {
 
 class ArchiveMember;
 class FSNode;
+class PrefetchRequest;
 class SeekableReadStream;
 
 enum class AltStreamType {
@@ -56,6 +57,7 @@ enum class AltStreamType {
 
 typedef SharedPtr<ArchiveMember> ArchiveMemberPtr; /*!< Shared pointer to an archive member. */
 typedef List<ArchiveMemberPtr> ArchiveMemberList;  /*!< List of archive members. */
+typedef SharedPtr<PrefetchRequest> PrefetchRequestPtr; /*!< Shared pointer to a prefetch request. */
 
 /**
  * The ArchiveMember class is an abstract interface to represent elements inside
@@ -83,6 +85,7 @@ public:
 	virtual void listChildren(ArchiveMemberList &childList, const char *pattern = nullptr) const; /*!< Adds the immediate children of this archive member to childList, optionally matching a pattern. */
 	virtual U32String getDisplayName() const; /*!< Get the display name of the archive member. */
 	virtual bool isInMacArchive() const; /*!< Checks if the ArchiveMember is in a Mac archive, in which case resource forks and Finder info can only be loaded via alt streams. */
+	virtual bool supportsBackgroundRead() const; /*!< Checks if createReadStream can be called, and the stream read, from another thread while the archive is in use. */
 };
 
 struct ArchiveMemberDetails {
@@ -142,7 +145,7 @@ class Archive {
 public:
 	Archive() : _mapsAreReady(false) { }
 
-	virtual ~Archive() { }
+	virtual ~Archive();
 
 	/**
 	 * Check if a member with the given @p name is present in the Archive.
@@ -204,6 +207,22 @@ public:
 		return createReadStreamForMember(path);
 	}
 
+	/**
+	 * Start loading the given members into memory in the background, so that
+	 * opening them later does not have to wait for the disk.
+	 *
+	 * Members which do not exist are ignored. Loading only happens in the
+	 * background for members which support it (see
+	 * ArchiveMember::supportsBackgroundRead), the others are read when they
+	 * are requested from the returned request.
+	 *
+	 * For a SearchSet, createReadStreamForMember() returns the prefetched data
+	 * of the members as well, even if the request is not kept.
+	 *
+	 * @return The request, which can be used to wait for the members and to take their streams.
+	 */
+	PrefetchRequestPtr prefetch(const Array<Path> &paths) const;
+
 	/**
 	 * Dump all files from the archive to the given directory
 	 */
@@ -349,7 +368,7 @@ class SearchSet : public Archive {
 
 public:
 	SearchSet() : _ignoreClashes(false) { }
-	virtual ~SearchSet() { clear(); }
+	virtual ~SearchSet();
 
 	char getPathSeparator() const override { return '/'; }
 
@@ -0,0 +1,133 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ATOMIC_H
+#define COMMON_ATOMIC_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+// See common/intrinsics.h for why setjmp and longjmp need to be handled here
+#undef setjmp
+#undef longjmp
+#include <intrin.h>
+#ifndef FORBIDDEN_SYMBOL_EXCEPTION_setjmp
+#undef setjmp
+#define setjmp(a)	FORBIDDEN_SYMBOL_REPLACEMENT
+#endif
+
+#ifndef FORBIDDEN_SYMBOL_EXCEPTION_longjmp
+#undef longjmp
+#define longjmp(a,b)	FORBIDDEN_SYMBOL_REPLACEMENT
+#endif
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_atomic Atomic
+ * @ingroup common
+ *
+ * @brief A 32-bit value that can be shared between threads without a mutex.
+ * @{
+ */
+
+/**
+ * A 32-bit integer that can be read and written from several threads
+ * without locking. All operations are sequentially consistent, so they
+ * also order the plain memory accesses around them.
+ *
+ * On compilers without atomic builtins this falls back to volatile
+ * accesses, which is only sufficient for single core targets.
+ */
+template<typename T>
+class Atomic : NonCopyable {
+	static_assert(sizeof(T) == 4, "Atomic only supports 32-bit types");
+
+public:
+	Atomic() : _value(0) {}
+	explicit Atomic(T value) : _value(value) {}
+
+	T load() const {
+#if defined(__GNUC__)
+		return __atomic_load_n(&_value, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+		return (T)_InterlockedOr((volatile long *)&_value, 0);
+#else
+		return _value;
+#endif
+	}
+
+	void store(T value) {
+#if defined(__GNUC__)
+		__atomic_store_n(&_value, value, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+		_InterlockedExchange((volatile long *)&_value, (long)value);
+#else
+		_value = value;
+#endif
+	}
+
+	/**
+	 * Replace the value with @p desired, provided it still equals @p expected.
+	 *
+	 * @return true if the value was replaced.
+	 */
+	bool compareExchange(T expected, T desired) {
+#if defined(__GNUC__)
+		return __atomic_compare_exchange_n(&_value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+		return _InterlockedCompareExchange((volatile long *)&_value, (long)desired, (long)expected) == (long)expected;
+#else
+		if (_value != expected)
+			return false;
+		_value = desired;
+		return true;
+#endif
+	}
+
+	/**
+	 * Add @p value.
+	 *
+	 * @return The value before the addition.
+	 */
+	T fetchAdd(T value) {
+#if defined(__GNUC__)
+		return __atomic_fetch_add(&_value, value, __ATOMIC_SEQ_CST);
+#elif defined(_MSC_VER)
+		return (T)_InterlockedExchangeAdd((volatile long *)&_value, (long)value);
+#else
+		T old = _value;
+		_value = old + value;
+		return old;
+#endif
+	}
+
+private:
+	mutable volatile T _value;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
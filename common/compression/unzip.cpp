@@ -95,6 +95,8 @@ typedef Byte Bytef;
 #include "common/compression/deflate.h"
 #include "common/compression/unzip.h"
 #include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -287,6 +289,10 @@ int unzGetLocalExtrafield(unzFile file, voidp buf, unsigned len);
 #define SIZECENTRALDIRITEM (0x2e)
 #define SIZEZIPLOCALHEADER (0x1e)
 
+/* members of at least this size are decompressed while they are read,
+   instead of all at once when they are opened */
+#define UNZ_STREAMINGSIZE (1024 * 1024)
+
 
 #if 0
 const char unz_copyright[] =
@@ -324,7 +330,8 @@ typedef Common::HashMap<Common::Path, cached_file_in_zip, Common::Path::IgnoreCa
 /* unz_s contain internal information about the zipfile
 */
 typedef struct {
-	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _stream;	/* io structore of the zipfile, shared with the streamed members */
+	Common::ScopedPtr<Common::SeekableReadStream> _centralDir;	/* copy of the central dir in memory */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -458,7 +465,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 
 	int err = UNZ_OK;
 
-	us->_stream = stream;
+	us->_stream.reset(stream);
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos == 0)
@@ -469,27 +476,26 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		err = UNZ_ERRNO;
 
 	/* the signature, already checked */
-	if (unzlocal_getLong(us->_stream, &uL) != UNZ_OK)
+	if (unzlocal_getLong(us->_stream.get(), &uL) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	/* number of this disk */
-	if (unzlocal_getShort(us->_stream, &number_disk) != UNZ_OK)
+	if (unzlocal_getShort(us->_stream.get(), &number_disk) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	/* number of the disk with the start of the central directory */
-	if (unzlocal_getShort(us->_stream, &number_disk_with_CD) != UNZ_OK)
+	if (unzlocal_getShort(us->_stream.get(), &number_disk_with_CD) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	/* total number of entries in the central dir on this disk */
-	if (unzlocal_getShort(us->_stream, &us->gi.number_entry) != UNZ_OK)
+	if (unzlocal_getShort(us->_stream.get(), &us->gi.number_entry) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	/* total number of entries in the central dir */
-	if (unzlocal_getShort(us->_stream, &number_entry_CD) != UNZ_OK)
+	if (unzlocal_getShort(us->_stream.get(), &number_entry_CD) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -500,23 +506,22 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		err = UNZ_BADZIPFILE;
 
 	/* size of the central directory */
-	if (unzlocal_getLong(us->_stream, &us->size_central_dir) != UNZ_OK)
+	if (unzlocal_getLong(us->_stream.get(), &us->size_central_dir) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	/* offset of start of central directory with respect to the
 	      starting disk number */
-	if (unzlocal_getLong(us->_stream, &us->offset_central_dir) != UNZ_OK)
+	if (unzlocal_getLong(us->_stream.get(), &us->offset_central_dir) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	/* zipfile comment length */
-	if (unzlocal_getShort(us->_stream, &us->gi.size_comment) != UNZ_OK)
+	if (unzlocal_getShort(us->_stream.get(), &us->gi.size_comment) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	if ((central_pos < us->offset_central_dir + us->size_central_dir) && (err == UNZ_OK))
 		err = UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -525,6 +530,16 @@ unzFile unzOpen(Common::SeekableReadStream *stream, bool flattenTree) {
 		                    (us->offset_central_dir + us->size_central_dir);
 	us->central_pos = central_pos;
 
+	/* read the central dir at once, rather than seeking the file for each of its fields */
+	if (us->size_central_dir > 0) {
+		byte *centralDir = (byte *)malloc(us->size_central_dir);
+		us->_stream->seek(us->offset_central_dir + us->byte_before_the_zipfile, SEEK_SET);
+		if (centralDir && us->_stream->read(centralDir, us->size_central_dir) == us->size_central_dir)
+			us->_centralDir.reset(new Common::MemoryReadStream(centralDir, us->size_central_dir, DisposeAfterUse::YES));
+		else
+			free(centralDir);
+	}
+
 	err = unzGoToFirstFile((unzFile)us);
 
 	while (err == UNZ_OK) {
@@ -606,7 +621,6 @@ int unzClose(unzFile file) {
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -641,62 +655,69 @@ static int unzlocal_GetCurrentFileInfoInternal(unzFile file,
 	if (file == nullptr)
 		return UNZ_PARAMERROR;
 	s = (unz_s *)file;
-	s->_stream->seek(s->pos_in_central_dir + s->byte_before_the_zipfile, SEEK_SET);
-	if (s->_stream->err())
+
+	Common::SeekableReadStream *stream = s->_stream.get();
+	if (s->_centralDir) {
+		stream = s->_centralDir.get();
+		stream->seek(s->pos_in_central_dir - s->offset_central_dir, SEEK_SET);
+	} else {
+		stream->seek(s->pos_in_central_dir + s->byte_before_the_zipfile, SEEK_SET);
+	}
+	if (stream->err())
 		err = UNZ_ERRNO;
 
 
 	/* we check the magic */
 	if (err == UNZ_OK) {
-		if (unzlocal_getLong(s->_stream, &uMagic) != UNZ_OK)
+		if (unzlocal_getLong(stream, &uMagic) != UNZ_OK)
 			err = UNZ_ERRNO;
 		else if (uMagic != 0x02014b50)
 			err = UNZ_BADZIPFILE;
 	}
 
-	if (unzlocal_getShort(s->_stream, &file_info.version) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.version) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.version_needed) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.version_needed) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.flag) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.flag) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.compression_method) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.compression_method) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &file_info.dosDate) != UNZ_OK)
+	if (unzlocal_getLong(stream, &file_info.dosDate) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &file_info.crc) != UNZ_OK)
+	if (unzlocal_getLong(stream, &file_info.crc) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &file_info.compressed_size) != UNZ_OK)
+	if (unzlocal_getLong(stream, &file_info.compressed_size) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &file_info.uncompressed_size) != UNZ_OK)
+	if (unzlocal_getLong(stream, &file_info.uncompressed_size) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.size_filename) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.size_filename) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.size_file_extra) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.size_file_extra) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.size_file_comment) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.size_file_comment) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.disk_num_start) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.disk_num_start) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &file_info.internal_fa) != UNZ_OK)
+	if (unzlocal_getShort(stream, &file_info.internal_fa) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &file_info.external_fa) != UNZ_OK)
+	if (unzlocal_getLong(stream, &file_info.external_fa) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &file_info_internal.offset_curfile) != UNZ_OK)
+	if (unzlocal_getLong(stream, &file_info_internal.offset_curfile) != UNZ_OK)
 		err = UNZ_ERRNO;
 
 	lSeek += file_info.size_filename;
@@ -709,7 +730,7 @@ static int unzlocal_GetCurrentFileInfoInternal(unzFile file,
 			uSizeRead = fileNameBufferSize;
 
 		if ((file_info.size_filename > 0) && (fileNameBufferSize > 0))
-			if (s->_stream->read(szFileName, (uInt)uSizeRead) != uSizeRead)
+			if (stream->read(szFileName, (uInt)uSizeRead) != uSizeRead)
 				err = UNZ_ERRNO;
 		lSeek -= uSizeRead;
 	}
@@ -723,14 +744,14 @@ static int unzlocal_GetCurrentFileInfoInternal(unzFile file,
 			uSizeRead = extraFieldBufferSize;
 
 		if (lSeek != 0) {
-			s->_stream->seek(lSeek, SEEK_CUR);
-			if (s->_stream->err())
+			stream->seek(lSeek, SEEK_CUR);
+			if (stream->err())
 				lSeek=0;
 			else
 				err = UNZ_ERRNO;
 		}
 		if ((file_info.size_file_extra > 0) && (extraFieldBufferSize > 0))
-			if (s->_stream->read(extraField, (uInt)uSizeRead) != uSizeRead)
+			if (stream->read(extraField, (uInt)uSizeRead) != uSizeRead)
 				err = UNZ_ERRNO;
 		lSeek += file_info.size_file_extra - uSizeRead;
 	} else
@@ -746,14 +767,14 @@ static int unzlocal_GetCurrentFileInfoInternal(unzFile file,
 			uSizeRead = commentBufferSize;
 
 		if (lSeek!=0) {
-			s->_stream->seek(lSeek, SEEK_CUR);
-			if (s->_stream->err())
+			stream->seek(lSeek, SEEK_CUR);
+			if (stream->err())
 				lSeek = 0;
 			else
 				err = UNZ_ERRNO;
 		}
 		if ((file_info.size_file_comment>0) && (commentBufferSize > 0))
-			if (s->_stream->read(szComment, (uInt)uSizeRead) != uSizeRead)
+			if (stream->read(szComment, (uInt)uSizeRead) != uSizeRead)
 				err = UNZ_ERRNO;
 		lSeek += file_info.size_file_comment - uSizeRead;
 	} else
@@ -894,22 +915,22 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
 
 
 	if (err == UNZ_OK) {
-		if (unzlocal_getLong(s->_stream, &uMagic) != UNZ_OK)
+		if (unzlocal_getLong(s->_stream.get(), &uMagic) != UNZ_OK)
 			err = UNZ_ERRNO;
 		else if (uMagic != 0x04034b50)
 			err = UNZ_BADZIPFILE;
 	}
 
-	if (unzlocal_getShort(s->_stream, &uData) != UNZ_OK)
+	if (unzlocal_getShort(s->_stream.get(), &uData) != UNZ_OK)
 		err = UNZ_ERRNO;
 /*
 	else if ((err == UNZ_OK) && (uData!=s->cur_file_info.wVersion))
 		err = UNZ_BADZIPFILE;
 */
-	if (unzlocal_getShort(s->_stream, &uFlags) != UNZ_OK)
+	if (unzlocal_getShort(s->_stream.get(), &uFlags) != UNZ_OK)
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getShort(s->_stream, &uData) != UNZ_OK)
+	if (unzlocal_getShort(s->_stream.get(), &uData) != UNZ_OK)
 		err = UNZ_ERRNO;
 	else if ((err == UNZ_OK) && (uData != s->cur_file_info.compression_method))
 		err = UNZ_BADZIPFILE;
@@ -918,36 +939,36 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
 	                     (s->cur_file_info.compression_method != Z_DEFLATED))
 		err = UNZ_BADZIPFILE;
 
-	if (unzlocal_getLong(s->_stream, &uData) != UNZ_OK) /* date/time */
+	if (unzlocal_getLong(s->_stream.get(), &uData) != UNZ_OK) /* date/time */
 		err = UNZ_ERRNO;
 
-	if (unzlocal_getLong(s->_stream, &uData) != UNZ_OK) /* crc */
+	if (unzlocal_getLong(s->_stream.get(), &uData) != UNZ_OK) /* crc */
 		err = UNZ_ERRNO;
 	else if ((err == UNZ_OK) && (uData!=s->cur_file_info.crc) &&
 		                      ((uFlags & 8) == 0))
 		err = UNZ_BADZIPFILE;
 
-	if (unzlocal_getLong(s->_stream, &uData) != UNZ_OK) /* size compr */
+	if (unzlocal_getLong(s->_stream.get(), &uData) != UNZ_OK) /* size compr */
 		err = UNZ_ERRNO;
 	else if ((err == UNZ_OK) && (uData!=s->cur_file_info.compressed_size) &&
 							  ((uFlags & 8) == 0))
 		err = UNZ_BADZIPFILE;
 
-	if (unzlocal_getLong(s->_stream, &uData) != UNZ_OK) /* size uncompr */
+	if (unzlocal_getLong(s->_stream.get(), &uData) != UNZ_OK) /* size uncompr */
 		err = UNZ_ERRNO;
 	else if ((err == UNZ_OK) && (uData!=s->cur_file_info.uncompressed_size) &&
 							  ((uFlags & 8) == 0))
 		err = UNZ_BADZIPFILE;
 
 
-	if (unzlocal_getShort(s->_stream, &size_filename) != UNZ_OK)
+	if (unzlocal_getShort(s->_stream.get(), &size_filename) != UNZ_OK)
 		err = UNZ_ERRNO;
 	else if ((err == UNZ_OK) && (size_filename!=s->cur_file_info.size_filename))
 		err = UNZ_BADZIPFILE;
 
 	*piSizeVar += (uInt)size_filename;
 
-	if (unzlocal_getShort(s->_stream, &size_extra_field) != UNZ_OK)
+	if (unzlocal_getShort(s->_stream.get(), &size_extra_field) != UNZ_OK)
 		err = UNZ_ERRNO;
 	*poffset_local_extrafield = s->cur_file_info_internal.offset_curfile +
 									SIZEZIPLOCALHEADER + size_filename;
@@ -958,6 +979,82 @@ static int unzlocal_CheckCurrentFileCoherencyHeader(unz_s *s, uInt *piSizeVar,
 	return err;
 }
 
+/*
+  A member read straight from the zipfile, which keeps the zipfile open
+	as long as it is in use.
+*/
+class ZipMemberReadStream : public Common::SafeSeekableSubReadStream {
+public:
+	ZipMemberReadStream(const Common::SharedPtr<Common::SeekableReadStream> &parent, uint32 begin, uint32 end) :
+		Common::SafeSeekableSubReadStream(parent.get(), begin, end, DisposeAfterUse::NO), _parent(parent) {}
+
+private:
+	Common::SharedPtr<Common::SeekableReadStream> _parent;
+};
+
+/*
+  A large deflated member, inflated as it is read. Seeking backwards in a
+	deflate stream means inflating again from the start of the member, so the
+	first backward seek inflates the whole member into memory instead, and
+	any later seeks are served from there.
+*/
+class ZipInflatingReadStream : public Common::SeekableReadStream {
+public:
+	ZipInflatingReadStream(const Common::SharedPtr<Common::SeekableReadStream> &parent, uint32 begin, uint32 compressedSize, uint32 size) :
+		_parent(parent), _begin(begin), _compressedSize(compressedSize), _size(size), _inflated(false) {
+		_stream.reset(Common::wrapDeflateReadStream(new ZipMemberReadStream(parent, begin, begin + compressedSize), DisposeAfterUse::YES, size));
+	}
+
+	bool isValid() const { return _stream.get() != nullptr; }
+
+	bool err() const override { return _stream->err(); }
+	void clearErr() override { _stream->clearErr(); }
+	bool eos() const override { return _stream->eos(); }
+	uint32 read(void *dataPtr, uint32 dataSize) override { return _stream->read(dataPtr, dataSize); }
+	int64 pos() const override { return _stream->pos(); }
+	int64 size() const override { return _size; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		if (!_inflated) {
+			int64 newPos = offset;
+			if (whence == SEEK_CUR)
+				newPos += _stream->pos();
+			else if (whence == SEEK_END)
+				newPos += _size;
+			if (newPos < _stream->pos())
+				inflateAll();
+		}
+		return _stream->seek(offset, whence);
+	}
+
+private:
+	void inflateAll() {
+		byte *compressedBuffer = new byte[_compressedSize];
+		byte *uncompressedBuffer = new byte[_size];
+
+		_parent->seek(_begin);
+		if (_parent->read(compressedBuffer, _compressedSize) != _compressedSize ||
+		    !Common::inflateZlibHeaderless(uncompressedBuffer, _size, compressedBuffer, _compressedSize)) {
+			// Keep inflating from the start of the member
+			delete[] compressedBuffer;
+			delete[] uncompressedBuffer;
+			return;
+		}
+		delete[] compressedBuffer;
+
+		_stream.reset(new Common::MemoryReadStream(uncompressedBuffer, _size, DisposeAfterUse::YES));
+		_parent.reset();
+		_inflated = true;
+	}
+
+	Common::ScopedPtr<Common::SeekableReadStream> _stream;
+	Common::SharedPtr<Common::SeekableReadStream> _parent;
+	uint32 _begin;
+	uint32 _compressedSize;
+	uint32 _size;
+	bool _inflated;
+};
+
 /*
   Open for reading data the current file in the zipfile.
   If there is no error and the file is opened, the return value is UNZ_OK.
@@ -988,9 +1085,26 @@ Common::SharedArchiveContents unzOpenCurrentFile (unzFile file
 	}
 
 	uint32 crc32_wait = s->cur_file_info.crc;
+	uLong offset_data = s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar;
+
+	/* large members are decompressed as they are read, so that opening them
+	   does not have to wait for all of it. Their crc is not checked. */
+	if (s->cur_file_info.uncompressed_size >= UNZ_STREAMINGSIZE) {
+		if (s->cur_file_info.compression_method == Z_DEFLATED) {
+			ZipInflatingReadStream *stream = new ZipInflatingReadStream(s->_stream, offset_data,
+				s->cur_file_info.compressed_size, s->cur_file_info.uncompressed_size);
+			if (!stream->isValid()) {
+				delete stream;
+				return Common::SharedArchiveContents();
+			}
+			return Common::SharedArchiveContents::bypass(stream);
+		}
+		return Common::SharedArchiveContents::bypass(new ZipMemberReadStream(s->_stream, offset_data,
+			offset_data + s->cur_file_info.compressed_size));
+	}
 
 	byte *compressedBuffer = new byte[s->cur_file_info.compressed_size];
-	s->_stream->seek(s->cur_file_info_internal.offset_curfile + SIZEZIPLOCALHEADER + iSizeVar);
+	s->_stream->seek(offset_data);
 	s->_stream->read(compressedBuffer, s->cur_file_info.compressed_size);
 	byte *uncompressedBuffer = nullptr;
 
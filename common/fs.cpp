@@ -41,6 +41,7 @@ public:
 	U32String getDisplayName() const override;
 	bool isDirectory() const override;
 	void listChildren(ArchiveMemberList &list, const char *pattern) const override;
+	bool supportsBackgroundRead() const override;
 
 private:
 	Common::Path _pathInDirectory;
@@ -59,6 +60,10 @@ SeekableReadStream *FSDirectoryFile::createReadStreamForAltStream(AltStreamType
 	return _fsNode.createReadStreamForAltStream(altStreamType);
 }
 
+bool FSDirectoryFile::supportsBackgroundRead() const {
+	return _fsNode.supportsBackgroundRead();
+}
+
 String FSDirectoryFile::getName() const {
 	return _fsNode.getName();
 }
@@ -225,6 +230,10 @@ void FSNode::listChildren(ArchiveMemberList &childList, const char *pattern) con
 	}
 }
 
+bool FSNode::supportsBackgroundRead() const {
+	return _realNode && _realNode->supportsBackgroundRead();
+}
+
 bool FSNode::isReadable() const {
 	return _realNode && _realNode->isReadable();
 }
@@ -226,6 +226,12 @@ public:
 	 */
 	void listChildren(Common::ArchiveMemberList &childList, const char *pattern = nullptr) const override;
 
+	/**
+	 * Indicate whether the streams created by createReadStream() can be read
+	 * from another thread, for example to prefetch the file.
+	 */
+	bool supportsBackgroundRead() const override;
+
 	/**
 	 * Indicate whether the object referred by this node can be read from or not.
 	 *
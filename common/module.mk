@@ -26,6 +26,7 @@ MODULE_OBJS := \
 	osd_message_queue.o \
 	path.o \
 	platform.o \
+	prefetch.o \
 	punycode.o \
 	random.o \
 	rational.o \
@@ -38,8 +39,10 @@ MODULE_OBJS := \
 	str-enc.o \
 	encodings/singlebyte.o \
 	system.o \
+	taskpool.o \
 	textconsole.o \
 	text-to-speech.o \
+	thread.o \
 	tokenizer.o \
 	translation.o \
 	unicode-bidi.o \
@@ -0,0 +1,356 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/prefetch.h"
+#include "common/memstream.h"
+#include "common/util.h"
+
+namespace Common {
+DECLARE_SINGLETON(PrefetchManager);
+
+PrefetchRequest::PrefetchRequest(const Archive *owner) : _owner(owner), _numWaiting(0) {
+}
+
+PrefetchRequest::~PrefetchRequest() {
+	_cancelled.store(1);
+	_tasks.wait();
+
+	for (uint i = 0; i < _members.size(); i++)
+		freeMember(_members[i]);
+}
+
+void PrefetchRequest::addMember(const Path &path, const ArchiveMemberPtr &member) {
+	_members.push_back(Member());
+
+	Member &entry = _members.back();
+	entry.path = path;
+	entry.member = member;
+}
+
+void PrefetchRequest::freeMember(Member &member) {
+	delete member.source;
+	delete member.result;
+	free(member.data);
+	member.source = nullptr;
+	member.result = nullptr;
+	member.data = nullptr;
+	member.member.reset();
+}
+
+int PrefetchRequest::findMember(const Path &path) const {
+	for (uint i = 0; i < _members.size(); i++) {
+		if (_members[i].path.equalsIgnoreCase(path))
+			return i;
+	}
+	return -1;
+}
+
+bool PrefetchRequest::claimMember(int index) {
+	while (_members[index].busy) {
+		_numWaiting++;
+		_mutex.unlock();
+		_released.wait();
+		_mutex.lock();
+	}
+
+	Member &member = _members[index];
+	if (member.taken)
+		return false;
+
+	member.busy = true;
+	return true;
+}
+
+void PrefetchRequest::releaseMember(int index) {
+	_members[index].busy = false;
+
+	for (; _numWaiting > 0; _numWaiting--)
+		_released.post();
+}
+
+void PrefetchRequest::loadMember(Member &member) {
+	if (member.done || !member.member->supportsBackgroundRead())
+		return;
+
+	if (!member.source && !member.data) {
+		member.source = member.member->createReadStream();
+		if (!member.source)
+			return;
+
+		// Streams which are in memory already, such as mapped files, are
+		// handed out as they are. Copying them would gain nothing.
+		if (dynamic_cast<MemoryReadStream *>(member.source)) {
+			member.result = member.source;
+			member.source = nullptr;
+			member.done = true;
+			return;
+		}
+
+		const int64 size = member.source->size();
+		if (size >= 0 && size <= 0x7FFFFFFF) {
+			member.size = size;
+			member.data = (byte *)malloc(MAX<uint32>(member.size, 1));
+		}
+	}
+
+	if (!member.source)
+		return;
+
+	while (member.pos < member.size) {
+		if (_cancelled.load())
+			return;
+
+		const uint32 toRead = MIN(PrefetchManager::kChunkSize, member.size - member.pos);
+		if (!member.data || member.source->read(member.data + member.pos, toRead) != toRead)
+			break;
+		member.pos += toRead;
+	}
+
+	if (member.data && member.pos == member.size) {
+		member.result = new MemoryReadStream(member.data, member.size, DisposeAfterUse::YES);
+		member.done = true;
+	} else {
+		// Leave it to finishMember() to open the member again
+		free(member.data);
+	}
+
+	member.data = nullptr;
+	delete member.source;
+	member.source = nullptr;
+}
+
+void PrefetchRequest::finishMember(Member &member) {
+	loadMember(member);
+
+	if (!member.done) {
+		member.result = member.member->createReadStream();
+		member.done = true;
+	}
+}
+
+void PrefetchRequest::startLoading() {
+	// Without worker threads, the tasks would run right here, so the members
+	// are rather loaded when they are taken
+	if (TaskPoolMan.getNumWorkers() == 0)
+		return;
+
+	for (uint i = 0; i < _members.size(); i++) {
+		if (_members[i].member->supportsBackgroundRead())
+			_tasks.run([this, i]() { loadInBackground(i); });
+	}
+}
+
+void PrefetchRequest::loadInBackground(int index) {
+	_mutex.lock();
+	Member &member = _members[index];
+	const bool claimed = !_cancelled.load() && !member.busy && !member.done && !member.taken;
+	if (claimed)
+		member.busy = true;
+	_mutex.unlock();
+
+	if (!claimed)
+		return;
+
+	loadMember(member);
+
+	_mutex.lock();
+	releaseMember(index);
+	_mutex.unlock();
+}
+
+uint PrefetchRequest::getNumMembers() const {
+	return _members.size();
+}
+
+bool PrefetchRequest::isReady(const Path &path) const {
+	StackLock lock(_mutex);
+
+	const int index = findMember(path);
+	return index >= 0 && _members[index].done && !_members[index].taken;
+}
+
+bool PrefetchRequest::isDone() const {
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _members.size(); i++) {
+		if (!_members[i].done && !_members[i].taken)
+			return false;
+	}
+	return true;
+}
+
+bool PrefetchRequest::isFinished() const {
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _members.size(); i++) {
+		if (!_members[i].taken)
+			return false;
+	}
+	return true;
+}
+
+void PrefetchRequest::wait() {
+	_mutex.lock();
+
+	for (uint i = 0; i < _members.size(); i++) {
+		if (_members[i].done || !claimMember(i))
+			continue;
+
+		_mutex.unlock();
+		finishMember(_members[i]);
+		_mutex.lock();
+
+		releaseMember(i);
+	}
+
+	_mutex.unlock();
+}
+
+void PrefetchRequest::cancel() {
+	_cancelled.store(1);
+
+	_mutex.lock();
+
+	for (uint i = 0; i < _members.size(); i++) {
+		if (!claimMember(i))
+			continue;
+
+		freeMember(_members[i]);
+		_members[i].taken = true;
+		releaseMember(i);
+	}
+
+	_mutex.unlock();
+}
+
+SeekableReadStream *PrefetchRequest::takeStream(const Path &path) {
+	_mutex.lock();
+
+	const int index = findMember(path);
+	if (index < 0 || !claimMember(index)) {
+		_mutex.unlock();
+		return nullptr;
+	}
+
+	Member &member = _members[index];
+
+	_mutex.unlock();
+	finishMember(member);
+	_mutex.lock();
+
+	SeekableReadStream *stream = member.result;
+	member.result = nullptr;
+	member.member.reset();
+	member.taken = true;
+	releaseMember(index);
+
+	_mutex.unlock();
+	return stream;
+}
+
+PrefetchManager::PrefetchManager() {
+}
+
+void PrefetchManager::addRequest(const PrefetchRequestPtr &request) {
+	{
+		StackLock lock(_mutex);
+		if (!request->isFinished())
+			_requests.push_back(request);
+	}
+
+	request->startLoading();
+}
+
+void PrefetchManager::removeFinishedRequests() {
+	for (uint i = 0; i < _requests.size();) {
+		if (_requests[i]->isFinished())
+			_requests.remove_at(i);
+		else
+			i++;
+	}
+}
+
+SeekableReadStream *PrefetchManager::takeStream(const Archive *owner, const Path &path) {
+	Array<PrefetchRequestPtr> requests;
+	{
+		StackLock lock(_mutex);
+		removeFinishedRequests();
+
+		for (uint i = 0; i < _requests.size(); i++) {
+			if (_requests[i]->_owner == owner)
+				requests.push_back(_requests[i]);
+		}
+	}
+
+	for (uint i = 0; i < requests.size(); i++) {
+		SeekableReadStream *stream = requests[i]->takeStream(path);
+		if (stream)
+			return stream;
+	}
+
+	return nullptr;
+}
+
+void PrefetchManager::clear() {
+	Array<PrefetchRequestPtr> requests;
+	{
+		StackLock lock(_mutex);
+		requests = _requests;
+		_requests.clear();
+	}
+
+	for (uint i = 0; i < requests.size(); i++)
+		requests[i]->cancel();
+}
+
+void PrefetchManager::removeRequests(const Archive *owner) {
+	// Requests are found by the address of their archive, which a new
+	// archive may get once this one is gone
+	Array<PrefetchRequestPtr> requests;
+	{
+		StackLock lock(_mutex);
+
+		for (uint i = 0; i < _requests.size();) {
+			if (_requests[i]->_owner == owner) {
+				requests.push_back(_requests[i]);
+				_requests.remove_at(i);
+			} else {
+				i++;
+			}
+		}
+	}
+
+	for (uint i = 0; i < requests.size(); i++)
+		requests[i]->cancel();
+}
+
+uint PrefetchManager::getNumRequests() const {
+	StackLock lock(_mutex);
+
+	uint numRequests = 0;
+	for (uint i = 0; i < _requests.size(); i++) {
+		if (!_requests[i]->isFinished())
+			numRequests++;
+	}
+	return numRequests;
+}
+
+} // End of namespace Common
@@ -0,0 +1,218 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PREFETCH_H
+#define COMMON_PREFETCH_H
+
+#include "common/archive.h"
+#include "common/array.h"
+#include "common/atomic.h"
+#include "common/mutex.h"
+#include "common/path.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/taskpool.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_prefetch Prefetching
+ * @ingroup common
+ *
+ * @brief Loading archive members into memory ahead of their use.
+ * @{
+ */
+
+class PrefetchManager;
+class SeekableReadStream;
+
+/**
+ * A set of archive members being loaded into memory, as returned by
+ * Archive::prefetch().
+ *
+ * The members are opened and loaded on the task pool. Taking the stream of
+ * a member which is not loaded yet finishes loading it on the calling
+ * thread, or waits for the worker loading it.
+ *
+ * A request must not outlive the archive it was made for. Destroying the
+ * archive cancels the requests made for it.
+ */
+class PrefetchRequest {
+public:
+	~PrefetchRequest();
+
+	/** Return the number of members in the request. */
+	uint getNumMembers() const;
+
+	/** Return whether the member with the given @p path is loaded and has not been taken yet. */
+	bool isReady(const Path &path) const;
+
+	/** Return whether all members are loaded or taken. */
+	bool isDone() const;
+
+	/** Finish loading all members on the calling thread. */
+	void wait();
+
+	/**
+	 * Stop loading the members and free the loaded ones. Streams taken
+	 * before stay valid.
+	 */
+	void cancel();
+
+	/**
+	 * Return a stream reading the member with the given @p path, finishing
+	 * loading it if needed. Each member can only be taken once.
+	 *
+	 * @return The newly created stream, or nullptr if the member is not part
+	 *         of the request or has been taken already.
+	 */
+	SeekableReadStream *takeStream(const Path &path);
+
+private:
+	friend class Archive;
+	friend class PrefetchManager;
+
+	struct Member {
+		Member() : data(nullptr), size(0), pos(0), source(nullptr), result(nullptr), busy(false), done(false), taken(false) {}
+
+		Path path;
+		ArchiveMemberPtr member;
+
+		/** The data read so far from @ref source. */
+		byte *data;
+		uint32 size;
+		uint32 pos;
+
+		/** Stream read on the task pool, only opened for members which support it. */
+		SeekableReadStream *source;
+		/** Stream handed out by takeStream(), once the member is loaded. */
+		SeekableReadStream *result;
+
+		/** Whether a thread is loading the member outside the lock. */
+		bool busy;
+		bool done;
+		bool taken;
+	};
+
+	PrefetchRequest(const Archive *owner);
+
+	void addMember(const Path &path, const ArchiveMemberPtr &member);
+
+	/** Find the member with the given path, which must be called with the lock held. */
+	int findMember(const Path &path) const;
+
+	/**
+	 * Claim the given member for loading, waiting until no other thread
+	 * loads it. Must be called with the lock held.
+	 */
+	bool claimMember(int index);
+
+	/** Give up a claimed member, waking up the threads waiting for it. Must be called with the lock held. */
+	void releaseMember(int index);
+
+	/** Read a claimed member in background, in chunks of PrefetchManager::kChunkSize bytes. */
+	void loadMember(Member &member);
+
+	/** Read the rest of a claimed member, or open it if it cannot be read in the background. */
+	void finishMember(Member &member);
+
+	/** Return whether all members have been taken or cancelled. */
+	bool isFinished() const;
+
+	/** Start loading the members which support it on the task pool. */
+	void startLoading();
+
+	/** Load the given member on a task pool thread, unless it has been claimed already. */
+	void loadInBackground(int index);
+
+	static void freeMember(Member &member);
+
+	const Archive *_owner;
+	Array<Member> _members;
+	mutable Mutex _mutex;
+
+	/** Set to stop the loading tasks early. */
+	Atomic<uint32> _cancelled;
+
+	/** Posted once for each waiting thread when a member is released. */
+	Semaphore _released;
+	uint32 _numWaiting;
+
+	/** The loading tasks, waited for before freeing the members. */
+	TaskGroup _tasks;
+};
+
+/**
+ * Keeps track of the prefetch requests, so that SearchSet can hand out
+ * their members.
+ *
+ * The members are loaded by the worker threads of the task pool. Without
+ * worker threads, they are only loaded once they are requested.
+ *
+ * Loaded members which are not taken are kept until the request is
+ * cancelled, until the archive it was made for is destroyed, or until the
+ * engine exits.
+ */
+class PrefetchManager : public Singleton<PrefetchManager> {
+public:
+	/** How much data a loading task reads at once, before checking whether it has been cancelled. */
+	static const uint32 kChunkSize = 256 * 1024;
+
+	/**
+	 * Take the stream of a prefetched member from the requests made for the
+	 * given archive.
+	 *
+	 * @return The stream, or nullptr if no request holds the member.
+	 */
+	SeekableReadStream *takeStream(const Archive *owner, const Path &path);
+
+	/** Cancel all requests. */
+	void clear();
+
+	/** Cancel the requests made for @p owner, which is being destroyed. */
+	void removeRequests(const Archive *owner);
+
+	/** Return the number of requests with members not taken yet. */
+	uint getNumRequests() const;
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	friend class Archive;
+	PrefetchManager();
+
+	void addRequest(const PrefetchRequestPtr &request);
+
+	/** Drop the requests which have no members left to take. */
+	void removeFinishedRequests();
+
+	Array<PrefetchRequestPtr> _requests;
+	mutable Mutex _mutex;
+};
+
+/** Shortcut for accessing the prefetch manager. */
+#define PrefetchMan		Common::PrefetchManager::instance()
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -33,13 +33,14 @@
 
 #include "common/std/chrono.h"
 #include "common/textconsole.h"
+#include "common/thread.h"
 
 namespace Std {
 
 class this_thread {
 public:
 static void yield() {
-	warning("TODO: this_thread::yield");
+	Common::Thread::yield();
 }
 
 static void sleep_for(uint32 milli) {
@@ -223,6 +223,14 @@ bool OSystem::setRotationMode(int rotation) {
 	return setRotationMode(Common::parseRotationMode(rotation));
 }
 
+void OSystem::copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count) {
+	const int bytesPerPixel = getScreenFormat().bytesPerPixel;
+	for (uint i = 0; i < count; i++) {
+		const Common::Rect &r = rects[i];
+		copyRectToScreen((const byte *)buf + r.top * pitch + r.left * bytesPerPixel, pitch, r.left, r.top, r.width(), r.height());
+	}
+}
+
 Common::Rect OSystem::getSafeOverlayArea(int16 *width, int16 *height) const {
 	int16 w = getOverlayWidth(),
 		  h = getOverlayHeight();
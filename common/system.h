@@ -55,6 +55,8 @@ class Store;
 namespace Common {
 class EventManager;
 class MutexInternal;
+class SemaphoreInternal;
+class ThreadInternal;
 struct Rect;
 class SaveFileManager;
 class SearchSet;
@@ -1248,6 +1250,22 @@ public:
 	 */
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 
+	/**
+	 * Blit several areas of a bitmap to the virtual screen.
+	 *
+	 * This is the same as calling copyRectToScreen() for each area, but
+	 * lets backends prepare the screen only once for all of them.
+	 *
+	 * @param buf    Buffer containing the graphics data of the whole screen.
+	 * @param pitch  Pitch of the buffer (number of bytes in a scanline).
+	 * @param rects  The areas to copy, at the same position in the buffer
+	 *               and on the screen.
+	 * @param count  The number of areas.
+	 *
+	 * @see copyRectToScreen
+	 */
+	virtual void copyRectsToScreen(const void *buf, int pitch, const Common::Rect *rects, uint count);
+
 	/**
 	 * Lock the active screen framebuffer and return a Graphics::Surface
 	 * representing it.
@@ -1562,6 +1580,16 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a timestamp in microseconds, for measuring how long short
+	 * operations take.
+	 *
+	 * Only the difference between two values is meaningful. The value is
+	 * never recorded by the event recorder, and backends without a high
+	 * resolution timer return getMillis() in microseconds.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1650,6 +1678,56 @@ public:
 	/** @} */
 
 
+	/**
+	 * @defgroup common_system_thread Threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Backends which can run code on several cores may implement these
+	 * methods, so that the task pool (see common/taskpool.h) can spread work
+	 * across them. The default implementations report that threads are not
+	 * supported, and the task pool then runs all work on the calling thread.
+	 *
+	 * Backends implementing threads must also implement createMutex() with
+	 * real mutexes.
+	 */
+
+	/**
+	 * Create a new thread, running @p proc with @p data until it returns.
+	 * Deleting the returned object waits for the thread to return.
+	 *
+	 * @param name	Name of the thread, for debugging.
+	 * @return The newly created thread, or nullptr if threads are not supported.
+	 */
+	virtual Common::ThreadInternal *createThread(void (*proc)(void *data), void *data, const char *name) { return nullptr; }
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * @return The newly created semaphore, or nullptr if threads are not supported.
+	 */
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialCount) { return nullptr; }
+
+	/**
+	 * Return the number of threads which can run at the same time, or 1 if
+	 * threads are not supported.
+	 */
+	virtual uint getNumCPUs() { return 1; }
+
+	/**
+	 * Let other threads run before the calling one continues.
+	 */
+	virtual void yieldThread() {}
+
+	/**
+	 * Return a value identifying the calling thread among all running
+	 * threads, or 0 if threads are not supported.
+	 */
+	virtual uintptr getThreadId() { return 0; }
+
+	/** @} */
+
+
 
 	/** @defgroup common_system_sound Sound
 	 *  @ingroup common_system
@@ -0,0 +1,216 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/taskpool.h"
+#include "common/config-manager.h"
+#include "common/system.h"
+#include "common/util.h"
+
+namespace Common {
+DECLARE_SINGLETON(TaskPool);
+
+TaskGroup::TaskGroup() : _pending(0), _numWaiting(0) {
+}
+
+TaskGroup::~TaskGroup() {
+	wait();
+}
+
+void TaskGroup::add(Task *task) {
+	task->_group = this;
+
+	_mutex.lock();
+	_pending++;
+	_mutex.unlock();
+
+	TaskPoolMan.addTask(task);
+}
+
+void TaskGroup::taskDone() {
+	StackLock lock(_mutex);
+
+	if (--_pending > 0)
+		return;
+
+	for (; _numWaiting > 0; _numWaiting--)
+		_done.post();
+}
+
+bool TaskGroup::isDone() const {
+	StackLock lock(_mutex);
+	return _pending == 0;
+}
+
+void TaskGroup::wait() {
+	while (!isDone()) {
+		// Help with the work of this group instead of sleeping
+		if (TaskPoolMan.runPendingTask(this))
+			continue;
+
+		// The remaining tasks are running on the workers
+		_mutex.lock();
+		if (_pending == 0) {
+			_mutex.unlock();
+			break;
+		}
+		_numWaiting++;
+		_mutex.unlock();
+
+		_done.wait();
+	}
+}
+
+
+#pragma mark -
+
+
+TaskPool::TaskPool() : _nextWorker(0), _quit(0) {
+	// The thread waiting for a group runs tasks as well
+	int numWorkers = g_system->getNumCPUs() - 1;
+	if (ConfMan.hasKey("worker_threads"))
+		numWorkers = ConfMan.getInt("worker_threads");
+	numWorkers = CLIP<int>(numWorkers, 0, kMaxWorkers);
+
+	for (int i = 0; i < numWorkers; i++)
+		_workers.push_back(new Worker(this, i));
+
+	bool failed = false;
+	for (uint i = 0; i < _workers.size() && !failed; i++) {
+		_workers[i]->thread = new Thread(workerProc, _workers[i], "TaskPool");
+		failed = !_workers[i]->thread->isRunning();
+	}
+
+	// Run the tasks on the calling thread if the backend has no threads
+	if (failed) {
+		_quit.store(1);
+		for (uint i = 0; i < _workers.size(); i++)
+			_work.post();
+
+		for (uint i = 0; i < _workers.size(); i++) {
+			delete _workers[i]->thread;
+			delete _workers[i];
+		}
+		_workers.clear();
+	}
+}
+
+TaskPool::~TaskPool() {
+	_quit.store(1);
+	for (uint i = 0; i < _workers.size(); i++)
+		_work.post();
+
+	for (uint i = 0; i < _workers.size(); i++)
+		delete _workers[i]->thread;
+
+	while (runPendingTask()) {
+	}
+
+	for (uint i = 0; i < _workers.size(); i++)
+		delete _workers[i];
+}
+
+void TaskPool::addTask(Task *task) {
+	if (_workers.empty()) {
+		runTask(task);
+		return;
+	}
+
+	Worker *worker = _workers[_nextWorker.fetchAdd(1) % _workers.size()];
+
+	worker->mutex.lock();
+	worker->queue.push_back(task);
+	worker->mutex.unlock();
+
+	_work.post();
+}
+
+Task *TaskPool::takeTask(uint first, bool own, TaskGroup *group) {
+	for (uint i = 0; i < _workers.size(); i++) {
+		Worker *worker = _workers[(first + i) % _workers.size()];
+		StackLock lock(worker->mutex);
+
+		if (worker->queue.empty())
+			continue;
+
+		if (group) {
+			for (List<Task *>::iterator it = worker->queue.begin(); it != worker->queue.end(); ++it) {
+				if ((*it)->_group == group) {
+					Task *task = *it;
+					worker->queue.erase(it);
+					return task;
+				}
+			}
+			continue;
+		}
+
+		Task *task;
+		if (i == 0 && own) {
+			task = worker->queue.back();
+			worker->queue.pop_back();
+		} else {
+			task = worker->queue.front();
+			worker->queue.pop_front();
+		}
+		return task;
+	}
+
+	return nullptr;
+}
+
+void TaskPool::runTask(Task *task) {
+	TaskGroup *group = task->_group;
+
+	task->run();
+	delete task;
+
+	// The group may be gone as soon as it is told about the task
+	group->taskDone();
+}
+
+bool TaskPool::runPendingTask(TaskGroup *group) {
+	if (_workers.empty())
+		return false;
+
+	Task *task = takeTask(_nextWorker.load() % _workers.size(), false, group);
+	if (!task)
+		return false;
+
+	runTask(task);
+	return true;
+}
+
+void TaskPool::workerProc(void *data) {
+	Worker *worker = (Worker *)data;
+	TaskPool *pool = worker->pool;
+
+	// There is one post per task added, so no task is left behind
+	for (;;) {
+		pool->_work.wait();
+		if (pool->_quit.load())
+			break;
+
+		Task *task = pool->takeTask(worker->index, true);
+		if (task)
+			runTask(task);
+	}
+}
+
+} // End of namespace Common
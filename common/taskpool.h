@@ -0,0 +1,261 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_TASKPOOL_H
+#define COMMON_TASKPOOL_H
+
+#include "common/array.h"
+#include "common/atomic.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/ptr.h"
+#include "common/singleton.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_taskpool Task pool
+ * @ingroup common
+ *
+ * @brief Running work on all cores of the host.
+ *
+ * Work is split into tasks, which are added to a TaskGroup and run by the
+ * worker threads of the TaskPool. For example, decoding the planes of a
+ * video frame in parallel:
+ *
+ * @code
+ * Common::TaskGroup group;
+ * for (int i = 0; i < 3; i++)
+ *     group.run([this, i]() { decodePlane(i); });
+ * group.wait();
+ * @endcode
+ *
+ * Without thread support in the backend, or with the "worker_threads"
+ * setting at 0, tasks run on the calling thread when they are added. Code
+ * using tasks therefore works the same on all ports, only slower.
+ * @{
+ */
+
+class TaskGroup;
+class TaskPool;
+
+/**
+ * A unit of work for the task pool.
+ */
+class Task {
+public:
+	Task() : _group(nullptr) {}
+	virtual ~Task() {}
+
+	virtual void run() = 0;
+
+private:
+	friend class TaskGroup;
+	friend class TaskPool;
+	TaskGroup *_group;
+};
+
+/**
+ * A task calling a function object, such as a lambda.
+ */
+template<class F>
+class FunctionTask : public Task {
+public:
+	FunctionTask(const F &func) : _func(func) {}
+
+	void run() override { _func(); }
+
+private:
+	F _func;
+};
+
+/**
+ * A set of tasks which can be waited for together.
+ *
+ * Tasks may add more tasks, and wait for them, from the worker threads.
+ */
+class TaskGroup : NonCopyable {
+public:
+	TaskGroup();
+
+	/** Wait for the remaining tasks. */
+	~TaskGroup();
+
+	/** Add a task, which is deleted once it has run. */
+	void add(Task *task);
+
+	/** Add a task calling @p func. */
+	template<class F>
+	void run(const F &func) {
+		add(new FunctionTask<F>(func));
+	}
+
+	/**
+	 * Wait until all tasks of the group have run. The calling thread runs
+	 * pending tasks of the group meanwhile, but never tasks of other groups,
+	 * which may take much longer or wait for locks held by the caller.
+	 */
+	void wait();
+
+	/** Return whether all tasks of the group have run. */
+	bool isDone() const;
+
+private:
+	friend class TaskPool;
+
+	void taskDone();
+
+	uint32 _pending;
+	uint32 _numWaiting;
+	mutable Mutex _mutex;
+	Semaphore _done;
+};
+
+/**
+ * The result of a function run by the task pool, see async().
+ */
+template<class T>
+class Future {
+public:
+	Future() {}
+
+	/** Return whether the future refers to a function. */
+	bool isValid() const { return _state != nullptr; }
+
+	/** Return whether the function has returned. */
+	bool isReady() const { return _state->group.isDone(); }
+
+	/** Wait for the function to return, and return its result. */
+	T &get() {
+		_state->group.wait();
+		return _state->value;
+	}
+
+	/** Run @p func on the task pool, see async(). */
+	template<class F>
+	static Future run(const F &func) {
+		Future future;
+		future._state.reset(new State());
+		future._state->group.add(new ResultTask<F>(future._state.get(), func));
+		return future;
+	}
+
+private:
+	struct State {
+		TaskGroup group;
+		T value;
+	};
+
+	template<class F>
+	class ResultTask : public Task {
+	public:
+		ResultTask(State *state, const F &func) : _state(state), _func(func) {}
+
+		void run() override { _state->value = _func(); }
+
+	private:
+		// The future waits for the task before freeing the state
+		State *_state;
+		F _func;
+	};
+
+	SharedPtr<State> _state;
+};
+
+/**
+ * Run @p func on the task pool.
+ *
+ * @return A future holding the result of @p func.
+ */
+template<class F>
+auto async(const F &func) -> Future<decltype(func())> {
+	return Future<decltype(func())>::run(func);
+}
+
+/**
+ * The worker threads running the tasks.
+ *
+ * Each worker has its own queue. Tasks are spread over the queues when
+ * they are added, and a worker whose queue is empty steals tasks from the
+ * other ones.
+ */
+class TaskPool : public Singleton<TaskPool> {
+public:
+	/** The most worker threads started, whatever the number of cores. */
+	static const uint kMaxWorkers = 16;
+
+	/** Return the number of worker threads, 0 if tasks run on the calling thread. */
+	uint getNumWorkers() const { return _workers.size(); }
+
+	/**
+	 * Run one pending task on the calling thread.
+	 *
+	 * @param group	Only run a task of this group, unless it is nullptr.
+	 * @return Whether there was a task to run.
+	 */
+	bool runPendingTask(TaskGroup *group = nullptr);
+
+private:
+	friend class Singleton<SingletonBaseType>;
+	friend class TaskGroup;
+
+	TaskPool();
+	~TaskPool();
+
+	struct Worker {
+		Worker(TaskPool *pool_, uint index_) : pool(pool_), index(index_), thread(nullptr) {}
+
+		TaskPool *pool;
+		uint index;
+		Thread *thread;
+		Mutex mutex;
+		List<Task *> queue;
+	};
+
+	void addTask(Task *task);
+
+	/**
+	 * Take a task from the queues, starting with the one of the worker
+	 * @p first. Workers take the newest task of their own queue, and the
+	 * oldest one of the others. If @p group is set, only the oldest task
+	 * of that group is taken.
+	 */
+	Task *takeTask(uint first, bool own, TaskGroup *group = nullptr);
+	static void runTask(Task *task);
+
+	static void workerProc(void *data);
+
+	Array<Worker *> _workers;
+	Atomic<uint32> _nextWorker;
+	Atomic<uint32> _quit;
+	Semaphore _work;
+};
+
+/** Shortcut for accessing the task pool. */
+#define TaskPoolMan		Common::TaskPool::instance()
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/thread.h"
+#include "common/system.h"
+
+namespace Common {
+
+Thread::Thread(ThreadProc proc, void *data, const char *name) {
+	assert(g_system);
+	_thread = g_system->createThread(proc, data, name);
+}
+
+Thread::~Thread() {
+	delete _thread;
+}
+
+void Thread::yield() {
+	g_system->yieldThread();
+}
+
+uintptr Thread::getCurrentId() {
+	return g_system->getThreadId();
+}
+
+
+#pragma mark -
+
+
+Semaphore::Semaphore(uint initialCount) {
+	assert(g_system);
+	_semaphore = g_system->createSemaphore(initialCount);
+}
+
+Semaphore::~Semaphore() {
+	delete _semaphore;
+}
+
+void Semaphore::post() {
+	if (_semaphore)
+		_semaphore->post();
+}
+
+void Semaphore::wait() {
+	if (_semaphore)
+		_semaphore->wait();
+}
+
+} // End of namespace Common
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_thread Threads
+ * @ingroup common
+ *
+ * @brief API for running code on other threads.
+ *
+ * Most code should not create threads itself, but run its work on the
+ * task pool instead (see common/taskpool.h).
+ * @{
+ */
+
+/** The function run by a thread. */
+typedef void (*ThreadProc)(void *data);
+
+class ThreadInternal {
+public:
+	/** Wait for the thread to return. */
+	virtual ~ThreadInternal() {}
+};
+
+class SemaphoreInternal {
+public:
+	virtual ~SemaphoreInternal() {}
+
+	/** Increment the count, waking up one waiting thread. */
+	virtual void post() = 0;
+
+	/** Wait until the count is positive, and decrement it. */
+	virtual void wait() = 0;
+};
+
+/**
+ * Wrapper class around the OSystem thread functions.
+ *
+ * Backends without thread support do not start the thread, which can be
+ * checked with isRunning(). Callers must then do the work themselves.
+ */
+class Thread : NonCopyable {
+	ThreadInternal *_thread;
+
+public:
+	/**
+	 * Start a thread running @p proc with @p data.
+	 *
+	 * @param name	Name of the thread, for debugging.
+	 */
+	Thread(ThreadProc proc, void *data, const char *name);
+
+	/** Wait for the thread to return. */
+	~Thread();
+
+	/** Return whether the thread was started. */
+	bool isRunning() const { return _thread != nullptr; }
+
+	/** Let other threads run before the calling one continues. */
+	static void yield();
+
+	/** Return a value identifying the calling thread, see OSystem::getThreadId(). */
+	static uintptr getCurrentId();
+};
+
+/**
+ * Wrapper class around the OSystem semaphore functions.
+ *
+ * Without thread support, posting and waiting do nothing.
+ */
+class Semaphore : NonCopyable {
+	SemaphoreInternal *_semaphore;
+
+public:
+	explicit Semaphore(uint initialCount = 0);
+	~Semaphore();
+
+	void post();
+	void wait();
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -77,6 +77,8 @@ Common::Error DarkseedEngine::run() {
 		return Common::kAudioDeviceInitFailed;
 	}
 	_screen = new Graphics::Screen();
+	// Sprites, text and the console each mark small areas every frame
+	_screen->setDirtyTileSize(16);
 	_tosText = new TosText();
 	_tosText->load();
 	_objectVar.loadObjectNames();
@@ -61,6 +61,9 @@ protected:
 	void init();
 	void close() override;
 	const Graphics::Surface *decodeNextFrame() override;
+	// handleFrame() decodes the tracks and changes the engine state from
+	// decodeNextFrame()
+	bool supportsDecodeAhead() const override { return false; }
 	class SmushVideoTrack : public FixedRateVideoTrack {
 	public:
 		SmushVideoTrack(int width, int height, int fps, int numFrames, bool is16Bit);
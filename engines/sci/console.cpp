@@ -115,6 +115,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("resource_id",		WRAP_METHOD(Console, cmdResourceId));
 	registerCmd("resource_info",		WRAP_METHOD(Console, cmdResourceInfo));
 	registerCmd("resource_types",		WRAP_METHOD(Console, cmdResourceTypes));
+	registerCmd("resource_cache",		WRAP_METHOD(Console, cmdResourceCache));
 	registerCmd("list",				WRAP_METHOD(Console, cmdList));
 	registerCmd("alloc_list",				WRAP_METHOD(Console, cmdAllocList));
 	registerCmd("hexgrep",			WRAP_METHOD(Console, cmdHexgrep));
@@ -150,6 +151,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
+	registerCmd("draw_bands",         WRAP_METHOD(Console, cmdDrawBands));
 	// Segments
 	registerCmd("segment_table",		WRAP_METHOD(Console, cmdPrintSegmentTable));
 	registerCmd("segtable",			WRAP_METHOD(Console, cmdPrintSegmentTable));	// alias
@@ -233,6 +235,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("bpe",				WRAP_METHOD(Console, cmdBreakpointFunction));		// alias
 	// VM
 	registerCmd("script_steps",		WRAP_METHOD(Console, cmdScriptSteps));
+	registerCmd("vm_profile",		WRAP_METHOD(Console, cmdVMProfile));
 	registerCmd("script_objects",   WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("scro",             WRAP_METHOD(Console, cmdScriptObjects));
 	registerCmd("script_strings",   WRAP_METHOD(Console, cmdScriptStrings));
@@ -267,6 +270,8 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	_debugState.breakpointWasHit = false;
 	_debugState._breakpoints.clear(); // No breakpoints defined
 	_debugState._activeBreakpointTypes = 0;
+	_debugState.profilingOpcodes = false;
+	_debugState.resetOpcodeCounts();
 }
 
 Console::~Console() {
@@ -355,6 +360,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" resource_id - Identifies a resource number by splitting it up in resource type and resource number\n");
 	debugPrintf(" resource_info - Shows info about a resource\n");
 	debugPrintf(" resource_types - Shows the valid resource types\n");
+	debugPrintf(" resource_cache - Shows or changes the size and pinned types of the resource cache\n");
 	debugPrintf(" list - Lists all the resources of a given type\n");
 	debugPrintf(" alloc_list - Lists all allocated resources\n");
 	debugPrintf(" hexgrep - Searches some resources for a particular sequence of bytes, represented as hexadecimal numbers\n");
@@ -386,6 +392,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
+	debugPrintf(" draw_bands - Enables/disables drawing screen items with several threads, and shows frame times (SCI2+)\n");
 	debugPrintf("\n");
 	debugPrintf("Segments:\n");
 	debugPrintf(" segment_table / segtable - Lists all segments\n");
@@ -447,6 +454,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("\n");
 	debugPrintf("VM:\n");
 	debugPrintf(" script_steps - Shows the number of executed SCI operations\n");
+	debugPrintf(" vm_profile - Counts the executed SCI operations by opcode\n");
 	debugPrintf(" script_objects / scro - Shows all objects inside a specified script\n");
 	debugPrintf(" script_strings / scrs - Shows all strings inside a specified script\n");
 	debugPrintf(" script_said - Shows all said - strings inside a specified script\n");
@@ -1201,6 +1209,54 @@ bool Console::cmdResourceTypes(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdResourceCache(int argc, const char **argv) {
+	ResourceManager *resMan = _engine->getResMan();
+
+	if (argc == 3 && !scumm_stricmp(argv[1], "size")) {
+		const int size = atoi(argv[2]);
+		if (size <= 0) {
+			debugPrintf("Invalid cache size '%s'\n", argv[2]);
+			return true;
+		}
+		resMan->setMaxMemoryLRU(size * 1024);
+	} else if (argc == 3 && (!scumm_stricmp(argv[1], "pin") || !scumm_stricmp(argv[1], "unpin"))) {
+		const ResourceType type = parseResourceType(argv[2]);
+		if (type == kResourceTypeInvalid) {
+			debugPrintf("Resource type '%s' is not valid\n", argv[2]);
+			return true;
+		}
+		resMan->setResourceTypePinned(type, !scumm_stricmp(argv[1], "pin"));
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		resMan->resetCacheStats();
+	} else if (argc != 1) {
+		debugPrintf("Shows or changes the size and pinned types of the resource cache\n");
+		debugPrintf("Usage: %s [size <KiB> | pin <resource type> | unpin <resource type> | reset]\n", argv[0]);
+		debugPrintf("Resources of a pinned type stay in memory once loaded. 'reset' clears the statistics.\n");
+		return true;
+	}
+
+	debugPrintf("Cache size: %d KiB, in use: %d KiB\n", resMan->getMaxMemoryLRU() / 1024, resMan->getMemoryLRU() / 1024);
+	debugPrintf("Locked: %d KiB, pinned: %d KiB\n", resMan->getMemoryLocked() / 1024, resMan->getMemoryPinned() / 1024);
+
+	debugPrintf("Pinned types:");
+	bool anyPinned = false;
+	for (int i = 0; i < kResourceTypeInvalid; i++) {
+		if (resMan->isResourceTypePinned((ResourceType)i)) {
+			debugPrintf(" %s", getResourceTypeName((ResourceType)i));
+			anyPinned = true;
+		}
+	}
+	debugPrintf(anyPinned ? "\n" : " none\n");
+
+	const uint32 hits = resMan->getCacheHits();
+	const uint32 misses = resMan->getCacheMisses();
+	const uint32 requests = hits + misses;
+	debugPrintf("Hits: %u, misses: %u (%u%% hit rate), evictions: %u\n",
+		hits, misses, requests ? (uint32)((uint64)hits * 100 / requests) : 0, resMan->getCacheEvictions());
+
+	return true;
+}
+
 bool Console::cmdHexgrep(int argc, const char **argv) {
 	if (argc < 4) {
 		debugPrintf("Searches some resources for a particular sequence of bytes, represented as decimal or hexadecimal numbers.\n");
@@ -2289,6 +2345,31 @@ bool Console::cmdSavedBits(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdDrawBands(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	if (!_engine->_gfxFrameout) {
+		debugPrintf("This SCI version does not draw screen items\n");
+		return true;
+	}
+
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "on") && strcmp(argv[1], "off"))) {
+		debugPrintf("Draws the screen items in bands of lines, using several threads\n");
+		debugPrintf("Usage: %s [on | off]\n", argv[0]);
+		debugPrintf("Without parameters, shows the time spent drawing each frame\n");
+		return true;
+	}
+
+	if (argc == 2) {
+		_engine->_gfxFrameout->setDrawInBands(!strcmp(argv[1], "on"));
+	}
+
+	_engine->_gfxFrameout->printDrawStats(this);
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdShowSavedBits(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Display saved bits.\n");
@@ -3436,6 +3517,51 @@ bool Console::cmdScriptSteps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::cmdVMProfile(int argc, const char **argv) {
+	if (argc == 2 && !scumm_stricmp(argv[1], "on")) {
+		_debugState.profilingOpcodes = true;
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "off")) {
+		_debugState.profilingOpcodes = false;
+	} else if (argc == 2 && !scumm_stricmp(argv[1], "reset")) {
+		_debugState.resetOpcodeCounts();
+	} else if (argc != 1) {
+		debugPrintf("Counts the executed SCI operations by opcode.\n");
+		debugPrintf("Usage: %s [on | off | reset]\n", argv[0]);
+		debugPrintf("Without parameters, shows the most executed opcodes.\n");
+		return true;
+	}
+
+	debugPrintf("Opcode profiling is %s\n", _debugState.profilingOpcodes ? "on" : "off");
+
+	uint64 total = 0;
+	Common::Array<uint> opcodes;
+	for (uint i = 0; i < ARRAYSIZE(_debugState.opcodeCounts); i++) {
+		total += _debugState.opcodeCounts[i];
+		if (_debugState.opcodeCounts[i])
+			opcodes.push_back(i);
+	}
+
+	if (!total)
+		return true;
+
+	Common::sort(opcodes.begin(), opcodes.end(), [this](uint a, uint b) {
+		return _debugState.opcodeCounts[a] > _debugState.opcodeCounts[b];
+	});
+
+	debugPrintf("%u operations\n", (uint)total);
+	for (uint i = 0; i < opcodes.size() && i < 20; i++) {
+		const uint opcode = opcodes[i];
+		const uint32 count = _debugState.opcodeCounts[opcode];
+#ifndef REDUCE_MEMORY_USAGE
+		debugPrintf(" %02x %-5s %10u  %5.2f%%\n", opcode, opcodeNames[opcode], count, count * 100.0 / total);
+#else
+		debugPrintf(" %02x %10u  %5.2f%%\n", opcode, count, count * 100.0 / total);
+#endif
+	}
+
+	return true;
+}
+
 bool Console::cmdScriptObjects(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("Shows all objects inside a specified script.\n");
@@ -89,8 +89,11 @@ struct DebugState {
 	StackPtr old_sp;
 	Common::List<Breakpoint> _breakpoints;   //< List of breakpoints
 	int _activeBreakpointTypes;  //< Bit mask specifying which types of breakpoints are active
+	bool profilingOpcodes;       //< Whether the executed opcodes are counted
+	uint32 opcodeCounts[128];    //< Number of executions of each opcode while profiling
 
 	void updateActiveBreakpointTypes();
+	void resetOpcodeCounts();
 };
 
 // Various global variables used for debugging are declared here
@@ -69,6 +69,10 @@ const char *opcodeNames[] = {
 };
 #endif	// REDUCE_MEMORY_USAGE
 
+void DebugState::resetOpcodeCounts() {
+	memset(opcodeCounts, 0, sizeof(opcodeCounts));
+}
+
 void DebugState::updateActiveBreakpointTypes() {
 	_activeBreakpointTypes = 0;
 	for (Common::List<Breakpoint>::iterator bp = _breakpoints.begin(); bp != _breakpoints.end(); ++bp) {
@@ -33,6 +33,7 @@
 #include "graphics/larryScale.h"
 #include "common/config-manager.h"
 #include "common/gui_options.h"
+#include "common/taskpool.h"
 
 namespace Sci {
 #pragma mark CelScaler
@@ -88,9 +89,13 @@ bool CelObj::_drawBlackLines = false;
 void CelObj::init() {
 	CelObj::deinit();
 	_drawBlackLines = false;
-	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+
+	int cacheSize = kCelCacheDefaultSize;
+	if (ConfMan.hasKey("cel_cache_size") && ConfMan.getInt("cel_cache_size") > 0) {
+		cacheSize = ConfMan.getInt("cel_cache_size") * 1024;
+	}
+	_cache = new CelCache(cacheSize);
 }
 
 void CelObj::deinit() {
@@ -100,6 +105,12 @@ void CelObj::deinit() {
 	_cache = nullptr;
 }
 
+void CelObj::collectPredecodedCels() {
+	if (_cache) {
+		_cache->collectPredecoded();
+	}
+}
+
 #pragma mark -
 #pragma mark CelObj - Scalers
 
@@ -168,8 +179,10 @@ struct SCALER_Scale {
 	// image and takes precedence over _reader.
 	Common::SharedPtr<Buffer> _sourceBuffer;
 	int16 _x;
-	static int16 _valuesX[kCelScalerTableSize];
-	static int16 _valuesY[kCelScalerTableSize];
+	// Not shared between scalers, so that cels can be drawn from several
+	// threads at once
+	int16 _valuesX[kCelScalerTableSize];
+	int16 _valuesY[kCelScalerTableSize];
 
 	SCALER_Scale(const CelObj &celObj, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio scaleX, const Ratio scaleY) :
 	_row(nullptr),
@@ -208,8 +221,6 @@ struct SCALER_Scale {
 		// games which use global scaling are the ones that use low-resolution
 		// script coordinates too.
 
-		const CelScalerTable &table = CelObj::_scaler->getScalerTable(scaleX, scaleY);
-
 		const bool useLarryScale = Common::checkGameGUIOption(GAMEOPTION_LARRYSCALE, ConfMan.get("guioptions")) && ConfMan.getBool("enable_larryscale");
 		if (useLarryScale) {
 			// LarryScale is an alternative, high-quality cel scaler implemented
@@ -261,6 +272,9 @@ struct SCALER_Scale {
 				_valuesY[y] = CLIP<int16>(unsafeValue, 0, scaledImageRect.height() - 1);
 			}
 		} else {
+			Common::StackLock lock(CelObj::_scaler->_mutex);
+			const CelScalerTable &table = CelObj::_scaler->getScalerTable(scaleX, scaleY);
+
 			const bool useGlobalScaling = g_sci->_gfxFrameout->getScriptWidth() == kLowResX;
 			if (useGlobalScaling) {
 				const int16 unscaledX = (scaledPosition.x / scaleX).toInt();
@@ -316,11 +330,6 @@ struct SCALER_Scale {
 	}
 };
 
-template<bool FLIP, typename READER>
-int16 SCALER_Scale<FLIP, READER>::_valuesX[kCelScalerTableSize];
-template<bool FLIP, typename READER>
-int16 SCALER_Scale<FLIP, READER>::_valuesY[kCelScalerTableSize];
-
 #pragma mark -
 #pragma mark CelObj - Resource readers
 
@@ -338,7 +347,7 @@ public:
 	_sourceHeight(celObj._height),
 #endif
 	_sourceWidth(celObj._width) {
-		const SciSpan<const byte> resource = celObj.getResPointer();
+		const SciSpan<const byte> resource = celObj.getDrawResPointer();
 		const uint32 pixelsOffset = resource.getUint32SEAt(celObj._celHeaderOffset + 24);
 		const int32 numPixels = MIN<int32>(resource.size() - pixelsOffset, celObj._width * celObj._height);
 
@@ -362,6 +371,10 @@ public:
 
 struct READER_Compressed {
 private:
+	// The pixels decompressed beforehand, if any, are used instead of the
+	// resource data
+	const byte *_pixels;
+	const int16 _sourceWidth;
 	const SciSpan<const byte> _resource;
 	byte _buffer[kCelScalerTableSize];
 	uint32 _controlOffset;
@@ -374,14 +387,35 @@ private:
 
 public:
 	READER_Compressed(const CelObj &celObj, const int16 maxWidth) :
-	_resource(celObj.getResPointer()),
+	_pixels(celObj._decodedPixels.get()),
+	_sourceWidth(celObj._width),
+	_resource(_pixels ? SciSpan<const byte>() : celObj.getDrawResPointer()),
 	_y(-1),
 	_sourceHeight(celObj._height),
 	_skipColor(celObj._skipColor),
 	_maxWidth(maxWidth) {
 		assert(maxWidth <= celObj._width);
 
-		const SciSpan<const byte> celHeader = _resource.subspan(celObj._celHeaderOffset);
+		if (!_pixels) {
+			readCelHeader(celObj._celHeaderOffset);
+		}
+	}
+
+	// Reads a whole cel from the given resource data, which can be done from
+	// any thread
+	READER_Compressed(const SciSpan<const byte> &resource, const uint32 celHeaderOffset, const int16 width, const int16 height, const uint8 skipColor) :
+	_pixels(nullptr),
+	_sourceWidth(width),
+	_resource(resource),
+	_y(-1),
+	_sourceHeight(height),
+	_skipColor(skipColor),
+	_maxWidth(width) {
+		readCelHeader(celHeaderOffset);
+	}
+
+	inline void readCelHeader(const uint32 celHeaderOffset) {
+		const SciSpan<const byte> celHeader = _resource.subspan(celHeaderOffset);
 		_dataOffset = celHeader.getUint32SEAt(24);
 		_uncompressedDataOffset = celHeader.getUint32SEAt(28);
 		_controlOffset = celHeader.getUint32SEAt(32);
@@ -389,6 +423,10 @@ public:
 
 	inline const byte *getRow(const int16 y) {
 		assert(y >= 0 && y < _sourceHeight);
+		if (_pixels) {
+			return _pixels + y * _sourceWidth;
+		}
+
 		if (y != _y) {
 			// compressed data segment for row
 			const uint32 rowOffset = _resource.getUint32SEAt(_controlOffset + y * sizeof(uint32));
@@ -525,10 +563,42 @@ struct MAPPER_NoMap {
 };
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
+	_drawBlackLines = screenItem._drawBlackLines;
+	drawPrepared(target, screenItem, targetRect);
+	_drawBlackLines = false;
+}
+
+void CelObj::prepareDraw(const bool mirrorX) {
+	_drawMirrored = mirrorX;
+
+	// A screen item can be drawn several times in the same frame
+	if (_drawResource.data()) {
+		return;
+	}
+
+	if (_info.type == kCelTypeView || _info.type == kCelTypePic) {
+		const ResourceType type = _info.type == kCelTypeView ? kResourceTypeView : kResourceTypePic;
+		_drawResourceLock = g_sci->getResMan()->findResource(ResourceId(type, _info.resourceId), true);
+	}
+
+	if (_info.type != kCelTypeColor) {
+		_drawResource = getResPointer();
+	}
+}
+
+void CelObj::finishDraw() {
+	_drawResource = SciSpan<const byte>();
+
+	if (_drawResourceLock) {
+		g_sci->getResMan()->unlockResource(_drawResourceLock);
+		_drawResourceLock = nullptr;
+	}
+}
+
+void CelObj::drawPrepared(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
 	const Common::Point &scaledPosition = screenItem._scaledPosition;
 	const Ratio &scaleX = screenItem._ratioX;
 	const Ratio &scaleY = screenItem._ratioY;
-	_drawBlackLines = screenItem._drawBlackLines;
 
 	if (_remap) {
 		// In SSCI, this check was `g_Remap_numActiveRemaps && _remap`, but
@@ -610,8 +680,6 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 			}
 		}
 	}
-
-	_drawBlackLines = false;
 }
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, bool mirrorX) {
@@ -698,45 +766,322 @@ void CelObj::submitPalette() const {
 #pragma mark -
 #pragma mark CelObj - Caching
 
-int CelObj::_nextCacheId = 1;
 CelCache *CelObj::_cache = nullptr;
 
-int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
-	*nextInsertIndex = -1;
-	int oldestId = _nextCacheId + 1;
-	int oldestIndex = 0;
+/**
+ * Decompresses a compressed cel into a new buffer of `width * height` bytes,
+ * which the caller must delete[].
+ */
+static byte *decompressCel(const SciSpan<const byte> &resource, const uint32 celHeaderOffset, const int16 width, const int16 height, const uint8 skipColor) {
+	byte *pixels = new byte[width * height];
+	READER_Compressed reader(resource, celHeaderOffset, width, height, skipColor);
+	for (int16 y = 0; y < height; ++y) {
+		memcpy(pixels + y * width, reader.getRow(y), width);
+	}
+	return pixels;
+}
+
+void CelObj::decodePixels() {
+	if (_compressionType == kCelCompressionRLE && !_decodedPixels) {
+		byte *pixels = decompressCel(getResPointer(), _celHeaderOffset, _width, _height, _skipColor);
+		_decodedPixels = Common::SharedPtr<byte>(pixels, Common::ArrayDeleter<byte>());
+	}
+}
+
+/**
+ * The compressed cels of a view or pic being decompressed on the task pool.
+ */
+struct CelPredecodeJob {
+	struct Cel {
+		uint32 celHeaderOffset;
+		int16 width;
+		int16 height;
+		uint8 skipColor;
+		byte *pixels;
+	};
+
+	/**
+	 * The resource of the cels, locked until the job is collected.
+	 */
+	Resource *resource;
+
+	/**
+	 * The data of the resource, as an unnamed span which can be copied from
+	 * other threads.
+	 */
+	SciSpan<const byte> data;
+
+	/**
+	 * The distinct cels to decompress, with their pixels once they are.
+	 */
+	Common::Array<Cel> cels;
+
+	/**
+	 * Every compressed cel of the resource, with the index of its pixels in
+	 * `cels`. Mirrored loops share the cels of the loop they mirror.
+	 */
+	Common::Array<CelInfo32> infos;
+	Common::Array<uint> celIndexes;
+
+	Common::TaskGroup group;
+};
+
+CelCache::CelCache(const uint32 maxMemory) :
+	_memory(0),
+	_maxMemory(maxMemory) {}
+
+CelCache::~CelCache() {
+	for (JobList::iterator it = _jobs.begin(); it != _jobs.end(); ++it) {
+		CelPredecodeJob *job = *it;
+		job->group.wait();
+		for (uint i = 0; i < job->cels.size(); ++i) {
+			delete[] job->cels[i].pixels;
+		}
+		g_sci->getResMan()->unlockResource(job->resource);
+		delete job;
+	}
 
-	for (int i = 0, len = _cache->size(); i < len; ++i) {
-		CelCacheEntry &entry = (*_cache)[i];
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		delete it->_value.celObj;
+	}
+}
+
+CelObj *CelCache::find(const CelInfo32 &celInfo) {
+	EntryMap::iterator it = _entries.find(celInfo);
+	if (it == _entries.end()) {
+		return nullptr;
+	}
 
-		if (entry.celObj == nullptr) {
-			if (*nextInsertIndex == -1) {
-				*nextInsertIndex = i;
+	Entry &entry = it->_value;
+	if (entry.lruPosition != _lru.begin()) {
+		_lru.erase(entry.lruPosition);
+		_lru.push_front(celInfo);
+		entry.lruPosition = _lru.begin();
+	}
+
+	return entry.celObj;
+}
+
+void CelCache::put(const CelObj &celObj) {
+	EntryMap::iterator it = _entries.find(celObj._info);
+	if (it != _entries.end()) {
+		removeEntry(it);
+	}
+
+	Entry entry;
+	entry.celObj = celObj.duplicate();
+	_lru.push_front(celObj._info);
+	entry.lruPosition = _lru.begin();
+	_entries[celObj._info] = entry;
+	_memory += sizeof(CelObjPic);
+	addPixelsUser(celObj._decodedPixels.get(), celObj._width * celObj._height);
+
+	freeOldEntries();
+}
+
+bool CelCache::predecode(const CelType type, const GuiResourceId resourceId) {
+	const ResourceId id(type == kCelTypeView ? kResourceTypeView : kResourceTypePic, resourceId);
+	if (_predecoded.contains(id)) {
+		return _predecoded[id];
+	}
+
+	// Without workers, each cel is decompressed when it is first created
+	if (TaskPoolMan.getNumWorkers() == 0) {
+		return false;
+	}
+
+	_predecoded[id] = false;
+
+	Resource *const resource = g_sci->getResMan()->findResource(id, true);
+	if (!resource) {
+		return false;
+	}
+
+	CelPredecodeJob *job = new CelPredecodeJob();
+	job->resource = resource;
+	job->data = SciSpan<const byte>(resource->data(), resource->size());
+
+	const SciSpan<const byte> &data = *resource;
+	Common::HashMap<uint32, uint> celIndexes;
+
+	// Walk the same headers as the CelObjView and CelObjPic constructors
+	CelInfo32 info;
+	info.type = type;
+	info.resourceId = resourceId;
+	const int16 numLoops = type == kCelTypeView ? data[2] : 1;
+	for (int16 loopNo = 0; loopNo < numLoops; ++loopNo) {
+		SciSpan<const byte> loopHeader;
+		int16 numCels;
+		if (type == kCelTypeView) {
+			const uint16 viewHeaderSize = data.getUint16SEAt(0);
+			const uint8 loopHeaderSize = data[12];
+			const uint8 viewHeaderFieldSize = 2;
+
+			loopHeader = data.subspan(viewHeaderFieldSize + viewHeaderSize + (loopHeaderSize * loopNo));
+			if (loopHeader.getInt8At(0) != -1) {
+				loopHeader = data.subspan(viewHeaderFieldSize + viewHeaderSize + (loopHeaderSize * loopHeader.getInt8At(0)));
+			}
+			numCels = loopHeader[2];
+		} else {
+			numCels = data[2];
+		}
+
+		for (int16 celNo = 0; celNo < numCels; ++celNo) {
+			uint32 celHeaderOffset;
+			if (type == kCelTypeView) {
+				celHeaderOffset = loopHeader.getUint32SEAt(12) + (data[13] * celNo);
+			} else {
+				celHeaderOffset = data.getUint16SEAt(0) + (data.getUint16SEAt(4) * celNo);
+			}
+
+			const SciSpan<const byte> celHeader = data.subspan(celHeaderOffset);
+			if (celHeader[9] != kCelCompressionRLE) {
+				continue;
+			}
+
+			info.loopNo = loopNo;
+			info.celNo = celNo;
+			EntryMap::iterator it = _entries.find(info);
+			if (it != _entries.end() && it->_value.celObj->_decodedPixels) {
+				continue;
+			}
+
+			uint index;
+			if (celIndexes.contains(celHeaderOffset)) {
+				index = celIndexes[celHeaderOffset];
+			} else {
+				CelPredecodeJob::Cel cel;
+				cel.celHeaderOffset = celHeaderOffset;
+				cel.width = celHeader.getUint16SEAt(0);
+				cel.height = celHeader.getUint16SEAt(2);
+				cel.skipColor = celHeader[8];
+				cel.pixels = nullptr;
+
+				index = job->cels.size();
+				celIndexes[celHeaderOffset] = index;
+				job->cels.push_back(cel);
+			}
+
+			job->infos.push_back(info);
+			job->celIndexes.push_back(index);
+		}
+	}
+
+	if (job->cels.empty()) {
+		g_sci->getResMan()->unlockResource(resource);
+		delete job;
+		return false;
+	}
+
+	for (uint i = 0; i < job->cels.size(); ++i) {
+		job->group.run([job, i]() {
+			CelPredecodeJob::Cel &cel = job->cels[i];
+			cel.pixels = decompressCel(job->data, cel.celHeaderOffset, cel.width, cel.height, cel.skipColor);
+		});
+	}
+
+	_predecoded[id] = true;
+	_jobs.push_back(job);
+	return true;
+}
+
+void CelCache::collectPredecoded() {
+	if (_jobs.empty()) {
+		return;
+	}
+
+	JobList::iterator it = _jobs.begin();
+	while (it != _jobs.end()) {
+		CelPredecodeJob *job = *it;
+		if (!job->group.isDone()) {
+			++it;
+			continue;
+		}
+
+		Common::Array<Common::SharedPtr<byte> > pixels(job->cels.size());
+		for (uint i = 0; i < job->cels.size(); ++i) {
+			pixels[i] = Common::SharedPtr<byte>(job->cels[i].pixels, Common::ArrayDeleter<byte>());
+		}
+
+		for (uint i = 0; i < job->infos.size(); ++i) {
+			const CelInfo32 &info = job->infos[i];
+			const CelPredecodeJob::Cel &cel = job->cels[job->celIndexes[i]];
+			const Common::SharedPtr<byte> &celPixels = pixels[job->celIndexes[i]];
+			const uint32 size = cel.width * cel.height;
+
+			EntryMap::iterator entryIt = _entries.find(info);
+			if (entryIt == _entries.end()) {
+				PendingPixels &pending = _pending[info];
+				pending.pixels = celPixels;
+				pending.size = size;
+				addPixelsUser(celPixels.get(), size);
+			} else if (!entryIt->_value.celObj->_decodedPixels) {
+				entryIt->_value.celObj->_decodedPixels = celPixels;
+				addPixelsUser(celPixels.get(), size);
 			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
-		} else if (oldestId > entry.id) {
-			oldestId = entry.id;
-			oldestIndex = i;
 		}
+
+		_predecoded[ResourceId(job->resource->getType(), job->resource->getNumber())] = false;
+		g_sci->getResMan()->unlockResource(job->resource);
+		delete job;
+		it = _jobs.erase(it);
+	}
+
+	freeOldEntries();
+}
+
+Common::SharedPtr<byte> CelCache::takePredecoded(const CelInfo32 &celInfo) {
+	PendingMap::iterator it = _pending.find(celInfo);
+	if (it == _pending.end()) {
+		return Common::SharedPtr<byte>();
+	}
+
+	// The pixels are counted again once the cel is put in the cache
+	const Common::SharedPtr<byte> pixels = it->_value.pixels;
+	removePixelsUser(pixels.get(), it->_value.size);
+	_pending.erase(it);
+	return pixels;
+}
+
+void CelCache::addPixelsUser(const byte *pixels, const uint32 size) {
+	if (pixels != nullptr && ++_pixelsUsers[pixels] == 1) {
+		_memory += size;
 	}
+}
 
-	if (*nextInsertIndex == -1) {
-		*nextInsertIndex = oldestIndex;
+void CelCache::removePixelsUser(const byte *pixels, const uint32 size) {
+	if (pixels == nullptr) {
+		return;
 	}
 
-	return -1;
+	Common::HashMap<const byte *, uint>::iterator it = _pixelsUsers.find(pixels);
+	assert(it != _pixelsUsers.end());
+	if (--it->_value == 0) {
+		_pixelsUsers.erase(it);
+		_memory -= size;
+	}
 }
 
-void CelObj::putCopyInCache(const int cacheIndex) const {
-	if (cacheIndex == -1) {
-		error("Invalid cache index");
+void CelCache::removeEntry(EntryMap::iterator it) {
+	const CelObj &celObj = *it->_value.celObj;
+	_memory -= sizeof(CelObjPic);
+	removePixelsUser(celObj._decodedPixels.get(), celObj._width * celObj._height);
+	_lru.erase(it->_value.lruPosition);
+	delete it->_value.celObj;
+	_entries.erase(it);
+}
+
+void CelCache::freeOldEntries() {
+	// The pixels of cels which were never created are dropped first
+	while (_memory > _maxMemory && !_pending.empty()) {
+		PendingMap::iterator it = _pending.begin();
+		removePixelsUser(it->_value.pixels.get(), it->_value.size);
+		_pending.erase(it);
 	}
 
-	CelCacheEntry &entry = (*_cache)[cacheIndex];
-	entry.celObj.reset(duplicate());
-	entry.id = ++_nextCacheId;
+	while (_memory > _maxMemory && !_lru.empty()) {
+		removeEntry(_entries.find(_lru.back()));
+	}
 }
 
 #pragma mark -
@@ -983,16 +1328,15 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 	_compressionType = kCelCompressionInvalid;
 	_transparent = true;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjView *const cachedCelObj = dynamic_cast<CelObjView *>(entry.celObj.get());
+	_cache->collectPredecoded();
+
+	const CelObj *const cachedObj = _cache->find(_info);
+	if (cachedObj != nullptr) {
+		const CelObjView *const cachedCelObj = dynamic_cast<const CelObjView *>(cachedObj);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjView in cache slot %d", cacheIndex);
+			error("Expected a CelObjView in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1090,7 +1434,16 @@ CelObjView::CelObjView(const GuiResourceId viewId, const int16 loopNo, const int
 		_remap = analyzeForRemap();
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	// Compressed cels are decompressed once and drawn from the cache, along
+	// with the other cels of the view when there are threads to do it
+	if (_compressionType == kCelCompressionRLE) {
+		_decodedPixels = _cache->takePredecoded(_info);
+		if (!_decodedPixels && !_cache->predecode(kCelTypeView, viewId)) {
+			decodePixels();
+		}
+	}
+
+	_cache->put(*this);
 }
 
 bool CelObjView::analyzeUncompressedForRemap() const {
@@ -1191,16 +1544,15 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 	_transparent = true;
 	_remap = false;
 
-	int cacheInsertIndex;
-	const int cacheIndex = searchCache(_info, &cacheInsertIndex);
-	if (cacheIndex != -1) {
-		CelCacheEntry &entry = (*_cache)[cacheIndex];
-		const CelObjPic *const cachedCelObj = dynamic_cast<CelObjPic *>(entry.celObj.get());
+	_cache->collectPredecoded();
+
+	const CelObj *const cachedObj = _cache->find(_info);
+	if (cachedObj != nullptr) {
+		const CelObjPic *const cachedCelObj = dynamic_cast<const CelObjPic *>(cachedObj);
 		if (cachedCelObj == nullptr) {
-			error("Expected a CelObjPic in cache slot %d", cacheIndex);
+			error("Expected a CelObjPic in cache for %s", _info.toString().c_str());
 		}
 		*this = *cachedCelObj;
-		entry.id = ++_nextCacheId;
 		return;
 	}
 
@@ -1264,7 +1616,14 @@ CelObjPic::CelObjPic(const GuiResourceId picId, const int16 celNo) {
 		}
 	}
 
-	putCopyInCache(cacheInsertIndex);
+	if (_compressionType == kCelCompressionRLE) {
+		_decodedPixels = _cache->takePredecoded(_info);
+		if (!_decodedPixels && !_cache->predecode(kCelTypePic, picId)) {
+			decodePixels();
+		}
+	}
+
+	_cache->put(*this);
 }
 
 bool CelObjPic::analyzeUncompressedForSkip() const {
@@ -1371,6 +1730,9 @@ void CelObjColor::draw(Buffer &target, const ScreenItem &screenItem, const Commo
 void CelObjColor::draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, bool mirrorX) {
 	error("Unsupported method");
 }
+void CelObjColor::drawPrepared(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const {
+	draw(target, targetRect);
+}
 void CelObjColor::draw(Buffer &target, const Common::Rect &targetRect) const {
 	target.fillRect(targetRect, translateMacColor(_isMacSource, _info.color));
 }
@@ -22,6 +22,11 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hash-ptr.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +110,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +120,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -135,18 +140,125 @@ struct CelInfo32 {
 	}
 };
 
-class CelObj;
-struct CelCacheEntry {
+struct CelInfo32Hash : public Common::UnaryFunction<CelInfo32, uint> {
+	// Uses the same fields as CelInfo32::operator==
+	uint operator()(const CelInfo32 &info) const {
+		return info.type ^ (info.resourceId << 4) ^ (info.loopNo << 12) ^ (info.celNo << 20) ^
+			(info.bitmap.getSegment() << 8) ^ info.bitmap.getOffset();
+	}
+};
+
+enum {
 	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
+	 * The default memory budget of the cel cache, in bytes.
 	 */
-	int id;
-	Common::ScopedPtr<CelObj> celObj;
-	CelCacheEntry() : id(0) {}
+	kCelCacheDefaultSize = 16 * 1024 * 1024
 };
 
-typedef Common::Array<CelCacheEntry> CelCache;
+class CelObj;
+struct CelPredecodeJob;
+
+/**
+ * A cache of cel objects keyed by their CelInfo32, which frees the least
+ * recently used cels once they take more memory than its budget. Compressed
+ * cels are kept with their decompressed pixels.
+ */
+class CelCache {
+public:
+	CelCache(const uint32 maxMemory);
+	~CelCache();
+
+	/**
+	 * Returns the cached cel matching the given CelInfo32 and marks it as the
+	 * most recently used, or returns nullptr if there is none.
+	 */
+	CelObj *find(const CelInfo32 &celInfo);
+
+	/**
+	 * Puts a copy of the given cel into the cache, replacing any cel with the
+	 * same CelInfo32.
+	 */
+	void put(const CelObj &celObj);
+
+	/**
+	 * Starts decompressing every compressed cel of the given view or pic on
+	 * the task pool, unless this was already done for it. Only the cel
+	 * headers are read here, the pixels are given to the cels by
+	 * collectPredecoded() once they are ready.
+	 *
+	 * @returns true if the cels are being decompressed.
+	 */
+	bool predecode(const CelType type, const GuiResourceId resourceId);
+
+	/**
+	 * Gives the pixels decompressed by predecode() to the cached cels, and
+	 * keeps those of the cels not created yet for takePredecoded().
+	 */
+	void collectPredecoded();
+
+	/**
+	 * Returns the pixels decompressed by predecode() for a cel which was not
+	 * in the cache yet, if there are any.
+	 */
+	Common::SharedPtr<byte> takePredecoded(const CelInfo32 &celInfo);
+
+	uint32 getMemory() const { return _memory; }
+
+private:
+	struct Entry {
+		CelObj *celObj;
+		Common::List<CelInfo32>::iterator lruPosition;
+
+		Entry() : celObj(nullptr) {}
+	};
+
+	struct PendingPixels {
+		Common::SharedPtr<byte> pixels;
+		uint32 size;
+
+		PendingPixels() : size(0) {}
+	};
+
+	typedef Common::HashMap<CelInfo32, Entry, CelInfo32Hash> EntryMap;
+	typedef Common::HashMap<CelInfo32, PendingPixels, CelInfo32Hash> PendingMap;
+	typedef Common::List<CelPredecodeJob *> JobList;
+
+	EntryMap _entries;
+
+	/**
+	 * The keys of the cached cels, from the most to the least recently used.
+	 */
+	Common::List<CelInfo32> _lru;
+
+	uint32 _memory;
+	uint32 _maxMemory;
+
+	/**
+	 * The number of cached cels and pending pixels using each buffer of
+	 * pixels, which are shared by the cels of mirrored loops and only
+	 * counted once in `_memory`.
+	 */
+	Common::HashMap<const byte *, uint> _pixelsUsers;
+
+	JobList _jobs;
+
+	/**
+	 * The resources predecode() was called for, and whether their cels are
+	 * still being decompressed.
+	 */
+	Common::HashMap<ResourceId, bool, ResourceIdHash> _predecoded;
+
+	/**
+	 * The decompressed pixels of the cels which were not in the cache when
+	 * their job was collected.
+	 */
+	PendingMap _pending;
+
+	void addPixelsUser(const byte *pixels, const uint32 size);
+	void removePixelsUser(const byte *pixels, const uint32 size);
+	void removeEntry(EntryMap::iterator it);
+	void freeOldEntries();
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -227,8 +339,16 @@ public:
 
 	/**
 	 * Retrieves scaler tables for the given X and Y ratios.
+	 *
+	 * @note The tables may be replaced by the next call, so they must be used
+	 * with the mutex locked when cels are drawn from several threads.
 	 */
 	const CelScalerTable &getScalerTable(const Ratio &scaleX, const Ratio &scaleY);
+
+	/**
+	 * Guards the cached scale tables.
+	 */
+	Common::Mutex _mutex;
 };
 
 #pragma mark -
@@ -259,6 +379,15 @@ protected:
 	 */
 	bool _drawMirrored;
 
+	/**
+	 * The resource data of the cel while it is drawn by drawPrepared(), and
+	 * the resource locked to keep that data loaded.
+	 *
+	 * @see prepareDraw
+	 */
+	SciSpan<const byte> _drawResource;
+	Resource *_drawResourceLock = nullptr;
+
 public:
 	static CelScaler *_scaler;
 
@@ -320,6 +449,13 @@ public:
 	 */
 	CelCompressionType _compressionType;
 
+	/**
+	 * For compressed cels, the decompressed pixels of the whole cel, which are
+	 * drawn from instead of decompressing the resource data again. The pixels
+	 * are shared with the copies of this cel in the cel cache.
+	 */
+	Common::SharedPtr<byte> _decodedPixels;
+
 	/**
 	 * Whether or not this cel contains remap pixels.
 	 */
@@ -348,6 +484,12 @@ public:
 	 */
 	static void deinit();
 
+	/**
+	 * Gives the cels the pixels decompressed for them in the background. This
+	 * must be called at least once per frame.
+	 */
+	static void collectPredecodedCels();
+
 	virtual ~CelObj() {};
 
 	/**
@@ -379,6 +521,35 @@ public:
 	 */
 	virtual void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX);
 
+	/**
+	 * Prepares the cel to be drawn with drawPrepared() using the given mirror
+	 * flag, and keeps its resource data loaded until finishDraw() is called.
+	 * This must be called from the main thread.
+	 */
+	void prepareDraw(const bool mirrorX);
+
+	/**
+	 * Draws the cel like draw(), using the mirroring set by prepareDraw().
+	 * This does not change the state of the cel nor access the resource
+	 * manager, so separate parts of the target can be drawn from several
+	 * threads at once. Screen items which draw black lines are not
+	 * supported.
+	 */
+	virtual void drawPrepared(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const;
+
+	/**
+	 * Releases the resource data kept by prepareDraw().
+	 */
+	void finishDraw();
+
+	/**
+	 * Retrieves the data to draw the cel from, which is the one kept by
+	 * prepareDraw() while the cel is prepared.
+	 */
+	const SciSpan<const byte> getDrawResPointer() const {
+		return _drawResource.data() ? _drawResource : getResPointer();
+	}
+
 	/**
 	 * Draws the cel to the target buffer using the given position and scaling
 	 * parameters. The mirroring of the cel will be unchanged from any previous
@@ -450,30 +621,18 @@ private:
 #pragma mark -
 #pragma mark CelObj - Caching
 protected:
-	/**
-	 * A monotonically increasing cache ID used to identify the least recently
-	 * used item in the cache for replacement.
-	 */
-	static int _nextCacheId;
-
 	/**
 	 * A cache of cel objects used to avoid reinitialisation overhead for cels
-	 * with the same CelInfo32.
+	 * with the same CelInfo32, which also keeps the decompressed pixels of
+	 * compressed cels.
 	 */
 	static CelCache *_cache;
 
 	/**
-	 * Searches the cel cache for a CelObj matching the provided CelInfo32. If
-	 * not found, -1 is returned. `nextInsertIndex` will receive the index of
-	 * the oldest item in the cache, which can be used to replace the oldest
-	 * item with a newer item.
-	 */
-	int searchCache(const CelInfo32 &celInfo, int *nextInsertIndex) const;
-
-	/**
-	 * Puts a copy of this CelObj into the cache at the given cache index.
+	 * Decompresses the pixels of this cel, if it is compressed, so that they
+	 * are kept in the cel cache along with it.
 	 */
-	void putCopyInCache(int index) const;
+	void decodePixels();
 };
 
 #pragma mark -
@@ -596,6 +755,7 @@ public:
 	void draw(Buffer &target, const Common::Rect &targetRect) const;
 	void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) override;
 	void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) override;
+	void drawPrepared(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect) const override;
 
 	CelObjColor *duplicate() const override;
 	const SciSpan<const byte> getResPointer() const override;
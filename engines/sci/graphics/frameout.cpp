@@ -26,6 +26,7 @@
 #include "common/list.h"
 #include "common/str.h"
 #include "common/system.h"
+#include "common/taskpool.h"
 #include "common/textconsole.h"
 #include "engines/engine.h"
 #include "engines/util.h"
@@ -68,6 +69,9 @@ GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitio
 	_throttleState(0),
 	_remapOccurred(false),
 	_overdrawThreshold(0),
+	_drawInBands(false),
+	_drawTime(0),
+	_drawFrameCount(0),
 	_throttleKernelFrameOut(true),
 	_palMorphIsOn(false),
 	_lastScreenUpdateTick(0) {
@@ -479,6 +483,7 @@ void GfxFrameout::kernelAddPicAt(const reg_t planeObject, const GuiResourceId pi
 
 void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseRect) {
 	updateMousePositionForRendering();
+	CelObj::collectPredecodedCels();
 
 	RobotDecoder &robotPlayer = g_sci->_video32->getRobotPlayer();
 	const bool robotIsActive = robotPlayer.getStatus() != RobotDecoder::kRobotStatusUninitialized;
@@ -513,10 +518,13 @@ void GfxFrameout::frameOut(const bool shouldShowBits, const Common::Rect &eraseR
 
 	_remapOccurred = _palette->updateForFrame();
 
+	const uint64 drawStartTime = g_system->getMicros();
 	for (PlaneList::size_type i = 0; i < _planes.size(); ++i) {
 		drawEraseList(eraseLists[i], *_planes[i]);
 		drawScreenItemList(_screenItemLists[i]);
 	}
+	_drawTime += g_system->getMicros() - drawStartTime;
+	++_drawFrameCount;
 
 	if (robotIsActive) {
 		robotPlayer.frameAlmostVisible();
@@ -1008,6 +1016,21 @@ void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
 
 void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	const DrawList::size_type drawListSize = screenItemList.size();
+
+	if (_drawInBands && drawListSize > 1 && TaskPoolMan.getNumWorkers() > 0) {
+		// The black lines are drawn relative to the top of the drawn area,
+		// which splitting the items would change
+		bool hasBlackLines = false;
+		for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+			hasBlackLines = hasBlackLines || screenItemList[i]->screenItem->_drawBlackLines;
+		}
+
+		if (!hasBlackLines) {
+			drawScreenItemListInBands(screenItemList);
+			return;
+		}
+	}
+
 	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
 		const DrawItem &drawItem = *screenItemList[i];
 		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
@@ -1017,6 +1040,46 @@ void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	}
 }
 
+void GfxFrameout::drawScreenItemListInBands(const DrawList &screenItemList) {
+	const DrawList::size_type drawListSize = screenItemList.size();
+
+	// Everything which is not thread safe happens here, before the bands are
+	// drawn
+	Common::Rect bounds = screenItemList[0]->rect;
+	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+		const DrawItem &drawItem = *screenItemList[i];
+		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
+		bounds.extend(drawItem.rect);
+		const ScreenItem &screenItem = *drawItem.screenItem;
+		CelObj &celObj = *screenItem._celObj;
+		celObj.prepareDraw(screenItem._mirrorX ^ celObj._mirrorX);
+	}
+
+	// Each band draws every item crossing it in the same order, so the items
+	// still overlap in priority order
+	const int bandHeight = MAX<int>(bounds.height() / (int)(TaskPoolMan.getNumWorkers() + 1) + 1, 16);
+
+	Common::TaskGroup group;
+	for (int top = bounds.top; top < bounds.bottom; top += bandHeight) {
+		const Common::Rect band(bounds.left, top, bounds.right, MIN<int>(top + bandHeight, bounds.bottom));
+		group.run([this, &screenItemList, drawListSize, band]() {
+			for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+				const DrawItem &drawItem = *screenItemList[i];
+				const Common::Rect rect = drawItem.rect.findIntersectingRect(band);
+				if (!rect.isEmpty()) {
+					const ScreenItem &screenItem = *drawItem.screenItem;
+					screenItem._celObj->drawPrepared(_currentBuffer, screenItem, rect);
+				}
+			}
+		});
+	}
+	group.wait();
+
+	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+		screenItemList[i]->screenItem->_celObj->finishDraw();
+	}
+}
+
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
 	RectList mergeList;
 	Common::Rect merged;
@@ -1457,6 +1520,21 @@ void GfxFrameout::printPlaneListInternal(Console *con, const PlaneList &planeLis
 	}
 }
 
+void GfxFrameout::setDrawInBands(const bool enable) {
+	_drawInBands = enable;
+	_drawTime = 0;
+	_drawFrameCount = 0;
+}
+
+void GfxFrameout::printDrawStats(Console *con) const {
+	con->debugPrintf("Drawing in bands: %s (%u worker threads)\n", _drawInBands ? "on" : "off", TaskPoolMan.getNumWorkers());
+	if (_drawFrameCount) {
+		con->debugPrintf("%u frames, %u microseconds per frame on average\n", _drawFrameCount, (uint32)(_drawTime / _drawFrameCount));
+	} else {
+		con->debugPrintf("No frames drawn yet\n");
+	}
+}
+
 void GfxFrameout::printPlaneList(Console *con) const {
 	printPlaneListInternal(con, _planes);
 }
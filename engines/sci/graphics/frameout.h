@@ -342,6 +342,20 @@ private:
 	 */
 	int _overdrawThreshold;
 
+	/**
+	 * When true, the screen items of each plane are drawn by several threads
+	 * at once, each one drawing all the items that cross its own band of
+	 * lines of the screen.
+	 */
+	bool _drawInBands;
+
+	/**
+	 * The time spent drawing the planes in frameOut, in microseconds, and the
+	 * number of frames drawn, since the drawing mode was last changed.
+	 */
+	uint64 _drawTime;
+	uint32 _drawFrameCount;
+
 	/**
 	 * The list of planes that are currently drawn to the hardware display
 	 * surface. Used to calculate differences in plane properties between the
@@ -374,6 +388,12 @@ private:
 	 */
 	void drawScreenItemList(const DrawList &screenItemList);
 
+	/**
+	 * Draws the screen items like drawScreenItemList, splitting the screen
+	 * into bands of lines which are drawn by separate threads.
+	 */
+	void drawScreenItemListInBands(const DrawList &screenItemList);
+
 	/**
 	 * Adds a new rectangle to the list of regions to write out to the hardware.
 	 * The provided rect may be merged into an existing rectangle to reduce the
@@ -442,6 +462,14 @@ public:
 	void printPlaneItemList(Console *con, const reg_t planeObject) const;
 	void printVisiblePlaneItemList(Console *con, const reg_t planeObject) const;
 	void printPlaneItemListInternal(Console *con, const ScreenItemList &screenItemList) const;
+
+	/**
+	 * Enables or disables drawing the screen items in bands of lines by
+	 * several threads, and resets the frame time statistics.
+	 */
+	void setDrawInBands(const bool enable);
+	bool getDrawInBands() const { return _drawInBands; }
+	void printDrawStats(Console *con) const;
 };
 
 } // End of namespace Sci
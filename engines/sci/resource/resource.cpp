@@ -26,6 +26,7 @@
 #include "common/fs.h"
 #include "common/macresman.h"
 #include "common/textconsole.h"
+#include "common/tokenizer.h"
 #include "common/translation.h"
 #ifdef ENABLE_SCI32
 #include "common/compression/installshield_cab.h"
@@ -210,6 +211,9 @@ Resource::Resource(ResourceManager *resMan, ResourceId id) : SciSpan<const byte>
 	_source = nullptr;
 	_header = nullptr;
 	_headerSize = 0;
+	_lruPrev = nullptr;
+	_lruNext = nullptr;
+	_pinned = false;
 }
 
 Resource::~Resource() {
@@ -1008,7 +1012,12 @@ void ResourceManager::init() {
 	_maxMemoryLRU = 256 * 1024; // 256KiB
 	_memoryLocked = 0;
 	_memoryLRU = 0;
-	_LRU.clear();
+	_memoryPinned = 0;
+	_lruHead = nullptr;
+	_lruTail = nullptr;
+	for (int i = 0; i < kResourceTypeInvalid; i++)
+		_pinnedTypes[i] = false;
+	resetCacheStats();
 	_resMap.clear();
 	_audioMapSCI1 = nullptr;
 #ifdef ENABLE_SCI32
@@ -1082,6 +1091,39 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	// Machines with plenty of memory can keep more resources around to
+	// avoid reading and decompressing them again. The size is in KiB.
+	if (!_detectionMode && ConfMan.hasKey("resource_cache_size")) {
+		const int cacheSize = ConfMan.getInt("resource_cache_size");
+		if (cacheSize > 0)
+			_maxMemoryLRU = cacheSize * 1024;
+	}
+
+	// A list of resource types that are never freed once loaded, separated
+	// by spaces or commas, e.g. "view pic"
+	if (!_detectionMode && ConfMan.hasKey("resource_cache_pinned")) {
+		Common::String types = ConfMan.get("resource_cache_pinned");
+		for (uint i = 0; i < types.size(); i++) {
+			if (types[i] == ',')
+				types.setChar(' ', i);
+		}
+
+		Common::StringTokenizer tokenizer(types);
+		while (!tokenizer.empty()) {
+			const Common::String typeName = tokenizer.nextToken();
+			int type;
+			for (type = 0; type < kResourceTypeInvalid; type++) {
+				if (typeName.equalsIgnoreCase(getResourceTypeName((ResourceType)type)))
+					break;
+			}
+
+			if (type < kResourceTypeInvalid)
+				_pinnedTypes[type] = true;
+			else
+				warning("resMan: Unknown resource type '%s' in resource_cache_pinned", typeName.c_str());
+		}
+	}
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1128,8 +1170,22 @@ void ResourceManager::removeFromLRU(Resource *res) {
 		warning("resMan: trying to remove resource that isn't enqueued");
 		return;
 	}
-	_LRU.remove(res);
-	_memoryLRU -= res->size();
+	if (res->_pinned) {
+		_memoryPinned -= res->size();
+		res->_pinned = false;
+	} else {
+		if (res->_lruPrev)
+			res->_lruPrev->_lruNext = res->_lruNext;
+		else
+			_lruHead = res->_lruNext;
+		if (res->_lruNext)
+			res->_lruNext->_lruPrev = res->_lruPrev;
+		else
+			_lruTail = res->_lruPrev;
+		res->_lruPrev = nullptr;
+		res->_lruNext = nullptr;
+		_memoryLRU -= res->size();
+	}
 	res->_status = kResStatusAllocated;
 }
 
@@ -1138,7 +1194,20 @@ void ResourceManager::addToLRU(Resource *res) {
 		warning("resMan: trying to enqueue resource with state %d", res->_status);
 		return;
 	}
-	_LRU.push_front(res);
+	if (isResourceTypePinned(res->getType())) {
+		// Pinned resources are never freed, so they are not put in the list
+		res->_pinned = true;
+		_memoryPinned += res->size();
+		res->_status = kResStatusEnqueued;
+		return;
+	}
+	res->_lruPrev = nullptr;
+	res->_lruNext = _lruHead;
+	if (_lruHead)
+		_lruHead->_lruPrev = res;
+	else
+		_lruTail = res;
+	_lruHead = res;
 	_memoryLRU += res->size();
 #ifdef SCI_VERBOSE_RESMAN
 	debug("Adding %s (%d bytes) to lru control: %d bytes total",
@@ -1150,16 +1219,50 @@ void ResourceManager::addToLRU(Resource *res) {
 
 void ResourceManager::freeOldResources() {
 	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
+		assert(_lruTail);
+		Resource *goner = _lruTail;
 		removeFromLRU(goner);
 		goner->unalloc();
+		_cacheEvictions++;
 #ifdef SCI_VERBOSE_RESMAN
 		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
 	}
 }
 
+void ResourceManager::setMaxMemoryLRU(int size) {
+	_maxMemoryLRU = size;
+	freeOldResources();
+}
+
+void ResourceManager::setResourceTypePinned(ResourceType type, bool pinned) {
+	if (type >= kResourceTypeInvalid || _pinnedTypes[type] == pinned)
+		return;
+
+	_pinnedTypes[type] = pinned;
+
+	// Move the unlocked resources of this type in or out of the LRU list
+	for (ResourceMap::iterator it = _resMap.begin(); it != _resMap.end(); ++it) {
+		Resource *res = it->_value;
+		if (res->getType() == type && res->_status == kResStatusEnqueued) {
+			removeFromLRU(res);
+			addToLRU(res);
+		}
+	}
+
+	freeOldResources();
+}
+
+bool ResourceManager::isResourceTypePinned(ResourceType type) const {
+	return type < kResourceTypeInvalid && _pinnedTypes[type];
+}
+
+void ResourceManager::resetCacheStats() {
+	_cacheHits = 0;
+	_cacheMisses = 0;
+	_cacheEvictions = 0;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1196,9 +1299,16 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	if (!retval)
 		return nullptr;
 
-	if (retval->_status == kResStatusNoMalloc)
+	// Only resources kept in memory by the LRU list count as hits, since
+	// locked and pinned ones stay loaded whatever the cache size
+	if (retval->_status == kResStatusNoMalloc) {
+		_cacheMisses++;
 		loadResource(retval);
-	else if (retval->_status == kResStatusEnqueued)
+	} else if (retval->_status == kResStatusEnqueued && !retval->_pinned) {
+		_cacheHits++;
+	}
+
+	if (retval->_status == kResStatusEnqueued)
 		// The resource is removed from its current position
 		// in the LRU list because it has been requested
 		// again. Below, it will either be locked, or it
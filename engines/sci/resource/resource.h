@@ -312,6 +312,11 @@ protected:
 	ResourceSource *_source;
 	ResourceManager *_resMan;
 
+	// Links of the LRU list, only valid while the resource is enqueued
+	Resource *_lruPrev;
+	Resource *_lruNext;
+	bool _pinned; /**< Enqueued, but kept out of the LRU list because its type is pinned */
+
 	bool loadPatch(Common::SeekableReadStream *file);
 	bool loadFromPatchFile();
 	bool loadFromWaveFile(Common::SeekableReadStream *file);
@@ -487,6 +492,28 @@ public:
 	 */
 	ResourceType convertResType(byte type);
 
+	/**
+	 * Sets the number of bytes of unlocked resources that are kept in memory,
+	 * freeing the least recently used ones if they now exceed it.
+	 */
+	void setMaxMemoryLRU(int size);
+	int getMaxMemoryLRU() const { return _maxMemoryLRU; }
+	int getMemoryLRU() const { return _memoryLRU; }
+	int getMemoryLocked() const { return _memoryLocked; }
+	int getMemoryPinned() const { return _memoryPinned; }
+
+	/**
+	 * Pins or unpins a resource type. Unlocked resources of a pinned type
+	 * stay in memory and do not count towards the LRU budget.
+	 */
+	void setResourceTypePinned(ResourceType type, bool pinned);
+	bool isResourceTypePinned(ResourceType type) const;
+
+	uint32 getCacheHits() const { return _cacheHits; }
+	uint32 getCacheMisses() const { return _cacheMisses; }
+	uint32 getCacheEvictions() const { return _cacheEvictions; }
+	void resetCacheStats();
+
 protected:
 	bool _detectionMode;
 
@@ -501,7 +528,13 @@ protected:
 	SourcesList _sources;
 	int _memoryLocked;	///< Amount of resource bytes in locked memory
 	int _memoryLRU;		///< Amount of resource bytes under LRU control
-	Common::List<Resource *> _LRU; ///< Last Resource Used list
+	int _memoryPinned;	///< Amount of unlocked resource bytes of pinned types
+	Resource *_lruHead; ///< Most recently used resource under LRU control
+	Resource *_lruTail; ///< Least recently used resource, the first to be freed
+	bool _pinnedTypes[kResourceTypeInvalid]; ///< Types whose unlocked resources are never freed
+	uint32 _cacheHits;	///< Requests for resources that were still in the LRU list
+	uint32 _cacheMisses;	///< Requests for resources that had to be read
+	uint32 _cacheEvictions;	///< Resources freed to stay within _maxMemoryLRU
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
@@ -111,6 +111,7 @@ ScummDebugger::ScummDebugger(ScummEngine *s)
 #endif
 
 	registerCmd("resetcursors",    WRAP_METHOD(ScummDebugger, Cmd_ResetCursors));
+	registerCmd("stripcache",      WRAP_METHOD(ScummDebugger, Cmd_StripCache));
 }
 
 void ScummDebugger::preEnter() {
@@ -1414,4 +1415,21 @@ bool ScummDebugger::Cmd_ResetCursors(int argc, const char **argv) {
 	return false;
 }
 
+bool ScummDebugger::Cmd_StripCache(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "on") && strcmp(argv[1], "off"))) {
+		debugPrintf("Usage: %s [on | off]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2)
+		_vm->_gdi->enableStripCache(!strcmp(argv[1], "on"));
+
+	const uint32 hits = _vm->_gdi->getStripCacheHits();
+	const uint32 misses = _vm->_gdi->getStripCacheMisses();
+	debugPrintf("Room strip cache: %s\n", _vm->_gdi->isStripCacheEnabled() ? "on" : "off");
+	debugPrintf("%u hits, %u misses (%u%% hit rate)\n", hits, misses,
+		hits + misses ? (uint)((uint64)hits * 100 / (hits + misses)) : 0);
+	return true;
+}
+
 } // End of namespace Scumm
@@ -216,6 +216,11 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+
+	_stripCacheEnabled = true;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
+	_stripCacheHits = 0;
+	_stripCacheMisses = 0;
 }
 
 Gdi::~Gdi() {
@@ -285,6 +290,7 @@ void Gdi::init() {
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	invalidateStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1178,7 +1184,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbCacheStrips);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -2363,6 +2369,14 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// The cached strips hold palette indices, which depend on the room palette
+	const bool useStripCache = _stripCacheEnabled && (flag & dbCacheStrips) && canCacheStrips()
+		&& vs->number == kMainVirtScreen && vs->format.bytesPerPixel == 1;
+	if (useStripCache && memcmp(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette))) {
+		invalidateStripCache();
+		memcpy(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette));
+	}
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -2395,7 +2409,17 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		const StripCacheEntry *cached = nullptr;
+		if (useStripCache)
+			cached = findCachedStrip(ptr, stripnr, y, height, numzbuf);
+
+		if (cached)
+			drawCachedStrip(*cached, dstPtr, vs, x, y, numzbuf, zplane_list);
+		else
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+
+		// Strips with transparent pixels depend on what was below them
+		const bool cacheable = useStripCache && !cached && !transpStrip;
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -2409,7 +2433,11 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		if (!cached)
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+
+		if (cacheable)
+			cacheStrip(ptr, dstPtr, vs, x, y, height, stripnr, numzbuf, zplane_list);
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -2445,6 +2473,83 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	}
 }
 
+void Gdi::enableStripCache(bool enable) {
+	_stripCacheEnabled = enable;
+	_stripCacheHits = 0;
+	_stripCacheMisses = 0;
+	invalidateStripCache();
+}
+
+void Gdi::invalidateStripCache() {
+	for (uint i = 0; i < _stripCache.size(); i++)
+		_stripCache[i].bitmap = nullptr;
+}
+
+const Gdi::StripCacheEntry *Gdi::findCachedStrip(const byte *ptr, int stripnr, int y, int height, int numzbuf) {
+	if (stripnr < (int)_stripCache.size()) {
+		const StripCacheEntry &entry = _stripCache[stripnr];
+		if (entry.bitmap == ptr && entry.y == y && entry.height == height && entry.numZBuffer == numzbuf) {
+			_stripCacheHits++;
+			return &entry;
+		}
+	}
+
+	_stripCacheMisses++;
+	return nullptr;
+}
+
+void Gdi::drawCachedStrip(const StripCacheEntry &entry, byte *dstPtr, VirtScreen *vs, int x, int y,
+				int numzbuf, const byte *zplane_list[9]) {
+	const byte *src = entry.pixels.data();
+	for (int h = 0; h < entry.height; h++) {
+		memcpy(dstPtr, src, 8);
+		dstPtr += vs->pitch;
+		src += 8;
+	}
+
+	// Only the Z-planes which decodeMask() wrote to are restored
+	src = entry.masks.data();
+	for (int i = 1; i < numzbuf; i++, src += entry.height) {
+		if (!zplane_list[i])
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < entry.height; h++)
+			mask_ptr[h * _numStrips] = src[h];
+	}
+}
+
+void Gdi::cacheStrip(const byte *ptr, const byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+				int stripnr, int numzbuf, const byte *zplane_list[9]) {
+	if (stripnr >= (int)_stripCache.size())
+		_stripCache.resize(stripnr + 1);
+
+	StripCacheEntry &entry = _stripCache[stripnr];
+	entry.bitmap = ptr;
+	entry.y = y;
+	entry.height = height;
+	entry.numZBuffer = numzbuf;
+
+	entry.pixels.resize(8 * height);
+	byte *dst = entry.pixels.data();
+	for (int h = 0; h < height; h++) {
+		memcpy(dst, dstPtr, 8);
+		dstPtr += vs->pitch;
+		dst += 8;
+	}
+
+	entry.masks.resize(MAX(numzbuf - 1, 0) * height);
+	dst = entry.masks.data();
+	for (int i = 1; i < numzbuf; i++, dst += height) {
+		if (!zplane_list[i])
+			continue;
+
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			dst[h] = mask_ptr[h * _numStrips];
+	}
+}
+
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
 	// Do some input verification and make sure the strip/strip offset
@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -304,6 +305,27 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * A strip of the room background, as left by drawStrip() and
+	 * decodeMask(). Redrawing the same strip, e.g. when scrolling back and
+	 * forth, then only copies it instead of decompressing it again.
+	 */
+	struct StripCacheEntry {
+		const byte *bitmap;
+		int y, height;
+		int numZBuffer;
+		Common::Array<byte> pixels;
+		Common::Array<byte> masks;
+
+		StripCacheEntry() : bitmap(nullptr), y(0), height(0), numZBuffer(0) {}
+	};
+
+	bool _stripCacheEnabled;
+	Common::Array<StripCacheEntry> _stripCache;
+	/** The room palette the cached strips were decompressed with. */
+	byte _stripCachePalette[256];
+	uint32 _stripCacheHits, _stripCacheMisses;
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -351,6 +373,18 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip);
 
+	/**
+	 * Whether the room background strips can be cached. The decoders which
+	 * already decode the whole room in roomChanged() do not need it.
+	 */
+	virtual bool canCacheStrips() const { return true; }
+
+	const StripCacheEntry *findCachedStrip(const byte *ptr, int stripnr, int y, int height, int numzbuf);
+	void drawCachedStrip(const StripCacheEntry &entry, byte *dstPtr, VirtScreen *vs, int x, int y,
+	                int numzbuf, const byte *zplane_list[9]);
+	void cacheStrip(const byte *ptr, const byte *dstPtr, VirtScreen *vs, int x, int y, int height,
+	                int stripnr, int numzbuf, const byte *zplane_list[9]);
+
 public:
 	Gdi(ScummEngine *vm);
 	virtual ~Gdi();
@@ -377,10 +411,17 @@ public:
 
 	void resetBackground(int top, int bottom, int strip);
 
+	void enableStripCache(bool enable);
+	bool isStripCacheEnabled() const { return _stripCacheEnabled; }
+	void invalidateStripCache();
+	uint32 getStripCacheHits() const { return _stripCacheHits; }
+	uint32 getStripCacheMisses() const { return _stripCacheMisses; }
+
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbCacheStrips   = 1 << 4	// Only used for the room background
 	};
 };
 
@@ -431,6 +472,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiNES(ScummEngine *vm);
 
@@ -474,6 +517,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiPCEngine(ScummEngine *vm);
 	~GdiPCEngine() override;
@@ -513,6 +558,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiV1(ScummEngine *vm);
 
@@ -542,6 +589,8 @@ protected:
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
 
+	bool canCacheStrips() const override { return false; }
+
 public:
 	GdiV2(ScummEngine *vm);
 	~GdiV2() override;
@@ -23,6 +23,8 @@
 
 #include "common/scummsys.h"
 
+#include "graphics/surface.h"
+
 #include "scumm/he/animation_he.h"
 #include "scumm/he/intern_he.h"
 
@@ -75,6 +77,9 @@ int MoviePlayer::load(const Common::Path &filename, int flags, int image) {
 
 	_video->start();
 
+	// Decode the next frames on the worker threads while one is shown
+	_video->setDecodeAhead(2);
+
 	debug(1, "Playing video %s", filename.toString().c_str());
 
 	int bitsPerPixel = (_vm->_game.features & GF_16BIT_COLOR) ? 16 : 8;
@@ -90,6 +95,22 @@ void MoviePlayer::copyFrameToBuffer(byte *dst, int dstType, uint x, uint y, uint
 	uint h = _video->getHeight();
 	uint w = _video->getWidth();
 
+	// Bink videos are converted from YUV straight into the buffer, instead
+	// of into a frame of their own which is copied afterwards, unless they
+	// are decoded ahead
+	bool decodeInto = (_vm->_game.features & GF_16BIT_COLOR) && _video->getPixelFormat().bytesPerPixel == 2;
+#ifdef SCUMM_BIG_ENDIAN
+	// Resources hold little endian pixels
+	decodeInto &= (dstType == kDstScreen);
+#endif
+
+	if (decodeInto) {
+		Graphics::Surface dstSurface;
+		dstSurface.init(w, h, pitch, dst + y * pitch + x * 2, _video->getPixelFormat());
+		_video->decodeNextFrameInto(dstSurface);
+		return;
+	}
+
 	const Graphics::Surface *surface = _video->decodeNextFrame();
 
 	if (!surface)
@@ -36,6 +36,7 @@
 #include "audio/decoders/flac.h"
 #include "audio/mididrv.h"
 #include "audio/mixer.h"
+#include "audio/soundcache.h"
 #include "audio/decoders/mp3.h"
 #include "audio/decoders/raw.h"
 #include "audio/decoders/voc.h"
@@ -448,6 +449,20 @@ static int compareMP3OffsetTable(const void *a, const void *b) {
 	return ((const MP3OffsetTable *)a)->org_offset - ((const MP3OffsetTable *)b)->org_offset;
 }
 
+#if defined(USE_FLAC) || defined(USE_VORBIS) || defined(USE_MAD)
+static Audio::AudioStream *makeCompressedSfxStream(Audio::SoundCacheManager::DecoderFunc decoder, Common::SeekableReadStream *file,
+												   const Common::String &filename, uint32 offset, uint32 size, bool cacheable) {
+	Common::SeekableReadStream *stream = new Common::SeekableSubReadStream(file, offset, offset + size, DisposeAfterUse::YES);
+
+	// Sound effects are played over and over again, so keep them decoded.
+	// Speech is rarely repeated and would only push them out of the cache.
+	if (cacheable)
+		return SoundCacheMan.makeStream(Common::Path(filename), offset, stream, DisposeAfterUse::YES, decoder);
+
+	return decoder(stream, DisposeAfterUse::YES);
+}
+#endif
+
 static Audio::AudioStream *checkForBrokenIndy4Sample(Common::SeekableReadStream *file, uint32 offset) {
 	byte vocHeader[32];
 
@@ -746,7 +761,7 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 #ifdef USE_MAD
 			{
 			assert(size > 0);
-			input = Audio::makeMP3Stream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+			input = makeCompressedSfxStream(Audio::makeMP3Stream, file.release(), _sfxFilename, offset, size, mode == DIGI_SND_MODE_SFX);
 			}
 #endif
 			break;
@@ -754,7 +769,7 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 #ifdef USE_VORBIS
 			{
 			assert(size > 0);
-			input = Audio::makeVorbisStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+			input = makeCompressedSfxStream(Audio::makeVorbisStream, file.release(), _sfxFilename, offset, size, mode == DIGI_SND_MODE_SFX);
 			}
 #endif
 			break;
@@ -762,7 +777,7 @@ void Sound::startTalkSound(uint32 offset, uint32 length, int mode, Audio::SoundH
 #ifdef USE_FLAC
 			{
 			assert(size > 0);
-			input = Audio::makeFLACStream(new Common::SeekableSubReadStream(file.release(), offset, offset + size, DisposeAfterUse::YES), DisposeAfterUse::YES);
+			input = makeCompressedSfxStream(Audio::makeFLACStream, file.release(), _sfxFilename, offset, size, mode == DIGI_SND_MODE_SFX);
 			}
 #endif
 			break;
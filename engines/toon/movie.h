@@ -45,6 +45,8 @@ public:
 
 protected:
 	void handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize) override;
+	// handleAudioTrack() sets the resolution reported by isLowRes()
+	bool supportsDecodeAhead() const override { return false; }
 	SmackerVideoTrack *createVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, uint32 flags, uint32 version) const override;
 
 private:
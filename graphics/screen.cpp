@@ -26,15 +26,18 @@
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+Screen::Screen(): ManagedSurface(),
+		_dirtyTileSize(0), _dirtyTilesWidth(0), _dirtyTilesHeight(0), _hasDirtyTiles(false) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(),
+		_dirtyTileSize(0), _dirtyTilesWidth(0), _dirtyTilesHeight(0), _hasDirtyTiles(false) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(),
+		_dirtyTileSize(0), _dirtyTilesWidth(0), _dirtyTilesHeight(0), _hasDirtyTiles(false) {
 	create(width, height, pixelFormat);
 }
 
@@ -42,18 +45,17 @@ void Screen::update() {
 	// Merge the dirty rects
 	mergeDirtyRects();
 
-	// Loop through copying dirty areas to the physical screen
-	Common::List<Common::Rect>::iterator i;
-	for (i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
-		const Common::Rect &r = *i;
-		const byte *srcP = (const byte *)getBasePtr(r.left, r.top);
-		g_system->copyRectToScreen(srcP, pitch, r.left, r.top,
-			r.width(), r.height());
-	}
+	// Copy the dirty areas to the physical screen at once
+	getDirtyTileRects(_updateRects);
+	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
+		_updateRects.push_back(*i);
+
+	if (!_updateRects.empty())
+		g_system->copyRectsToScreen(getPixels(), pitch, _updateRects.data(), _updateRects.size());
 
 	// Signal the physical screen to update
 	updateScreen();
-	_dirtyRects.clear();
+	clearDirtyRects();
 }
 
 void Screen::updateScreen() {
@@ -66,15 +68,112 @@ void Screen::addDirtyRect(const Common::Rect &r) {
 	bounds.clip(getBounds());
 	bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
 
-	if (bounds.width() > 0 && bounds.height() > 0)
+	if (bounds.width() <= 0 || bounds.height() <= 0)
+		return;
+
+	if (!_dirtyTileSize) {
 		_dirtyRects.push_back(bounds);
+		return;
+	}
+
+	// The screen may have been recreated with another size
+	const int tilesWidth = (this->w + _dirtyTileSize - 1) / _dirtyTileSize;
+	const int tilesHeight = (this->h + _dirtyTileSize - 1) / _dirtyTileSize;
+	if (tilesWidth != _dirtyTilesWidth || tilesHeight != _dirtyTilesHeight) {
+		_dirtyTilesWidth = tilesWidth;
+		_dirtyTilesHeight = tilesHeight;
+		_dirtyTiles.clear();
+		_dirtyTiles.resize(tilesWidth * tilesHeight);
+		_hasDirtyTiles = false;
+	}
+
+	const int left = bounds.left / _dirtyTileSize;
+	const int top = bounds.top / _dirtyTileSize;
+	const int right = MIN((bounds.right + _dirtyTileSize - 1) / _dirtyTileSize, _dirtyTilesWidth);
+	const int bottom = MIN((bounds.bottom + _dirtyTileSize - 1) / _dirtyTileSize, _dirtyTilesHeight);
+	if (left >= right || top >= bottom)
+		return;
+
+	for (int y = top; y < bottom; y++)
+		memset(&_dirtyTiles[y * _dirtyTilesWidth + left], 1, right - left);
+
+	_hasDirtyTiles = true;
 }
 
-void Screen::makeAllDirty() {
+void Screen::clearDirtyRects() {
 	_dirtyRects.clear();
+
+	if (_hasDirtyTiles) {
+		memset(_dirtyTiles.data(), 0, _dirtyTiles.size());
+		_hasDirtyTiles = false;
+	}
+}
+
+void Screen::makeAllDirty() {
+	clearDirtyRects();
 	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
+void Screen::setDirtyTileSize(int tileSize) {
+	if (tileSize == _dirtyTileSize)
+		return;
+
+	const bool dirty = isDirty();
+	clearDirtyRects();
+
+	_dirtyTileSize = tileSize;
+	_dirtyTilesWidth = _dirtyTilesHeight = 0;
+	_dirtyTiles.clear();
+
+	// The areas already affected are not carried over one by one
+	if (dirty)
+		makeAllDirty();
+}
+
+void Screen::getDirtyTileRects(Common::Array<Common::Rect> &rects) {
+	rects.clear();
+	if (!_hasDirtyTiles)
+		return;
+
+	// The rectangle ending on the row of tiles above, by first column
+	_tileRectsAbove.resize(_dirtyTilesWidth);
+	_tileRectsRow.resize(_dirtyTilesWidth);
+	Common::fill(_tileRectsAbove.begin(), _tileRectsAbove.end(), -1);
+
+	for (int y = 0; y < _dirtyTilesHeight; y++) {
+		const byte *tiles = &_dirtyTiles[y * _dirtyTilesWidth];
+		const int16 top = y * _dirtyTileSize;
+		const int16 bottom = MIN<int>(top + _dirtyTileSize, this->h);
+		Common::fill(_tileRectsRow.begin(), _tileRectsRow.end(), -1);
+
+		for (int x = 0; x < _dirtyTilesWidth;) {
+			if (!tiles[x]) {
+				x++;
+				continue;
+			}
+
+			const int start = x;
+			while (x < _dirtyTilesWidth && tiles[x])
+				x++;
+
+			const int16 left = start * _dirtyTileSize;
+			const int16 right = MIN<int>(x * _dirtyTileSize, this->w);
+
+			int index = _tileRectsAbove[start];
+			if (index >= 0 && rects[index].right == right) {
+				rects[index].bottom = bottom;
+			} else {
+				index = rects.size();
+				rects.push_back(Common::Rect(left, top, right, bottom));
+			}
+
+			_tileRectsRow[start] = index;
+		}
+
+		_tileRectsAbove.swap(_tileRectsRow);
+	}
+}
+
 void Screen::mergeDirtyRects() {
 	Common::List<Common::Rect>::iterator rOuter, rInner;
 
@@ -25,6 +25,7 @@
 #include "graphics/managed_surface.h"
 #include "graphics/palette.h"
 #include "graphics/pixelformat.h"
+#include "common/array.h"
 #include "common/list.h"
 #include "common/rect.h"
 
@@ -51,6 +52,25 @@ protected:
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
+
+	/**
+	 * Size in pixels of the tiles tracking the affected areas, or 0 if they
+	 * are tracked with the list of rectangles
+	 */
+	int _dirtyTileSize;
+
+	/**
+	 * Whether each tile is affected, by rows of tiles
+	 */
+	Common::Array<byte> _dirtyTiles;
+	int _dirtyTilesWidth, _dirtyTilesHeight;
+	bool _hasDirtyTiles;
+
+	/**
+	 * The rectangles passed to the system by update(), kept to reuse their storage
+	 */
+	Common::Array<Common::Rect> _updateRects;
+	Common::Array<int> _tileRectsAbove, _tileRectsRow;
 protected:
 	/**
 	 * Merges together overlapping dirty areas of the screen
@@ -61,6 +81,13 @@ protected:
 	 * Returns the union of two dirty area rectangles
 	 */
 	bool unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2);
+
+	/**
+	 * Returns the affected tiles as rectangles. Each row of tiles is split
+	 * into spans of affected tiles, and the spans which are the same as on
+	 * the row above are merged with it
+	 */
+	void getDirtyTileRects(Common::Array<Common::Rect> &rects);
 public:
 	Screen();
 	Screen(int width, int height);
@@ -69,7 +96,7 @@ public:
 	/**
 	 * Returns true if there are any pending screen updates (dirty areas)
 	 */
-	bool isDirty() const { return !_dirtyRects.empty(); }
+	bool isDirty() const { return !_dirtyRects.empty() || _hasDirtyTiles; }
 
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
@@ -80,7 +107,20 @@ public:
 	/**
 	 * Clear the current dirty rects list
 	 */
-	virtual void clearDirtyRects() { _dirtyRects.clear(); }
+	virtual void clearDirtyRects();
+
+	/**
+	 * Set the size of the tiles used to track the affected areas.
+	 *
+	 * By default, the affected areas are kept as a list of rectangles,
+	 * which are merged when they overlap. Screens drawing many small areas
+	 * each frame can instead mark them in a grid of tiles, which costs the
+	 * same whatever the number of areas, but updates whole tiles.
+	 *
+	 * @param tileSize The width and height of the tiles in pixels, or 0 to
+	 *                 use the list of rectangles
+	 */
+	void setDirtyTileSize(int tileSize);
 
 	/**
 	 * Adds a rectangle to the list of modified areas of the screen during the
@@ -82,8 +82,12 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/array.h"
+#include "common/system.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -91,22 +95,6 @@ DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 
 namespace Graphics {
 
-class YUVToRGBLookup {
-public:
-	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
-
-	Graphics::PixelFormat getFormat() const { return _format; }
-	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
-	const int16 *getColorTable() const { return _colorTab; }
-	const byte *getClipTable() const { return _clipTable; }
-
-private:
-	Graphics::PixelFormat _format;
-	YUVToRGBManager::LuminanceScale _scale;
-	int16 _colorTab[4 * 256]; // 2048 bytes
-	byte _clipTable[3 * 768];
-};
-
 YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
 	_format = format;
 	_scale = scale;
@@ -118,6 +106,10 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 	uint b_offset = (format.bLoss == format.gLoss) ? g_offset :
 	                (format.bLoss == format.rLoss) ? r_offset : g_offset + 768;
 
+	_tableOffsets[0] = r_offset + 256;
+	_tableOffsets[1] = g_offset + 256;
+	_tableOffsets[2] = b_offset + 256;
+
 	byte *r_2_pix_alloc = &_clipTable[r_offset];
 	byte *g_2_pix_alloc = &_clipTable[g_offset];
 	byte *b_2_pix_alloc = &_clipTable[b_offset];
@@ -182,26 +174,135 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 }
 
 YUVToRGBManager::YUVToRGBManager() {
-	_lookup = 0;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
-	delete _lookup;
+	for (uint i = 0; i < _lookups.size(); i++)
+		delete _lookups[i];
 }
 
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
-	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
-		return _lookup;
+	Common::StackLock lock(_lookupMutex);
 
-	delete _lookup;
-	_lookup = new YUVToRGBLookup(format, scale);
-	return _lookup;
+	for (uint i = 0; i < _lookups.size(); i++) {
+		if (_lookups[i]->getFormat() == format && _lookups[i]->getScale() == scale)
+			return _lookups[i];
+	}
+
+	_lookups.push_back(new YUVToRGBLookup(format, scale));
+	return _lookups.back();
 }
 
 #define PUT_PIXEL(s, d) \
 	L = &clipTable[(s)]; \
 	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | a_mask)
 
+#define PUT_PIXELA(s, a, d) \
+	L = &clipTable[(s)]; \
+	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
+
+YUVToRGBRowConverter::ConvertFunc YUVToRGBRowConverter::convertFunc = nullptr;
+
+void YUVToRGBRowConverter::selectConvertFunc() {
+	convertFunc = convertNone;
+#ifdef SCUMMVM_NEON
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON)) convertFunc = convertNEON;
+#endif
+#ifdef SCUMMVM_SSE2
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2)) convertFunc = convertSSE2;
+#endif
+#ifdef SCUMMVM_AVX2
+	if (g_system->hasFeature(OSystem::kFeatureCpuAVX2)) convertFunc = convertAVX2;
+#endif
+}
+
+/**
+ * Convert the pixels of a row from @p start on with the tables, after
+ * the SIMD converter did the rest.
+ */
+template<typename PixelInt>
+void convertRowRemainder(const YUVToRGBLookup *lookup, const YUVToRGBRow &row, int start) {
+	const byte *clipTable = lookup->getClipTable();
+
+	const byte r_shift = lookup->getFormat().rShift;
+	const byte g_shift = lookup->getFormat().gShift;
+	const byte b_shift = lookup->getFormat().bShift;
+	const byte a_shift = lookup->getFormat().aShift;
+	const byte a_loss = lookup->getFormat().aLoss;
+	const PixelInt a_mask = (0xFF >> a_loss) << a_shift;
+
+	byte *dstPtr = row.dst + start * sizeof(PixelInt);
+
+	for (int x = start; x < row.width; x++) {
+		const byte *L;
+
+		const int chroma = row.halfChroma ? (x >> 1) : x;
+		int16 cr_r  = row.crR[chroma];
+		int16 crb_g = row.crbG[chroma];
+		int16 cb_b  = row.cbB[chroma];
+
+		if (row.aSrc) {
+			PUT_PIXELA(row.ySrc[x], row.aSrc[x], dstPtr);
+		} else {
+			PUT_PIXEL(row.ySrc[x], dstPtr);
+		}
+		dstPtr += sizeof(PixelInt);
+	}
+}
+
+template<typename PixelInt>
+void convertRow(YUVToRGBRowConverter::ConvertFunc convertFunc, const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	convertRowRemainder<PixelInt>(lookup, row, convertFunc(lookup, row));
+}
+
+/**
+ * Look up the table entries for a row of chroma samples.
+ */
+static void lookupChroma(const YUVToRGBLookup *lookup, int16 *crR, int16 *crbG, int16 *cbB, const byte *uSrc, const byte *vSrc, int width) {
+	const int16 *Cr_r_tab = lookup->getColorTable();
+	const int16 *Cr_g_tab = Cr_r_tab + 256;
+	const int16 *Cb_g_tab = Cr_g_tab + 256;
+	const int16 *Cb_b_tab = Cb_g_tab + 256;
+
+	for (int x = 0; x < width; x++) {
+		crR[x]  = Cr_r_tab[vSrc[x]];
+		crbG[x] = Cr_g_tab[vSrc[x]] + Cb_g_tab[uSrc[x]];
+		cbB[x]  = Cb_b_tab[uSrc[x]];
+	}
+}
+
+/**
+ * Convert an image with the SIMD converter, looking up each row of chroma
+ * samples once for all the rows of pixels sharing it.
+ *
+ * @param chromaShiftX	log2 of the horizontal chroma subsampling, 0 or 1
+ * @param chromaShiftY	log2 of the vertical chroma subsampling, 0 or 1
+ */
+template<typename PixelInt>
+void convertYUVToRGBRows(YUVToRGBRowConverter::ConvertFunc convertFunc, byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch, int chromaShiftX, int chromaShiftY) {
+	const int chromaWidth = yWidth >> chromaShiftX;
+	Common::Array<int16> chroma(chromaWidth * 3);
+
+	YUVToRGBRow row;
+	row.crR = &chroma[0];
+	row.crbG = &chroma[chromaWidth];
+	row.cbB = &chroma[chromaWidth * 2];
+	row.width = yWidth;
+	row.halfChroma = chromaShiftX != 0;
+
+	for (int y = 0; y < yHeight; y++) {
+		if ((y & ((1 << chromaShiftY) - 1)) == 0) {
+			const int offset = (y >> chromaShiftY) * uvPitch;
+			lookupChroma(lookup, &chroma[0], &chroma[chromaWidth], &chroma[chromaWidth * 2], uSrc + offset, vSrc + offset, chromaWidth);
+		}
+
+		row.dst = dstPtr + y * dstPitch;
+		row.ySrc = ySrc + y * yPitch;
+		row.aSrc = aSrc ? aSrc + y * yPitch : nullptr;
+		convertRow<PixelInt>(convertFunc, lookup, row);
+	}
+}
+
 template<typename PixelInt>
 void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
@@ -245,6 +346,15 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowConverter::ConvertFunc convertFunc = YUVToRGBRowConverter::getConvertFunc();
+
+	if (convertFunc) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUVToRGBRows<uint16>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 0, 0);
+		else
+			convertYUVToRGBRows<uint32>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 0, 0);
+		return;
+	}
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
@@ -302,6 +412,15 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowConverter::ConvertFunc convertFunc = YUVToRGBRowConverter::getConvertFunc();
+
+	if (convertFunc) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUVToRGBRows<uint16>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 0);
+		else
+			convertYUVToRGBRows<uint32>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 0);
+		return;
+	}
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
@@ -363,6 +482,15 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowConverter::ConvertFunc convertFunc = YUVToRGBRowConverter::getConvertFunc();
+
+	if (convertFunc) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUVToRGBRows<uint16>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		else
+			convertYUVToRGBRows<uint32>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, nullptr, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		return;
+	}
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
@@ -371,10 +499,6 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
-#define PUT_PIXELA(s, a, d) \
-	L = &clipTable[(s)]; \
-	*((PixelInt *)(d)) = ((L[cr_r] << r_shift) | (L[crb_g] << g_shift) | (L[cb_b] << b_shift) | ((a >> a_loss) << a_shift))
-
 template<typename PixelInt>
 void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfHeight = yHeight >> 1;
@@ -432,6 +556,15 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowConverter::ConvertFunc convertFunc = YUVToRGBRowConverter::getConvertFunc();
+
+	if (convertFunc) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUVToRGBRows<uint16>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		else
+			convertYUVToRGBRows<uint32>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch, 1, 1);
+		return;
+	}
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
@@ -510,6 +643,54 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
+/**
+ * Convert a YUV410 image with the SIMD converter. The chroma is
+ * interpolated for each pixel like above, and looked up for each row.
+ */
+template<typename PixelInt>
+void convertYUV410ToRGBRows(YUVToRGBRowConverter::ConvertFunc convertFunc, byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	Common::Array<byte> uv(yWidth * 2);
+	Common::Array<int16> chroma(yWidth * 3);
+
+	YUVToRGBRow row;
+	row.aSrc = nullptr;
+	row.crR = &chroma[0];
+	row.crbG = &chroma[yWidth];
+	row.cbB = &chroma[yWidth * 2];
+	row.width = yWidth;
+	row.halfChroma = false;
+
+	int quarterWidth = yWidth >> 2;
+
+	for (int y = 0; y < yHeight; y++) {
+		byte *uRow = &uv[0];
+		byte *vRow = &uv[yWidth];
+
+		for (int x = 0; x < quarterWidth; x++) {
+			int targetY = y >> 2;
+			int yDiff = y & 3;
+			int index = targetY * uvPitch + x;
+
+			READ_QUAD(uSrc, u);
+			READ_QUAD(vSrc, v);
+
+			for (int xDiff = 0; xDiff < 4; xDiff++) {
+				byte u, v;
+				DO_INTERPOLATION(u);
+				DO_INTERPOLATION(v);
+				*uRow++ = u;
+				*vRow++ = v;
+			}
+		}
+
+		lookupChroma(lookup, &chroma[0], &chroma[yWidth], &chroma[yWidth * 2], &uv[0], &uv[yWidth], yWidth);
+
+		row.dst = dstPtr + y * dstPitch;
+		row.ySrc = ySrc + y * yPitch;
+		convertRow<PixelInt>(convertFunc, lookup, row);
+	}
+}
+
 #undef READ_QUAD
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
@@ -523,6 +704,15 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yHeight & 3) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBRowConverter::ConvertFunc convertFunc = YUVToRGBRowConverter::getConvertFunc();
+
+	if (convertFunc) {
+		if (dst->format.bytesPerPixel == 2)
+			convertYUV410ToRGBRows<uint16>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV410ToRGBRows<uint32>(convertFunc, (byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		return;
+	}
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
@@ -38,6 +38,8 @@
 #define GRAPHICS_YUV_TO_RGB_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
+#include "common/mutex.h"
 #include "common/singleton.h"
 #include "graphics/surface.h"
 
@@ -45,6 +47,12 @@ namespace Graphics {
 
 class YUVToRGBLookup;
 
+/**
+ * Converts YUV images into RGB surfaces.
+ *
+ * The conversion functions may be called from several threads at once, for
+ * instance to convert the parts of a frame in parallel.
+ */
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
 	/** The scale of the luminance values */
@@ -142,7 +150,9 @@ private:
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
-	YUVToRGBLookup *_lookup;
+	/** The lookups for all the formats used, which stay valid until the manager is destroyed. */
+	Common::Array<YUVToRGBLookup *> _lookups;
+	Common::Mutex _lookupMutex;
 };
  /** @} */
 } // End of namespace Graphics
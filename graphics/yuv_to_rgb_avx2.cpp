@@ -0,0 +1,143 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+namespace Graphics {
+
+/**
+ * Clip sixteen luminance values with the chroma added, and scale them to
+ * [0, 255] like the clip tables do.
+ */
+static FORCEINLINE __m256i avx2_clip(__m256i value, bool itu) {
+	if (itu) {
+		value = _mm256_min_epi16(_mm256_max_epi16(value, _mm256_set1_epi16(16)), _mm256_set1_epi16(235));
+		value = _mm256_sub_epi16(value, _mm256_set1_epi16(16));
+		return _mm256_add_epi16(value, _mm256_mulhi_epu16(value, _mm256_set1_epi16(YUVToRGBRowConverter::kITUScale)));
+	}
+
+	return _mm256_min_epi16(_mm256_max_epi16(value, _mm256_setzero_si256()), _mm256_set1_epi16(255));
+}
+
+static FORCEINLINE __m256i avx2_loadChroma(const int16 *src, int x, bool halfChroma) {
+	if (halfChroma) {
+		const __m128i chroma = _mm_loadu_si128((const __m128i *)(src + x / 2));
+		return _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_unpacklo_epi16(chroma, chroma)), _mm_unpackhi_epi16(chroma, chroma), 1);
+	}
+
+	return _mm256_loadu_si256((const __m256i *)(src + x));
+}
+
+/** Widen eight 16-bit channel values to 32 bits, and shift them into place. */
+static FORCEINLINE __m256i avx2_place(__m128i value, __m128i shift) {
+	return _mm256_sll_epi32(_mm256_cvtepu16_epi32(value), shift);
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha>
+static int convertRowAVX2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	const Graphics::PixelFormat &format = lookup->getFormat();
+	const bool itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	const uint32 aMask = (0xFF >> format.aLoss) << format.aShift;
+
+	const __m256i rOffset = _mm256_set1_epi16(lookup->getTableOffsets()[0]);
+	const __m256i gOffset = _mm256_set1_epi16(lookup->getTableOffsets()[1]);
+	const __m256i bOffset = _mm256_set1_epi16(lookup->getTableOffsets()[2]);
+	const __m128i rLoss = _mm_cvtsi32_si128(format.rLoss);
+	const __m128i gLoss = _mm_cvtsi32_si128(format.gLoss);
+	const __m128i bLoss = _mm_cvtsi32_si128(format.bLoss);
+	const __m128i aLoss = _mm_cvtsi32_si128(format.aLoss);
+	const __m128i rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(format.bShift);
+	const __m128i aShift = _mm_cvtsi32_si128(format.aShift);
+
+	int x = 0;
+	for (; x + 16 <= row.width; x += 16) {
+		const __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(row.ySrc + x)));
+
+		__m256i r = _mm256_sub_epi16(avx2_loadChroma(row.crR, x, halfChroma), rOffset);
+		__m256i g = _mm256_sub_epi16(avx2_loadChroma(row.crbG, x, halfChroma), gOffset);
+		__m256i b = _mm256_sub_epi16(avx2_loadChroma(row.cbB, x, halfChroma), bOffset);
+		r = _mm256_srl_epi16(avx2_clip(_mm256_add_epi16(y, r), itu), rLoss);
+		g = _mm256_srl_epi16(avx2_clip(_mm256_add_epi16(y, g), itu), gLoss);
+		b = _mm256_srl_epi16(avx2_clip(_mm256_add_epi16(y, b), itu), bLoss);
+
+		__m256i a = _mm256_setzero_si256();
+		if (alpha)
+			a = _mm256_srl_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(row.aSrc + x))), aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			__m256i pixels = _mm256_or_si256(_mm256_sll_epi16(r, rShift), _mm256_sll_epi16(g, gShift));
+			pixels = _mm256_or_si256(pixels, _mm256_sll_epi16(b, bShift));
+			pixels = _mm256_or_si256(pixels, alpha ? _mm256_sll_epi16(a, aShift) : _mm256_set1_epi16((int16)aMask));
+			_mm256_storeu_si256((__m256i *)(row.dst + x * 2), pixels);
+		} else {
+			// The 128-bit halves hold pixels 0-7 and 8-15
+			__m256i pixels0 = _mm256_or_si256(avx2_place(_mm256_castsi256_si128(r), rShift), avx2_place(_mm256_castsi256_si128(g), gShift));
+			__m256i pixels1 = _mm256_or_si256(avx2_place(_mm256_extracti128_si256(r, 1), rShift), avx2_place(_mm256_extracti128_si256(g, 1), gShift));
+			pixels0 = _mm256_or_si256(pixels0, avx2_place(_mm256_castsi256_si128(b), bShift));
+			pixels1 = _mm256_or_si256(pixels1, avx2_place(_mm256_extracti128_si256(b, 1), bShift));
+			if (alpha) {
+				pixels0 = _mm256_or_si256(pixels0, avx2_place(_mm256_castsi256_si128(a), aShift));
+				pixels1 = _mm256_or_si256(pixels1, avx2_place(_mm256_extracti128_si256(a, 1), aShift));
+			} else {
+				pixels0 = _mm256_or_si256(pixels0, _mm256_set1_epi32(aMask));
+				pixels1 = _mm256_or_si256(pixels1, _mm256_set1_epi32(aMask));
+			}
+			_mm256_storeu_si256((__m256i *)(row.dst + x * 4), pixels0);
+			_mm256_storeu_si256((__m256i *)(row.dst + x * 4 + 32), pixels1);
+		}
+	}
+
+	return x;
+}
+
+template<typename PixelInt>
+static int convertRowAVX2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	if (row.halfChroma)
+		return row.aSrc ? convertRowAVX2<PixelInt, true, true>(lookup, row) : convertRowAVX2<PixelInt, true, false>(lookup, row);
+	return row.aSrc ? convertRowAVX2<PixelInt, false, true>(lookup, row) : convertRowAVX2<PixelInt, false, false>(lookup, row);
+}
+
+int YUVToRGBRowConverter::convertAVX2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	if (lookup->getFormat().bytesPerPixel == 2)
+		return convertRowAVX2<uint16>(lookup, row);
+	return convertRowAVX2<uint32>(lookup, row);
+}
+
+} // End of namespace Graphics
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
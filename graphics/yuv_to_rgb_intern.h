@@ -0,0 +1,125 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite;
+class YUVToRGBBenchmarkSuite;
+
+namespace Graphics {
+
+class YUVToRGBLookup {
+public:
+	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale);
+
+	Graphics::PixelFormat getFormat() const { return _format; }
+	YUVToRGBManager::LuminanceScale getScale() const { return _scale; }
+	const int16 *getColorTable() const { return _colorTab; }
+	const byte *getClipTable() const { return _clipTable; }
+
+	/**
+	 * Return the offsets of the red, green and blue clip tables included in
+	 * the color table entries.
+	 */
+	const int16 *getTableOffsets() const { return _tableOffsets; }
+
+private:
+	Graphics::PixelFormat _format;
+	YUVToRGBManager::LuminanceScale _scale;
+	int16 _colorTab[4 * 256]; // 2048 bytes
+	byte _clipTable[3 * 768];
+	int16 _tableOffsets[3];
+};
+
+/**
+ * A row of pixels to convert. The chroma has already been looked up in the
+ * color tables, so the entries are those the table code adds to the
+ * luminance.
+ */
+struct YUVToRGBRow {
+	byte *dst;
+	const byte *ySrc;
+	const byte *aSrc;   ///< The alpha values, or nullptr for opaque pixels
+	const int16 *crR;   ///< Cr_r_tab[v] for each chroma sample
+	const int16 *crbG;  ///< Cr_g_tab[v] + Cb_g_tab[u] for each chroma sample
+	const int16 *cbB;   ///< Cb_b_tab[u] for each chroma sample
+	int width;
+	bool halfChroma;    ///< Whether there is one chroma sample for two pixels
+};
+
+/**
+ * Converts rows of pixels with SIMD instructions when the CPU supports
+ * them.
+ *
+ * Unlike the tables, the SIMD variants compute the clipping and scaling of
+ * the luminance, in a way which gives the same results bit for bit. They
+ * convert as many whole vectors as they can; the rest of the row is
+ * converted with the tables.
+ */
+class YUVToRGBRowConverter {
+public:
+	/**
+	 * Convert the start of @p row, and return the number of pixels
+	 * converted. This is always even.
+	 */
+	typedef int (*ConvertFunc)(const YUVToRGBLookup *lookup, const YUVToRGBRow &row);
+
+	/** Return the SIMD converter for the CPU, or nullptr if there is none. */
+	static ConvertFunc getConvertFunc() {
+		if (!convertFunc)
+			selectConvertFunc();
+		return convertFunc == convertNone ? nullptr : convertFunc;
+	}
+
+	/**
+	 * Multiplier for scaling the ITU-R BT.601 luminance range: for y in
+	 * [0, 219], y * 255 / 219 == y + ((y * kITUScale) >> 16).
+	 */
+	static const int kITUScale = 10776;
+
+private:
+	static ConvertFunc convertFunc;
+
+	static void selectConvertFunc();
+
+	static int convertNone(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+		return 0;
+	}
+#ifdef SCUMMVM_NEON
+	static int convertNEON(const YUVToRGBLookup *lookup, const YUVToRGBRow &row);
+#endif
+#ifdef SCUMMVM_SSE2
+	static int convertSSE2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row);
+#endif
+#ifdef SCUMMVM_AVX2
+	static int convertAVX2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row);
+#endif
+
+	friend class ::YUVToRGBTestSuite;
+	friend class ::YUVToRGBBenchmarkSuite;
+};
+
+} // End of namespace Graphics
+
+#endif
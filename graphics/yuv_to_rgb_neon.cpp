@@ -0,0 +1,160 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#ifdef SCUMMVM_NEON
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <arm_neon.h>
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("neon"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("fpu=neon")
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+namespace Graphics {
+
+/**
+ * Clip eight luminance values with the chroma added, and scale them to
+ * [0, 255] like the clip tables do.
+ */
+static inline uint16x8_t neon_clip(int16x8_t value, bool itu) {
+	if (itu) {
+		value = vminq_s16(vmaxq_s16(value, vdupq_n_s16(16)), vdupq_n_s16(235));
+		value = vsubq_s16(value, vdupq_n_s16(16));
+		// vqdmulh doubles the product, and cannot saturate with these values
+		value = vaddq_s16(value, vqdmulhq_s16(value, vdupq_n_s16(YUVToRGBRowConverter::kITUScale / 2)));
+	} else {
+		value = vminq_s16(vmaxq_s16(value, vdupq_n_s16(0)), vdupq_n_s16(255));
+	}
+
+	return vreinterpretq_u16_s16(value);
+}
+
+static inline int16x8_t neon_loadChroma(const int16 *src, int x, bool halfChroma) {
+	if (halfChroma) {
+		const int16x4_t chroma = vld1_s16(src + x / 2);
+		const int16x4x2_t doubled = vzip_s16(chroma, chroma);
+		return vcombine_s16(doubled.val[0], doubled.val[1]);
+	}
+
+	return vld1q_s16(src + x);
+}
+
+/** Convert eight 16-bit channel values to 32 bits, and shift them into place. */
+static inline uint32x4_t neon_place(uint16x4_t value, int32x4_t shift) {
+	return vshlq_u32(vmovl_u16(value), shift);
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha>
+static int convertRowNEON(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	const Graphics::PixelFormat &format = lookup->getFormat();
+	const bool itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	const uint32 aMask = (0xFF >> format.aLoss) << format.aShift;
+
+	const int16x8_t rOffset = vdupq_n_s16(lookup->getTableOffsets()[0]);
+	const int16x8_t gOffset = vdupq_n_s16(lookup->getTableOffsets()[1]);
+	const int16x8_t bOffset = vdupq_n_s16(lookup->getTableOffsets()[2]);
+	// Shifting by negative amounts shifts right
+	const int16x8_t rLoss = vdupq_n_s16(-format.rLoss);
+	const int16x8_t gLoss = vdupq_n_s16(-format.gLoss);
+	const int16x8_t bLoss = vdupq_n_s16(-format.bLoss);
+	const int16x8_t aLoss = vdupq_n_s16(-format.aLoss);
+
+	int x = 0;
+	for (; x + 8 <= row.width; x += 8) {
+		const int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row.ySrc + x)));
+
+		int16x8_t r = vsubq_s16(neon_loadChroma(row.crR, x, halfChroma), rOffset);
+		int16x8_t g = vsubq_s16(neon_loadChroma(row.crbG, x, halfChroma), gOffset);
+		int16x8_t b = vsubq_s16(neon_loadChroma(row.cbB, x, halfChroma), bOffset);
+		const uint16x8_t rValue = vshlq_u16(neon_clip(vaddq_s16(y, r), itu), rLoss);
+		const uint16x8_t gValue = vshlq_u16(neon_clip(vaddq_s16(y, g), itu), gLoss);
+		const uint16x8_t bValue = vshlq_u16(neon_clip(vaddq_s16(y, b), itu), bLoss);
+
+		uint16x8_t aValue = vdupq_n_u16(0);
+		if (alpha)
+			aValue = vshlq_u16(vmovl_u8(vld1_u8(row.aSrc + x)), aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			uint16x8_t pixels = vorrq_u16(vshlq_u16(rValue, vdupq_n_s16(format.rShift)), vshlq_u16(gValue, vdupq_n_s16(format.gShift)));
+			pixels = vorrq_u16(pixels, vshlq_u16(bValue, vdupq_n_s16(format.bShift)));
+			pixels = vorrq_u16(pixels, alpha ? vshlq_u16(aValue, vdupq_n_s16(format.aShift)) : vdupq_n_u16((uint16)aMask));
+			vst1q_u16((uint16 *)(row.dst + x * 2), pixels);
+		} else {
+			const int32x4_t rShift = vdupq_n_s32(format.rShift);
+			const int32x4_t gShift = vdupq_n_s32(format.gShift);
+			const int32x4_t bShift = vdupq_n_s32(format.bShift);
+
+			uint32x4_t pixels0 = vorrq_u32(neon_place(vget_low_u16(rValue), rShift), neon_place(vget_low_u16(gValue), gShift));
+			uint32x4_t pixels1 = vorrq_u32(neon_place(vget_high_u16(rValue), rShift), neon_place(vget_high_u16(gValue), gShift));
+			pixels0 = vorrq_u32(pixels0, neon_place(vget_low_u16(bValue), bShift));
+			pixels1 = vorrq_u32(pixels1, neon_place(vget_high_u16(bValue), bShift));
+			if (alpha) {
+				const int32x4_t aShift = vdupq_n_s32(format.aShift);
+				pixels0 = vorrq_u32(pixels0, neon_place(vget_low_u16(aValue), aShift));
+				pixels1 = vorrq_u32(pixels1, neon_place(vget_high_u16(aValue), aShift));
+			} else {
+				pixels0 = vorrq_u32(pixels0, vdupq_n_u32(aMask));
+				pixels1 = vorrq_u32(pixels1, vdupq_n_u32(aMask));
+			}
+			vst1q_u32((uint32 *)(row.dst + x * 4), pixels0);
+			vst1q_u32((uint32 *)(row.dst + x * 4 + 16), pixels1);
+		}
+	}
+
+	return x;
+}
+
+template<typename PixelInt>
+static int convertRowNEON(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	if (row.halfChroma)
+		return row.aSrc ? convertRowNEON<PixelInt, true, true>(lookup, row) : convertRowNEON<PixelInt, true, false>(lookup, row);
+	return row.aSrc ? convertRowNEON<PixelInt, false, true>(lookup, row) : convertRowNEON<PixelInt, false, false>(lookup, row);
+}
+
+int YUVToRGBRowConverter::convertNEON(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	if (lookup->getFormat().bytesPerPixel == 2)
+		return convertRowNEON<uint16>(lookup, row);
+	return convertRowNEON<uint32>(lookup, row);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__aarch64__) && !defined(__ARM_NEON)
+
+#endif // SCUMMVM_NEON
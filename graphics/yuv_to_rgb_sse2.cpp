@@ -0,0 +1,146 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("sse2"))), apply_to=function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#endif // !defined(__x86_64__)
+
+namespace Graphics {
+
+/**
+ * Clip eight luminance values with the chroma added, and scale them to
+ * [0, 255] like the clip tables do.
+ */
+static FORCEINLINE __m128i sse2_clip(__m128i value, bool itu) {
+	if (itu) {
+		value = _mm_min_epi16(_mm_max_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		value = _mm_sub_epi16(value, _mm_set1_epi16(16));
+		return _mm_add_epi16(value, _mm_mulhi_epu16(value, _mm_set1_epi16(YUVToRGBRowConverter::kITUScale)));
+	}
+
+	return _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), _mm_set1_epi16(255));
+}
+
+static FORCEINLINE __m128i sse2_loadChroma(const int16 *src, int x, bool halfChroma) {
+	if (halfChroma) {
+		const __m128i chroma = _mm_loadl_epi64((const __m128i *)(src + x / 2));
+		return _mm_unpacklo_epi16(chroma, chroma);
+	}
+
+	return _mm_loadu_si128((const __m128i *)(src + x));
+}
+
+template<typename PixelInt, bool halfChroma, bool alpha>
+static int convertRowSSE2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	const Graphics::PixelFormat &format = lookup->getFormat();
+	const bool itu = lookup->getScale() == YUVToRGBManager::kScaleITU;
+	const uint32 aMask = (0xFF >> format.aLoss) << format.aShift;
+
+	const __m128i rOffset = _mm_set1_epi16(lookup->getTableOffsets()[0]);
+	const __m128i gOffset = _mm_set1_epi16(lookup->getTableOffsets()[1]);
+	const __m128i bOffset = _mm_set1_epi16(lookup->getTableOffsets()[2]);
+	const __m128i rLoss = _mm_cvtsi32_si128(format.rLoss);
+	const __m128i gLoss = _mm_cvtsi32_si128(format.gLoss);
+	const __m128i bLoss = _mm_cvtsi32_si128(format.bLoss);
+	const __m128i aLoss = _mm_cvtsi32_si128(format.aLoss);
+	const __m128i rShift = _mm_cvtsi32_si128(format.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(format.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(format.bShift);
+	const __m128i aShift = _mm_cvtsi32_si128(format.aShift);
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = 0;
+	for (; x + 8 <= row.width; x += 8) {
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(row.ySrc + x)), zero);
+
+		__m128i r = _mm_sub_epi16(sse2_loadChroma(row.crR, x, halfChroma), rOffset);
+		__m128i g = _mm_sub_epi16(sse2_loadChroma(row.crbG, x, halfChroma), gOffset);
+		__m128i b = _mm_sub_epi16(sse2_loadChroma(row.cbB, x, halfChroma), bOffset);
+		r = _mm_srl_epi16(sse2_clip(_mm_add_epi16(y, r), itu), rLoss);
+		g = _mm_srl_epi16(sse2_clip(_mm_add_epi16(y, g), itu), gLoss);
+		b = _mm_srl_epi16(sse2_clip(_mm_add_epi16(y, b), itu), bLoss);
+
+		__m128i a = zero;
+		if (alpha)
+			a = _mm_srl_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(row.aSrc + x)), zero), aLoss);
+
+		if (sizeof(PixelInt) == 2) {
+			__m128i pixels = _mm_or_si128(_mm_sll_epi16(r, rShift), _mm_sll_epi16(g, gShift));
+			pixels = _mm_or_si128(pixels, _mm_sll_epi16(b, bShift));
+			pixels = _mm_or_si128(pixels, alpha ? _mm_sll_epi16(a, aShift) : _mm_set1_epi16((int16)aMask));
+			_mm_storeu_si128((__m128i *)(row.dst + x * 2), pixels);
+		} else {
+			__m128i pixels0 = _mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift));
+			__m128i pixels1 = _mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift));
+			pixels0 = _mm_or_si128(pixels0, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift));
+			pixels1 = _mm_or_si128(pixels1, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift));
+			if (alpha) {
+				pixels0 = _mm_or_si128(pixels0, _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), aShift));
+				pixels1 = _mm_or_si128(pixels1, _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), aShift));
+			} else {
+				pixels0 = _mm_or_si128(pixels0, _mm_set1_epi32(aMask));
+				pixels1 = _mm_or_si128(pixels1, _mm_set1_epi32(aMask));
+			}
+			_mm_storeu_si128((__m128i *)(row.dst + x * 4), pixels0);
+			_mm_storeu_si128((__m128i *)(row.dst + x * 4 + 16), pixels1);
+		}
+	}
+
+	return x;
+}
+
+template<typename PixelInt>
+static int convertRowSSE2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	if (row.halfChroma)
+		return row.aSrc ? convertRowSSE2<PixelInt, true, true>(lookup, row) : convertRowSSE2<PixelInt, true, false>(lookup, row);
+	return row.aSrc ? convertRowSSE2<PixelInt, false, true>(lookup, row) : convertRowSSE2<PixelInt, false, false>(lookup, row);
+}
+
+int YUVToRGBRowConverter::convertSSE2(const YUVToRGBLookup *lookup, const YUVToRGBRow &row) {
+	if (lookup->getFormat().bytesPerPixel == 2)
+		return convertRowSSE2<uint16>(lookup, row);
+	return convertRowSSE2<uint32>(lookup, row);
+}
+
+} // End of namespace Graphics
+
+#if !defined(__x86_64__)
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // !defined(__x86_64__)
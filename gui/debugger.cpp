@@ -36,6 +36,10 @@
 
 #include "engines/engine.h"
 
+#include "audio/mixer.h"
+#include "audio/mixer_profiler.h"
+#include "audio/soundcache.h"
+
 #include "gui/debugger.h"
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 	#include "gui/console.h"
@@ -81,6 +85,9 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+
+	registerCmd("mixer_profile",	WRAP_METHOD(Debugger, cmdMixerProfile));
+	registerCmd("sound_cache",		WRAP_METHOD(Debugger, cmdSoundCache));
 }
 
 Debugger::~Debugger() {
@@ -841,6 +848,57 @@ bool Debugger::cmdExecFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdMixerProfile(int argc, const char **argv) {
+	Audio::Mixer *mixer = g_system->getMixer();
+	Audio::MixerProfiler *profiler = mixer ? mixer->getProfiler() : nullptr;
+	if (!profiler) {
+		debugPrintf("The mixer does not support profiling\n");
+		return true;
+	}
+
+	if (argc < 2) {
+		debugPrintf("Usage: %s [on | off | reset | show | dump <filename>]\n", argv[0]);
+		debugPrintf("Mixer profiling is %s\n", profiler->isEnabled() ? "enabled" : "disabled");
+	} else if (!scumm_stricmp(argv[1], "on")) {
+		profiler->setEnabled(true);
+		debugPrintf("Mixer profiling enabled\n");
+	} else if (!scumm_stricmp(argv[1], "off")) {
+		profiler->setEnabled(false);
+		debugPrintf("Mixer profiling disabled\n");
+	} else if (!scumm_stricmp(argv[1], "reset")) {
+		profiler->reset();
+		debugPrintf("Mixer statistics cleared\n");
+	} else if (!scumm_stricmp(argv[1], "show")) {
+		debugPrintf("%s", profiler->getReport().c_str());
+	} else if (!scumm_stricmp(argv[1], "dump") && argc >= 3) {
+		Common::DumpFile file;
+		if (!file.open(Common::Path(argv[2], Common::Path::kNativeSeparator))) {
+			debugPrintf("Can't open file %s\n", argv[2]);
+			return true;
+		}
+		profiler->writeReport(file);
+		debugPrintf("Mixer statistics written to %s\n", argv[2]);
+	} else {
+		debugPrintf("Usage: %s [on | off | reset | show | dump <filename>]\n", argv[0]);
+	}
+
+	return true;
+}
+
+bool Debugger::cmdSoundCache(int argc, const char **argv) {
+	if (argc >= 2 && !scumm_stricmp(argv[1], "clear")) {
+		SoundCacheMan.clear();
+		debugPrintf("Sound cache cleared\n");
+		return true;
+	}
+
+	debugPrintf("Usage: %s [clear]\n", argv[0]);
+	debugPrintf("Cached sounds: %u, %u KB\n", SoundCacheMan.getNumSounds(), SoundCacheMan.getSize() / 1024);
+	debugPrintf("Sounds too large to be cached: %u\n", SoundCacheMan.getNumUncacheable());
+	debugPrintf("Hits: %u, misses: %u\n", SoundCacheMan.getNumHits(), SoundCacheMan.getNumMisses());
+	return true;
+}
+
 bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("debugflag_disable [<flag> | all]\n");
@@ -58,16 +58,16 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 }
 
 /**
- * The default codebook converter for 24bpp: RGB output.
+ * The default codebook converter for 24bpp: RGB output, using the codebooks
+ * converted to the output format when they were loaded.
  */
 struct CodebookConverterRGB {
 	template<typename PixelInt>
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		const int8 u = codebook.u, v = codebook.v;
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *dst, size_t dstPitch) {
+		const uint32 (&color)[4] = strip.v1_color[codebookIndex];
 
-		const PixelInt rgb0 = convertYUVToColor(clipTable, format, codebook.y[0], u, v);
-		const PixelInt rgb1 = convertYUVToColor(clipTable, format, codebook.y[1], u, v);
+		const PixelInt rgb0 = color[0];
+		const PixelInt rgb1 = color[1];
 
 		dst[0] = dst[1] = rgb0;
 		dst[2] = dst[3] = rgb1;
@@ -77,8 +77,8 @@ struct CodebookConverterRGB {
 		dst[2] = dst[3] = rgb1;
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		const PixelInt rgb2 = convertYUVToColor(clipTable, format, codebook.y[2], u, v);
-		const PixelInt rgb3 = convertYUVToColor(clipTable, format, codebook.y[3], u, v);
+		const PixelInt rgb2 = color[2];
+		const PixelInt rgb3 = color[3];
 
 		dst[0] = dst[1] = rgb2;
 		dst[2] = dst[3] = rgb3;
@@ -90,35 +90,35 @@ struct CodebookConverterRGB {
 	}
 
 	template<typename PixelInt>
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
-		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
-
-		dst[0] = convertYUVToColor(clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *dst, size_t dstPitch) {
+		const uint32 (&color1)[4] = strip.v4_color[codebookIndex[0]];
+		const uint32 (&color2)[4] = strip.v4_color[codebookIndex[1]];
+
+		dst[0] = color1[0];
+		dst[1] = color1[1];
+		dst[2] = color2[0];
+		dst[3] = color2[1];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
+		dst[0] = color1[2];
+		dst[1] = color1[3];
+		dst[2] = color2[2];
+		dst[3] = color2[3];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
-		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
+		const uint32 (&color3)[4] = strip.v4_color[codebookIndex[2]];
+		const uint32 (&color4)[4] = strip.v4_color[codebookIndex[3]];
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
+		dst[0] = color3[0];
+		dst[1] = color3[1];
+		dst[2] = color4[0];
+		dst[3] = color4[1];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 
-		dst[0] = convertYUVToColor(clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		dst[1] = convertYUVToColor(clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
-		dst[2] = convertYUVToColor(clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		dst[3] = convertYUVToColor(clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+		dst[0] = color3[2];
+		dst[1] = color3[3];
+		dst[2] = color4[2];
+		dst[3] = color4[3];
 		dst = (PixelInt *)((uint8 *)dst + dstPitch);
 	}
 };
@@ -127,7 +127,7 @@ struct CodebookConverterRGB {
  * The default codebook converter for 8bpp: palettized output.
  */
 struct CodebookConverterPalette {
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *dst, size_t dstPitch) {
 		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
 
 		byte y0 = codebook.y[0], y1 = codebook.y[1];
@@ -150,7 +150,7 @@ struct CodebookConverterPalette {
 		dst += dstPitch;
 	}
 
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *dst, size_t dstPitch) {
 		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
 		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
 
@@ -187,7 +187,7 @@ struct CodebookConverterPalette {
  * Codebook converter that dithers in QT-style or VFW-style
  */
 struct CodebookConverterDithered {
-	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, byte *dst, size_t dstPitch) {
 		const uint32 *colorPtr = (const uint32 *)(strip.v1_dither + codebookIndex);
 
 		*((uint32 *)dst) = colorPtr[0];
@@ -203,7 +203,7 @@ struct CodebookConverterDithered {
 		dst += dstPitch;
 	}
 
-	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *dst, size_t dstPitch, const byte *clipTable, const Graphics::PixelFormat &format) {
+	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, byte *dst, size_t dstPitch) {
 		const uint16 *colorPtr1 = (const uint16 *)(strip.v4_dither + codebookIndex[0]);
 		const uint16 *colorPtr2 = (const uint16 *)(strip.v4_dither + codebookIndex[1]);
 
@@ -229,7 +229,7 @@ struct CodebookConverterDithered {
 };
 
 template<typename PixelInt, typename CodebookConverter>
-void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
+void decodeVectorsTmpl(CinepakFrame &frame, Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	uint32 flag = 0, mask = 0;
 	int32 startPos = stream.pos();
 	PixelInt *dst;
@@ -261,14 +261,14 @@ void decodeVectorsTmpl(CinepakFrame &frame, const byte *clipTable, Common::Seeka
 
 					// Get the codebook
 					byte codebook = stream.readByte();
-					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], dst, frame.surface->pitch, clipTable, frame.surface->format);
+					CodebookConverter::decodeBlock1(codebook, frame.strips[strip], dst, frame.surface->pitch);
 				} else if (flag & mask) {
 					if ((stream.pos() - startPos + 4) > (int32)chunkSize)
 						return;
 
 					byte codebook[4];
 					stream.read(codebook, 4);
-					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], dst, frame.surface->pitch, clipTable, frame.surface->format);
+					CodebookConverter::decodeBlock4(codebook, frame.strips[strip], dst, frame.surface->pitch);
 				}
 			}
 
@@ -362,9 +362,14 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				_curFrame.strips[i].v4_codebook[j] = _curFrame.strips[i - 1].v4_codebook[j];
 			}
 
-			// Copy the dither tables
-			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * sizeof(uint32));
-			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * sizeof(uint32));
+			// Copy the converted codebooks or the dither tables, whichever are in use
+			if (convertsCodebooks()) {
+				memcpy(_curFrame.strips[i].v1_color, _curFrame.strips[i - 1].v1_color, sizeof(_curFrame.strips[i].v1_color));
+				memcpy(_curFrame.strips[i].v4_color, _curFrame.strips[i - 1].v4_color, sizeof(_curFrame.strips[i].v4_color));
+			} else if (_ditherType != kDitherTypeUnknown) {
+				memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * sizeof(uint32));
+				memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * sizeof(uint32));
+			}
 		}
 
 		_curFrame.strips[i].id = stream.readUint16BE();
@@ -441,6 +446,8 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 			ditherCodebookQT(strip, codebookType, i);
 		else if (_ditherType == kDitherTypeVFW)
 			ditherCodebookVFW(strip, codebookType, i);
+		else if (convertsCodebooks())
+			convertCodebook(strip, codebookType, i);
 	}
 }
 
@@ -477,15 +484,26 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
+			// Dither the codebook if we're dithering for QuickTime, or
+			// convert it to the output format for RGB output
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
 			else if (_ditherType == kDitherTypeVFW)
 				ditherCodebookVFW(strip, codebookType, i);
+			else if (convertsCodebooks())
+				convertCodebook(strip, codebookType, i);
 		}
 	}
 }
 
+void CinepakDecoder::convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	const CinepakCodebook &codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook[codebookIndex] : _curFrame.strips[strip].v4_codebook[codebookIndex];
+	uint32 *output = (codebookType == 1) ? _curFrame.strips[strip].v1_color[codebookIndex] : _curFrame.strips[strip].v4_color[codebookIndex];
+
+	for (int i = 0; i < 4; i++)
+		output[i] = convertYUVToColor(_clipTable, _pixelFormat, codebook.y[i], codebook.u, codebook.v);
+}
+
 void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex) {
 	if (codebookType == 1) {
 		const CinepakCodebook &codebook = _curFrame.strips[strip].v1_codebook[codebookIndex];
@@ -631,14 +649,14 @@ void CinepakDecoder::ditherCodebookVFW(uint16 strip, byte codebookType, uint16 c
 }
 
 void CinepakDecoder::decodeVectors8(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
-	decodeVectorsTmpl<byte, CodebookConverterPalette>(_curFrame, _clipTable, stream, strip, chunkID, chunkSize);
+	decodeVectorsTmpl<byte, CodebookConverterPalette>(_curFrame, stream, strip, chunkID, chunkSize);
 }
 
 void CinepakDecoder::decodeVectors24(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
 	if (_curFrame.surface->format.bytesPerPixel == 2) {
-		decodeVectorsTmpl<uint16, CodebookConverterRGB>(_curFrame, _clipTable, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint16, CodebookConverterRGB>(_curFrame, stream, strip, chunkID, chunkSize);
 	} else if (_curFrame.surface->format.bytesPerPixel == 4) {
-		decodeVectorsTmpl<uint32, CodebookConverterRGB>(_curFrame, _clipTable, stream, strip, chunkID, chunkSize);
+		decodeVectorsTmpl<uint32, CodebookConverterRGB>(_curFrame, stream, strip, chunkID, chunkSize);
 	}
 }
 
@@ -649,7 +667,27 @@ bool CinepakDecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
 	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
 		return false;
 
+	if (format == _pixelFormat)
+		return true;
+
 	_pixelFormat = format;
+
+	// Convert the codebooks we already have to the new format
+	if (_curFrame.strips && convertsCodebooks()) {
+		for (uint16 i = 0; i < _curFrame.stripCount; i++) {
+			for (uint16 j = 0; j < 256; j++) {
+				convertCodebook(i, 1, j);
+				convertCodebook(i, 4, j);
+			}
+		}
+	}
+
+	if (_curFrame.surface) {
+		_curFrame.surface->free();
+		delete _curFrame.surface;
+		_curFrame.surface = 0;
+	}
+
 	return true;
 }
 
@@ -690,7 +728,7 @@ byte CinepakDecoder::findNearestRGB(int index) const {
 }
 
 void CinepakDecoder::ditherVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize) {
-	decodeVectorsTmpl<byte, CodebookConverterDithered>(_curFrame, _clipTable, stream, strip, chunkID, chunkSize);
+	decodeVectorsTmpl<byte, CodebookConverterDithered>(_curFrame, stream, strip, chunkID, chunkSize);
 }
 
 } // End of namespace Image
@@ -46,6 +46,7 @@ struct CinepakStrip {
 	uint16 length;
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
+	uint32 v1_color[256][4], v4_color[256][4]; // The codebooks converted to the output format
 	uint32 v1_dither[256 * 4 * 4], v4_dither[256 * 4 * 4];
 };
 
@@ -97,6 +98,8 @@ private:
 
 	void initializeCodebook(uint16 strip, byte codebookType);
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
+	void convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex);
+	bool convertsCodebooks() const { return _bitsPerPixel != 8 && _ditherType == kDitherTypeUnknown; }
 	void decodeVectors8(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 	void decodeVectors24(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 
@@ -63,6 +63,19 @@ Graphics::PixelFormat Codec::getDefaultYUVFormat() {
 		return format;
 }
 
+uint32 *Codec::createRGB555Lookup(const Graphics::PixelFormat &format) {
+	const Graphics::PixelFormat format555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+	uint32 *lookup = new uint32[32768];
+
+	for (uint i = 0; i < 32768; i++) {
+		byte r, g, b;
+		format555.colorToRGB(i, r, g, b);
+		lookup[i] = format.RGBToColor(r, g, b);
+	}
+
+	return lookup;
+}
+
 Codec *createBitmapCodec(uint32 tag, uint32 streamTag, int width, int height, int bitsPerPixel) {
 	// Crusader videos are special cased here because the frame type is not in the "compression"
 	// tag but in the "stream handler" tag for these files
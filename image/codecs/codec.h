@@ -127,6 +127,15 @@ public:
 	 * Get the preferred default pixel format for use with YUV codecs
 	 */
 	static Graphics::PixelFormat getDefaultYUVFormat();
+
+protected:
+	/**
+	 * Create a lookup from the 15-bit RGB555 colors used by some codecs to
+	 * colors in the given format, so that they can be written straight to
+	 * the output surface. The returned table has 32768 entries and must be
+	 * freed with delete[].
+	 */
+	static uint32 *createRGB555Lookup(const Graphics::PixelFormat &format);
 };
 
 /**
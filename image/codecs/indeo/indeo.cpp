@@ -28,6 +28,7 @@
 #include "image/codecs/indeo/mem.h"
 #include "graphics/yuv_to_rgb.h"
 #include "common/system.h"
+#include "common/taskpool.h"
 #include "common/algorithm.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
@@ -561,22 +562,8 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	if ((result = frame->getBuffer(0)) < 0)
 		return result;
 
-	if (_ctx._isScalable) {
-		if (_ctx._isIndeo4)
-			recomposeHaar(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
-		else
-			recompose53(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
-	} else {
-		outputPlane(&_ctx._planes[0], frame->_data[0], frame->_linesize[0]);
-	}
-
-	outputPlane(&_ctx._planes[2], frame->_data[1], frame->_linesize[1]);
-	outputPlane(&_ctx._planes[1], frame->_data[2], frame->_linesize[2]);
-
-	// Merge the planes into the final surface
-	YUVToRGBMan.convert410(_surface, Graphics::YUVToRGBManager::kScaleITU,
-		frame->_data[0], frame->_data[1], frame->_data[2], frame->_width, frame->_height,
-		frame->_width, frame->_width);
+	// One band of lines for each worker thread, and one for this thread
+	outputFrame(frame, TaskPoolMan.getNumWorkers() + 1);
 
 	if (_ctx._hasTransp)
 		decodeTransparency();
@@ -653,6 +640,12 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 
 	int pos = _ctx._gb->pos();
 
+	// The size of each tile is coded before its data, so the tiles can be
+	// located here and decoded in parallel, as they cover distinct areas
+	// of the band
+	Common::TaskGroup group;
+	Common::Array<int> tileResults(band->_numTiles, 0);
+
 	for (int t = 0; t < band->_numTiles; t++) {
 		IVITile *tile = &band->_tiles[t];
 
@@ -676,26 +669,30 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 				break;
 			}
 
-			result = decodeMbInfo(band, tile);
-			if (result < 0)
-				break;
-
-			result = decodeBlocks(_ctx._gb, band, tile);
-			if (result < 0) {
-				warning("Corrupted tile data encountered!");
-				break;
-			}
-
-			if ((((int)_ctx._gb->pos() - pos) >> 3) != tile->_dataSize) {
+			// The data size includes the tile header
+			int size = tile->_dataSize - ((_ctx._gb->pos() - pos) >> 3);
+			if (size <= 0 || (size << 3) > _ctx._gb->getBitsLeft()) {
 				warning("Tile _dataSize mismatch!");
 				result = -1;
 				break;
 			}
 
+			const uint8 *data = _ctx._frameData + (_ctx._gb->pos() >> 3);
+			int *tileResult = &tileResults[t];
+			group.run([this, band, tile, data, size, tileResult]() {
+				*tileResult = decodeTile(band, tile, data, size);
+			});
+
+			_ctx._gb->skip(size << 3);
 			pos += tile->_dataSize << 3; // skip to next tile
 		}
 	}
 
+	group.wait();
+
+	for (int t = 0; t < band->_numTiles && result >= 0; t++)
+		result = tileResults[t];
+
 	// restore the selected rvmap table by applying its corrections in
 	// reverse order
 	for (int i = band->_numCorr - 1; i >= 0; i--) {
@@ -714,19 +711,73 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 	return result;
 }
 
+void IndeoDecoderBase::outputFrame(AVFrame *frame, int numBands) {
+	int bandHeight = frame->_height;
+	if (numBands > 1)
+		bandHeight = MAX<int>(((frame->_height / numBands) + 15) & ~15, 16);
+
+	// Converting a band reads the first chroma line of the next one, so all
+	// the bands are output before any of them is converted
+	Common::TaskGroup group;
+	for (int y = 0; y < frame->_height; y += bandHeight) {
+		const int height = MIN(bandHeight, frame->_height - y);
+		group.run([this, frame, y, height]() { outputBand(frame, y, height); });
+	}
+	group.wait();
+
+	for (int y = 0; y < frame->_height; y += bandHeight) {
+		const int height = MIN(bandHeight, frame->_height - y);
+		group.run([this, frame, y, height]() { convertBand(frame, y, height); });
+	}
+	group.wait();
+}
+
+void IndeoDecoderBase::outputBand(AVFrame *frame, int y, int height) {
+	if (_ctx._isScalable) {
+		if (_ctx._isIndeo4)
+			recomposeHaar(&_ctx._planes[0], frame->_data[0], frame->_linesize[0], y, height);
+		else
+			recompose53(&_ctx._planes[0], frame->_data[0], frame->_linesize[0], y, height);
+	} else {
+		outputPlane(&_ctx._planes[0], frame->_data[0], frame->_linesize[0], y, height);
+	}
+
+	// The chroma planes are subsampled by four in both directions
+	const int uvY = y / 4;
+	const int uvHeight = (height + 3) / 4;
+	outputPlane(&_ctx._planes[2], frame->_data[1], frame->_linesize[1], uvY, uvHeight);
+	outputPlane(&_ctx._planes[1], frame->_data[2], frame->_linesize[2], uvY, uvHeight);
+}
+
+void IndeoDecoderBase::convertBand(AVFrame *frame, int y, int height) {
+	const int uvY = y / 4;
+
+	Graphics::Surface band;
+	band.init(frame->_width, height, _surface->pitch, _surface->getBasePtr(0, y), _surface->format);
+
+	YUVToRGBMan.convert410(&band, Graphics::YUVToRGBManager::kScaleITU,
+		frame->_data[0] + y * frame->_width, frame->_data[1] + uvY * frame->_width,
+		frame->_data[2] + uvY * frame->_width, frame->_width, height,
+		frame->_width, frame->_width);
+}
+
 void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
-		uint8 *dst, const int dstPitch) {
+		uint8 *dst, const int dstPitch, int startY, int height) {
 
 	// all bands should have the same _pitch
 	int32 pitch = _plane->_bands[0]._pitch;
+	const int endY = MIN<int>(startY + height, _plane->_height);
+
+	// get pointers to the wavelet bands, each line of which is two lines
+	// of the output
+	const short *b0Ptr = _plane->_bands[0]._buf + (startY / 2) * pitch;
+	const short *b1Ptr = _plane->_bands[1]._buf + (startY / 2) * pitch;
+	const short *b2Ptr = _plane->_bands[2]._buf + (startY / 2) * pitch;
+	const short *b3Ptr = _plane->_bands[3]._buf + (startY / 2) * pitch;
 
-	// get pointers to the wavelet bands
-	const short *b0Ptr = _plane->_bands[0]._buf;
-	const short *b1Ptr = _plane->_bands[1]._buf;
-	const short *b2Ptr = _plane->_bands[2]._buf;
-	const short *b3Ptr = _plane->_bands[3]._buf;
+	dst += startY * dstPitch;
 
-	for (int y = 0; y < _plane->_height; y += 2) {
+	for (int y = startY; y < endY; y += 2) {
 		for (int x = 0, indx = 0; x < _plane->_width; x += 2, indx++) {
 			// load coefficients
 			int b0 = b0Ptr[indx]; //should be: b0 = (_numBands > 0) ? b0Ptr[indx] : 0;
@@ -757,7 +808,7 @@ void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
 }
 
 void IndeoDecoderBase::recompose53(const IVIPlaneDesc *_plane,
-		uint8 *dst, const int dstPitch) {
+		uint8 *dst, const int dstPitch, int startY, int height) {
 	int32 p0, p1, p2, p3, tmp0, tmp1, tmp2;
 	int32 b0_1, b0_2, b1_1, b1_2, b1_3, b2_1, b2_2, b2_3, b2_4, b2_5, b2_6;
 	int32 b3_1, b3_2, b3_3, b3_4, b3_5, b3_6, b3_7, b3_8, b3_9;
@@ -766,16 +817,21 @@ void IndeoDecoderBase::recompose53(const IVIPlaneDesc *_plane,
 	// all bands should have the same _pitch
 	int32 pitch_ = _plane->_bands[0]._pitch;
 
+	const int endY = MIN<int>(startY + height, _plane->_height);
+
 	// pixels at the position "y-1" will be set to pixels at the "y" for the 1st iteration
-	int32 back_pitch = 0;
+	int32 back_pitch = startY ? -pitch_ : 0;
+
+	// get pointers to the wavelet bands, each line of which is two lines
+	// of the output
+	const short *b0Ptr = _plane->_bands[0]._buf + (startY / 2) * pitch_;
+	const short *b1Ptr = _plane->_bands[1]._buf + (startY / 2) * pitch_;
+	const short *b2Ptr = _plane->_bands[2]._buf + (startY / 2) * pitch_;
+	const short *b3Ptr = _plane->_bands[3]._buf + (startY / 2) * pitch_;
 
-	// get pointers to the wavelet bands
-	const short *b0Ptr = _plane->_bands[0]._buf;
-	const short *b1Ptr = _plane->_bands[1]._buf;
-	const short *b2Ptr = _plane->_bands[2]._buf;
-	const short *b3Ptr = _plane->_bands[3]._buf;
+	dst += startY * dstPitch;
 
-	for (int y = 0; y < _plane->_height; y += 2) {
+	for (int y = startY; y < endY; y += 2) {
 
 		if (y + 2 >= _plane->_height)
 			pitch_ = 0;
@@ -909,14 +965,18 @@ void IndeoDecoderBase::recompose53(const IVIPlaneDesc *_plane,
 	}
 }
 
-void IndeoDecoderBase::outputPlane(IVIPlaneDesc *_plane, uint8 *dst, int dstPitch) {
+void IndeoDecoderBase::outputPlane(IVIPlaneDesc *_plane, uint8 *dst, int dstPitch, int startY, int height) {
 	const int16 *src = _plane->_bands[0]._buf;
 	uint32 pitch = _plane->_bands[0]._pitch;
+	const int endY = MIN<int>(startY + height, _plane->_height);
 
 	if (!src)
 		return;
 
-	for (int y = 0; y < _plane->_height; y++) {
+	src += startY * pitch;
+	dst += startY * dstPitch;
+
+	for (int y = startY; y < endY; y++) {
 		for (int x = 0; x < _plane->_width; x++)
 			dst[x] = avClipUint8(src[x] + 128);
 		src += pitch;
@@ -1035,6 +1095,27 @@ int IndeoDecoderBase::processEmptyTile(IVIBandDesc *band,
 	return 0;
 }
 
+int IndeoDecoderBase::decodeTile(IVIBandDesc *band, IVITile *tile, const uint8 *data, int size) {
+	GetBits gb(data, size);
+
+	int result = decodeMbInfo(&gb, band, tile);
+	if (result < 0)
+		return result;
+
+	result = decodeBlocks(&gb, band, tile);
+	if (result < 0) {
+		warning("Corrupted tile data encountered!");
+		return result;
+	}
+
+	if ((int)(gb.pos() >> 3) != size) {
+		warning("Tile _dataSize mismatch!");
+		return -1;
+	}
+
+	return 0;
+}
+
 int IndeoDecoderBase::decodeTileDataSize(GetBits *gb) {
 	int len = 0;
 
@@ -448,8 +448,10 @@ private:
 	 *  @param[in]  plane		Pointer to the descriptor of the plane being processed
 	 *  @param[out] dst			pointer to the destination buffer
 	 *  @param[in]  dstPitch	Pitch of the destination buffer
+	 *  @param[in]  y			First line to output, which must be even
+	 *  @param[in]  height		Number of lines to output
 	 */
-	void recomposeHaar(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch);
+	void recomposeHaar(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch, int y, int height);
 
 	/**
 	 *  5/3 wavelet recomposition filter for Indeo5
@@ -457,8 +459,10 @@ private:
 	 *  @param[in]   plane        Pointer to the descriptor of the plane being processed
 	 *  @param[out]  dst          Pointer to the destination buffer
 	 *  @param[in]   dstPitch     Pitch of the destination buffer
+	 *  @param[in]   y            First line to output, which must be even
+	 *  @param[in]   height       Number of lines to output
 	 */
-	void recompose53(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch);
+	void recompose53(const IVIPlaneDesc *plane, uint8 *dst, const int dstPitch, int y, int height);
 
 	/*
 	 *  Convert and output the current plane.
@@ -468,8 +472,29 @@ private:
 	 *  @param[in]   plane		Pointer to the descriptor of the plane being processed
 	 *  @param[out]  dst		Pointer to the buffer receiving converted pixels
 	 *  @param[in]   dstPitch	Pitch for moving to the next y line
+	 *  @param[in]   y			First line to output
+	 *  @param[in]   height		Number of lines to output
 	 */
-	void outputPlane(IVIPlaneDesc *plane, uint8 *dst, int dstPitch);
+	void outputPlane(IVIPlaneDesc *plane, uint8 *dst, int dstPitch, int y, int height);
+
+	/**
+	 *  Output a band of lines of all planes. Bands can be output in parallel.
+	 *
+	 *  @param[in]   frame		Frame receiving the output planes
+	 *  @param[in]   y			First line of the band, which must be a multiple of 4
+	 *  @param[in]   height		Number of lines in the band
+	 */
+	void outputBand(AVFrame *frame, int y, int height);
+
+	/**
+	 *  Convert a band of lines of the output planes to RGB into the surface.
+	 *  Bands can be converted in parallel once all of them were output.
+	 *
+	 *  @param[in]   frame		Frame holding the output planes
+	 *  @param[in]   y			First line of the band, which must be a multiple of 4
+	 *  @param[in]   height		Number of lines in the band
+	 */
+	void convertBand(AVFrame *frame, int y, int height);
 
 	/**
 	 *  Handle empty tiles by performing data copying and motion
@@ -481,6 +506,17 @@ private:
 	 */
 	int processEmptyTile(IVIBandDesc *band, IVITile *tile, int32 mvScale);
 
+	/**
+	 *  Decode the macroblock information and the blocks of a tile.
+	 *
+	 *  @param[in]      band	Pointer to the band descriptor
+	 *  @param[in,out]  tile	Pointer to the tile descriptor
+	 *  @param[in]      data	Pointer to the tile data following its header
+	 *  @param[in]      size	Size of the tile data following its header
+	 *  @returns	Result code: 0 - OK, -1 = error (corrupted tile data)
+	 */
+	int decodeTile(IVIBandDesc *band, IVITile *tile, const uint8 *data, int size);
+
 	/*
 	 *  Decode size of the tile data.
 	 *  The size is stored as a variable-length field having the following format:
@@ -572,11 +608,12 @@ protected:
 	*  Decode information (block type, _cbp, quant delta, motion vector)
 	*  for all macroblocks in the current tile.
 	*
+	*  @param[in,out] gb		The GetBit context of the tile
 	*  @param[in,out] band		Pointer to the band descriptor
 	*  @param[in,out] tile		Pointer to the tile descriptor
 	*  @returns		Result code: 0 = OK, negative number = error
 	*/
-	virtual int decodeMbInfo(IVIBandDesc *band, IVITile *tile) = 0;
+	virtual int decodeMbInfo(GetBits *gb, IVIBandDesc *band, IVITile *tile) = 0;
 
 	/**
 	 * Decodes optional transparency data within Indeo frames
@@ -589,6 +626,16 @@ protected:
 	 */
 	int decodeIndeoFrame();
 
+	/**
+	 * Output the planes of the frame and convert them to RGB into the
+	 * surface, split into bands of lines which are processed on the
+	 * worker threads
+	 *
+	 * @param[in]	frame		Frame receiving the output planes
+	 * @param[in]	numBands	Number of bands to split the frame into
+	 */
+	void outputFrame(AVFrame *frame, int numBands);
+
 	/**
 	 * scale motion vector
 	 */
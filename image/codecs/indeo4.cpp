@@ -454,7 +454,7 @@ int Indeo4Decoder::decodeBandHeader(IVIBandDesc *band) {
 	return 0;
 }
 
-int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
+int Indeo4Decoder::decodeMbInfo(GetBits *gb, IVIBandDesc *band, IVITile *tile) {
 	int x, y, mvX, mvY, mvDelta, offs, mbOffset,
 		mvScale, s;
 	IVIMbInfo *mb, *refMb;
@@ -482,7 +482,7 @@ int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 			mb->_bufOffs = mbOffset;
 			mb->_bMvX = mb->_bMvY = 0;
 
-			if (_ctx._gb->getBit()) {
+			if (gb->getBit()) {
 				if (_ctx._frameType == IVI4_FRAMETYPE_INTRA) {
 					warning("Empty macroblock in an INTRA picture!");
 					return -1;
@@ -492,7 +492,7 @@ int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 
 				mb->_qDelta = 0;
 				if (!band->_plane && !band->_bandNum && _ctx._inQ) {
-					mb->_qDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+					mb->_qDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 					mb->_qDelta = IVI_TOSIGNED(mb->_qDelta);
 				}
 
@@ -519,15 +519,15 @@ int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 					_ctx._frameType == IVI4_FRAMETYPE_INTRA1) {
 					mb->_type = 0; // mb_type is always INTRA for intra-frames
 				} else if (_ctx._frameType == IVI4_FRAMETYPE_BIDIR) {
-					mb->_type = _ctx._gb->getBits<2>();
+					mb->_type = gb->getBits<2>();
 				} else {
-					mb->_type = _ctx._gb->getBit();
+					mb->_type = gb->getBit();
 				}
 
 				if (band->_mbSize != band->_blkSize) {
-					mb->_cbp = _ctx._gb->getBits<4>();
+					mb->_cbp = gb->getBits<4>();
 				} else {
-					mb->_cbp = _ctx._gb->getBit();
+					mb->_cbp = gb->getBit();
 				}
 
 				mb->_qDelta = 0;
@@ -535,7 +535,7 @@ int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 					if (refMb) mb->_qDelta = refMb->_qDelta;
 				} else if (mb->_cbp || (!band->_plane && !band->_bandNum &&
 					_ctx._inQ)) {
-					mb->_qDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+					mb->_qDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 					mb->_qDelta = IVI_TOSIGNED(mb->_qDelta);
 				}
 
@@ -555,17 +555,17 @@ int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 						}
 					} else {
 						// decode motion vector deltas
-						mvDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+						mvDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 						mvY += IVI_TOSIGNED(mvDelta);
-						mvDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+						mvDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 						mvX += IVI_TOSIGNED(mvDelta);
 						mb->_mvX = mvX;
 						mb->_mvY = mvY;
 						if (mb->_type == 3) {
-							mvDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(
+							mvDelta = gb->getVLC2<1, IVI_VLC_BITS>(
 								_ctx._mbVlc._tab->_table);
 							mvY += IVI_TOSIGNED(mvDelta);
-							mvDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(
+							mvDelta = gb->getVLC2<1, IVI_VLC_BITS>(
 								_ctx._mbVlc._tab->_table);
 							mvX += IVI_TOSIGNED(mvDelta);
 							mb->_bMvX = -mvX;
@@ -599,7 +599,7 @@ int Indeo4Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 		offs += row_offset;
 	}
 
-	_ctx._gb->align();
+	gb->align();
 	return 0;
 }
 
@@ -83,11 +83,12 @@ protected:
 	 *  Decode information (block type, cbp, quant delta, motion vector)
 	 *  for all macroblocks in the current tile.
 	 *
+	 *  @param[in,out] gb        the GetBit context of the tile
 	 *  @param[in,out] band      pointer to the band descriptor
 	 *  @param[in,out] tile      pointer to the tile descriptor
 	 *  @returns       result code: 0 = OK, negative number = error
 	 */
-	int decodeMbInfo(IVIBandDesc *band, IVITile *tile) override;
+	int decodeMbInfo(GetBits *gb, IVIBandDesc *band, IVITile *tile) override;
 
 	/**
 	 * Decodes huffman + RLE-coded transparency data within Indeo4 frames
@@ -259,7 +259,7 @@ int Indeo5Decoder::decodeBandHeader(IVIBandDesc *band) {
 	return 0;
 }
 
-int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
+int Indeo5Decoder::decodeMbInfo(GetBits *gb, IVIBandDesc *band, IVITile *tile) {
 	int x, y, mvX, mvY, mvDelta, offs, mbOffset, mvScale, s;
 	IVIMbInfo *mb, *refMb;
 	int rowOffset = band->_mbSize * band->_pitch;
@@ -290,7 +290,7 @@ int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 			mb->_yPos = y;
 			mb->_bufOffs = mbOffset;
 
-			if (_ctx._gb->getBit()) {
+			if (gb->getBit()) {
 				if (_ctx._frameType == FRAMETYPE_INTRA) {
 					warning("Empty macroblock in an INTRA picture!");
 					return -1;
@@ -300,7 +300,7 @@ int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 
 				mb->_qDelta = 0;
 				if (!band->_plane && !band->_bandNum && (_ctx._frameFlags & 8)) {
-					mb->_qDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+					mb->_qDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 					mb->_qDelta = IVI_TOSIGNED(mb->_qDelta);
 				}
 
@@ -321,13 +321,13 @@ int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 				} else if (_ctx._frameType == FRAMETYPE_INTRA) {
 					mb->_type = 0; // mb_type is always INTRA for intra-frames
 				} else {
-					mb->_type = _ctx._gb->getBit();
+					mb->_type = gb->getBit();
 				}
 
 				if (band->_mbSize != band->_blkSize) {
-					mb->_cbp = _ctx._gb->getBits<4>();
+					mb->_cbp = gb->getBits<4>();
 				} else {
-					mb->_cbp = _ctx._gb->getBit();
+					mb->_cbp = gb->getBit();
 				}
 
 				mb->_qDelta = 0;
@@ -336,7 +336,7 @@ int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 						if (refMb) mb->_qDelta = refMb->_qDelta;
 					} else if (mb->_cbp || (!band->_plane && !band->_bandNum &&
 						(_ctx._frameFlags & 8))) {
-						mb->_qDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+						mb->_qDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 						mb->_qDelta = IVI_TOSIGNED(mb->_qDelta);
 					}
 				}
@@ -355,9 +355,9 @@ int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 						}
 					} else {
 						// decode motion vector deltas
-						mvDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+						mvDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 						mvY += IVI_TOSIGNED(mvDelta);
-						mvDelta = _ctx._gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
+						mvDelta = gb->getVLC2<1, IVI_VLC_BITS>(_ctx._mbVlc._tab->_table);
 						mvX += IVI_TOSIGNED(mvDelta);
 						mb->_mvX = mvX;
 						mb->_mvY = mvY;
@@ -383,7 +383,7 @@ int Indeo5Decoder::decodeMbInfo(IVIBandDesc *band, IVITile *tile) {
 		offs += rowOffset;
 	}
 
-	_ctx._gb->align();
+	gb->align();
 
 	return 0;
 }
@@ -39,11 +39,13 @@ MSVideo1Decoder::MSVideo1Decoder(uint16 width, uint16 height, byte bitsPerPixel)
 														  Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0));
 
 	_bitsPerPixel = bitsPerPixel;
+	_rgbLookup = 0;
 }
 
 MSVideo1Decoder::~MSVideo1Decoder() {
 	_surface->free();
 	delete _surface;
+	delete[] _rgbLookup;
 }
 
 void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
@@ -125,10 +127,11 @@ void MSVideo1Decoder::decode8(Common::SeekableReadStream &stream) {
 	}
 }
 
+template<typename PixelInt>
 void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 	/* decoding parameters */
-	uint16 colors[8];
-	uint16 *pixels = (uint16 *)_surface->getPixels();
+	PixelInt colors[8];
+	PixelInt *pixels = (PixelInt *)_surface->getPixels();
 	int32 stride = _surface->w;
 
 	int32 skip_blocks = 0;
@@ -167,18 +170,19 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 				uint16 flags = (byte_b << 8) | byte_a;
 
 				CHECK_STREAM_PTR(4);
-				colors[0] = stream.readUint16LE();
-				colors[1] = stream.readUint16LE();
+				uint16 color0 = stream.readUint16LE();
+				colors[0] = convertColor<PixelInt>(color0);
+				colors[1] = convertColor<PixelInt>(stream.readUint16LE());
 
-				if (colors[0] & 0x8000) {
+				if (color0 & 0x8000) {
 					/* 8-color encoding */
 					CHECK_STREAM_PTR(12);
-					colors[2] = stream.readUint16LE();
-					colors[3] = stream.readUint16LE();
-					colors[4] = stream.readUint16LE();
-					colors[5] = stream.readUint16LE();
-					colors[6] = stream.readUint16LE();
-					colors[7] = stream.readUint16LE();
+					colors[2] = convertColor<PixelInt>(stream.readUint16LE());
+					colors[3] = convertColor<PixelInt>(stream.readUint16LE());
+					colors[4] = convertColor<PixelInt>(stream.readUint16LE());
+					colors[5] = convertColor<PixelInt>(stream.readUint16LE());
+					colors[6] = convertColor<PixelInt>(stream.readUint16LE());
+					colors[7] = convertColor<PixelInt>(stream.readUint16LE());
 
 					for (int pixel_y = 0; pixel_y < 4; pixel_y++) {
 						for (int pixel_x = 0; pixel_x < 4; pixel_x++, flags >>= 1)
@@ -197,7 +201,7 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 				}
 			} else {
 				/* otherwise, it's a 1-color block */
-				colors[0] = (byte_b << 8) | byte_a;
+				colors[0] = convertColor<PixelInt>((byte_b << 8) | byte_a);
 
 				for (int pixel_y = 0; pixel_y < 4; pixel_y++) {
 					for (int pixel_x = 0; pixel_x < 4; pixel_x++)
@@ -215,10 +219,37 @@ void MSVideo1Decoder::decode16(Common::SeekableReadStream &stream) {
 const Graphics::Surface *MSVideo1Decoder::decodeFrame(Common::SeekableReadStream &stream) {
 	if (_bitsPerPixel == 8)
 		decode8(stream);
+	else if (_surface->format.bytesPerPixel == 2)
+		decode16<uint16>(stream);
 	else
-		decode16(stream);
+		decode16<uint32>(stream);
 
 	return _surface;
 }
 
+bool MSVideo1Decoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (_bitsPerPixel == 8)
+		return format.isCLUT8();
+
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	if (format == _surface->format)
+		return true;
+
+	// Blocks are only partially updated, so start again from a new surface
+	uint16 width = _surface->w, height = _surface->h;
+	_surface->free();
+	_surface->create(width, height, format);
+
+	delete[] _rgbLookup;
+	_rgbLookup = 0;
+
+	// The stream colors are RGB555, so only other formats need converting
+	if (format != Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0))
+		_rgbLookup = createRGB555Lookup(format);
+
+	return true;
+}
+
 } // End of namespace Image
@@ -38,13 +38,19 @@ public:
 
 	const Graphics::Surface *decodeFrame(Common::SeekableReadStream &stream) override;
 	Graphics::PixelFormat getPixelFormat() const override { return _surface->format; }
+	bool setOutputPixelFormat(const Graphics::PixelFormat &format) override;
 
 private:
 	byte _bitsPerPixel;
 
 	Graphics::Surface *_surface;
+	uint32 *_rgbLookup;
+
+	template<typename PixelInt>
+	inline PixelInt convertColor(uint16 color) const { return _rgbLookup ? _rgbLookup[color & 0x7FFF] : color; }
 
 	void decode8(Common::SeekableReadStream &stream);
+	template<typename PixelInt>
 	void decode16(Common::SeekableReadStream &stream);
 };
 
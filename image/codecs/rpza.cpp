@@ -35,6 +35,7 @@ RPZADecoder::RPZADecoder(uint16 width, uint16 height) : Codec(), _ditherPalette(
 	_format = Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0);
 	_dirtyPalette = false;
 	_colorMap = 0;
+	_rgbLookup = 0;
 	_width = width;
 	_height = height;
 	_blockWidth = (width + 3) / 4;
@@ -49,6 +50,7 @@ RPZADecoder::~RPZADecoder() {
 	}
 
 	delete[] _colorMap;
+	delete[] _rgbLookup;
 }
 
 #define ADVANCE_BLOCK() \
@@ -62,7 +64,8 @@ RPZADecoder::~RPZADecoder() {
 		error("rpza block counter just went negative (this should not happen)") \
 
 struct BlockDecoderRaw {
-	static inline void drawFillBlock(uint16 *blockPtr, uint16 pitch, uint16 color, const byte *colorMap) {
+	template<typename PixelInt>
+	static inline void drawFillBlock(PixelInt *blockPtr, uint16 pitch, PixelInt color, const byte *colorMap) {
 		blockPtr[0] = color;
 		blockPtr[1] = color;
 		blockPtr[2] = color;
@@ -84,7 +87,8 @@ struct BlockDecoderRaw {
 		blockPtr[3] = color;
 	}
 
-	static inline void drawRawBlock(uint16 *blockPtr, uint16 pitch, const uint16 (&colors)[16], const byte *colorMap) {
+	template<typename PixelInt>
+	static inline void drawRawBlock(PixelInt *blockPtr, uint16 pitch, const PixelInt (&colors)[16], const byte *colorMap) {
 		blockPtr[0] = colors[0];
 		blockPtr[1] = colors[1];
 		blockPtr[2] = colors[2];
@@ -106,7 +110,8 @@ struct BlockDecoderRaw {
 		blockPtr[3] = colors[15];
 	}
 
-	static inline void drawBlendBlock(uint16 *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const byte *colorMap) {
+	template<typename PixelInt>
+	static inline void drawBlendBlock(PixelInt *blockPtr, uint16 pitch, const PixelInt (&colors)[4], const byte (&indexes)[4], const byte *colorMap) {
 		blockPtr[0] = colors[(indexes[0] >> 6) & 0x03];
 		blockPtr[1] = colors[(indexes[0] >> 4) & 0x03];
 		blockPtr[2] = colors[(indexes[0] >> 2) & 0x03];
@@ -129,6 +134,38 @@ struct BlockDecoderRaw {
 	}
 };
 
+/**
+ * Block decoder for other RGB formats, converting the RGB555 colors of
+ * the stream through a lookup once for each block.
+ */
+struct BlockDecoderConvert {
+	template<typename PixelInt>
+	static inline void drawFillBlock(PixelInt *blockPtr, uint16 pitch, uint16 color, const uint32 *colorMap) {
+		BlockDecoderRaw::drawFillBlock<PixelInt>(blockPtr, pitch, colorMap[color & 0x7FFF], nullptr);
+	}
+
+	template<typename PixelInt>
+	static inline void drawRawBlock(PixelInt *blockPtr, uint16 pitch, const uint16 (&colors)[16], const uint32 *colorMap) {
+		PixelInt converted[16];
+		for (int i = 0; i < 16; i++)
+			converted[i] = colorMap[colors[i] & 0x7FFF];
+
+		BlockDecoderRaw::drawRawBlock<PixelInt>(blockPtr, pitch, converted, nullptr);
+	}
+
+	template<typename PixelInt>
+	static inline void drawBlendBlock(PixelInt *blockPtr, uint16 pitch, const uint16 (&colors)[4], const byte (&indexes)[4], const uint32 *colorMap) {
+		const PixelInt converted[4] = {
+			(PixelInt)colorMap[colors[0]],
+			(PixelInt)colorMap[colors[1]],
+			(PixelInt)colorMap[colors[2]],
+			(PixelInt)colorMap[colors[3]]
+		};
+
+		BlockDecoderRaw::drawBlendBlock<PixelInt>(blockPtr, pitch, converted, indexes, nullptr);
+	}
+};
+
 struct BlockDecoderDither {
 	static inline void drawFillBlock(byte *blockPtr, uint16 pitch, uint16 color, const byte *colorMap) {
 		const byte *mapOffset = colorMap + (color >> 1);
@@ -203,8 +240,8 @@ struct BlockDecoderDither {
 	}
 };
 
-template<typename PixelInt, typename BlockDecoder>
-static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt *ptr, uint16 pitch, uint16 blockWidth, uint16 blockHeight, const byte *colorMap) {
+template<typename PixelInt, typename BlockDecoder, typename ColorMap>
+static inline void decodeFrameTmpl(Common::SeekableReadStream &stream, PixelInt *ptr, uint16 pitch, uint16 blockWidth, uint16 blockHeight, const ColorMap *colorMap) {
 	uint16 colorA = 0, colorB = 0;
 	uint16 color4[4];
 
@@ -339,12 +376,44 @@ const Graphics::Surface *RPZADecoder::decodeFrame(Common::SeekableReadStream &st
 
 	if (_colorMap)
 		decodeFrameTmpl<byte, BlockDecoderDither>(stream, (byte *)_surface->getPixels(), _surface->pitch, _blockWidth, _blockHeight, _colorMap);
-	else
+	else if (!_rgbLookup)
 		decodeFrameTmpl<uint16, BlockDecoderRaw>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, _colorMap);
+	else if (_format.bytesPerPixel == 2)
+		decodeFrameTmpl<uint16, BlockDecoderConvert>(stream, (uint16 *)_surface->getPixels(), _surface->pitch / 2, _blockWidth, _blockHeight, _rgbLookup);
+	else
+		decodeFrameTmpl<uint32, BlockDecoderConvert>(stream, (uint32 *)_surface->getPixels(), _surface->pitch / 4, _blockWidth, _blockHeight, _rgbLookup);
 
 	return _surface;
 }
 
+bool RPZADecoder::setOutputPixelFormat(const Graphics::PixelFormat &format) {
+	if (_colorMap)
+		return format.isCLUT8();
+
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return false;
+
+	if (format == _format)
+		return true;
+
+	_format = format;
+
+	delete[] _rgbLookup;
+	_rgbLookup = 0;
+
+	// The stream colors are RGB555, so only other formats need converting
+	if (_format != Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0))
+		_rgbLookup = createRGB555Lookup(_format);
+
+	if (_surface) {
+		_surface->free();
+		delete _surface;
+		_surface = 0;
+	}
+
+	return true;
+}
+
 bool RPZADecoder::canDither(DitherType type) const {
 	return type == kDitherTypeQT;
 }
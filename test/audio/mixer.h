@@ -0,0 +1,275 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/decoders/raw.h"
+#include "common/atomic.h"
+#include "common/config-manager.h"
+#include "common/thread.h"
+#include "audio/mixer_profiler.h"
+
+#include "helper.h"
+#include "../system/null_osystem.h"
+
+class MixerTestSuite : public CxxTest::TestSuite
+{
+	struct CallbackThreadData {
+		Audio::MixerImpl *impl;
+		Common::Atomic<uint32> stop;
+	};
+
+	static void callbackThreadProc(void *data) {
+		CallbackThreadData *thread = (CallbackThreadData *)data;
+		int16 buffer[256];
+		while (!thread->stop.load()) {
+			thread->impl->mixCallback((byte *)buffer, sizeof(buffer));
+			g_system->delayMillis(1);
+		}
+	}
+
+	public:
+	void test_queued_commands() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Mono output keeps the SIMD mixers, which need a full backend to be
+		// selected, out of the picture
+		Audio::MixerImpl impl(22050, false);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, false), 7);
+
+		// The channel has not been seen by the mixer callback yet, but
+		// queries must already reflect the queued state
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT(mixer.isSoundIDActive(7));
+		TS_ASSERT_EQUALS(mixer.getSoundID(handle), 7);
+		TS_ASSERT(mixer.hasActiveChannelOfType(Audio::Mixer::kSFXSoundType));
+
+		// More commands than the queue holds must not block without a callback
+		for (int i = 0; i < 1000; i++)
+			mixer.setChannelVolume(handle, i % 256);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 999 % 256);
+
+		mixer.setChannelBalance(handle, -50);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -50);
+
+		int16 buffer[512];
+		const uint32 startTime = g_system->getMillis(true);
+		TS_ASSERT_EQUALS(impl.mixCallback((byte *)buffer, sizeof(buffer)), 512);
+
+		bool silent = true;
+		for (int i = 0; i < ARRAYSIZE(buffer); i++)
+			silent &= (buffer[i] == 0);
+		TS_ASSERT(!silent);
+		// Only the time passed since the callback is counted so far
+		TS_ASSERT_LESS_THAN_EQUALS((uint32)mixer.getElapsedTime(handle).msecs(), g_system->getMillis(true) - startTime);
+
+		impl.mixCallback((byte *)buffer, sizeof(buffer));
+		TS_ASSERT_LESS_THAN_EQUALS(512, mixer.getElapsedTime(handle).totalNumberOfFrames());
+
+		// Pausing is seen by queries right away, so the elapsed time stops
+		mixer.pauseHandle(handle, true);
+		const uint32 pausedTime = mixer.getSoundElapsedTime(handle);
+		g_system->delayMillis(20);
+		TS_ASSERT_EQUALS(mixer.getSoundElapsedTime(handle), pausedTime);
+
+		// A paused channel is not mixed
+		memset(buffer, 0, sizeof(buffer));
+		impl.mixCallback((byte *)buffer, sizeof(buffer));
+		for (int i = 0; i < ARRAYSIZE(buffer); i++)
+			TS_ASSERT_EQUALS(buffer[i], 0);
+		mixer.pauseHandle(handle, false);
+
+		// Stopping takes effect immediately
+		mixer.stopHandle(handle);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.isSoundIDActive(7));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+
+		// Commands for stale handles are ignored
+		mixer.setChannelVolume(handle, 10);
+		TS_ASSERT_EQUALS(impl.mixCallback((byte *)buffer, sizeof(buffer)), 0);
+#endif
+	}
+
+	void test_pause_with_running_callback() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl impl(22050, false, 256);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 60, nullptr, false, false));
+
+		CallbackThreadData data;
+		data.impl = &impl;
+		data.stop.store(0);
+		{
+			Common::Thread thread(callbackThreadProc, &data, "MixerTest");
+			// Without threads there is no callback running to test against
+			if (thread.isRunning()) {
+				while (mixer.getElapsedTime(handle).totalNumberOfFrames() == 0)
+					g_system->delayMillis(1);
+
+				// Pausing is carried out by the running callback before it returns
+				mixer.pauseHandle(handle, true);
+				const uint32 pausedTime = mixer.getSoundElapsedTime(handle);
+				g_system->delayMillis(20);
+				TS_ASSERT_EQUALS(mixer.getSoundElapsedTime(handle), pausedTime);
+
+				mixer.pauseHandle(handle, false);
+				g_system->delayMillis(20);
+				TS_ASSERT_LESS_THAN(pausedTime, mixer.getSoundElapsedTime(handle));
+
+				// Looping a playing sound must not hold up the callback either
+				mixer.loopChannel(handle);
+				TS_ASSERT(mixer.isSoundHandleActive(handle));
+			}
+
+			data.stop.store(1);
+		}
+
+		mixer.stopHandle(handle);
+#endif
+	}
+
+	void test_finished_channel() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl impl(22050, false);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kMusicSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, false));
+
+		int16 buffer[4096];
+		for (int i = 0; i < 8; i++)
+			impl.mixCallback((byte *)buffer, sizeof(buffer));
+
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT(!mixer.hasActiveChannelOfType(Audio::Mixer::kMusicSoundType));
+
+		// The slot can be reused, with a new handle
+		Audio::SoundHandle handle2;
+		mixer.playStream(Audio::Mixer::kMusicSoundType, &handle2, createSineStream<int16>(22050, 1, nullptr, false, false));
+		TS_ASSERT(mixer.isSoundHandleActive(handle2));
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+#endif
+	}
+
+	void test_resampler_after_rate_change() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		ConfMan.set("audio_resampler", "sinc");
+		Audio::MixerImpl impl(22050, false);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+		ConfMan.removeKey("audio_resampler", Common::ConfigManager::kApplicationDomain);
+
+		int16 samples[4096];
+		for (int i = 0; i < ARRAYSIZE(samples); i++)
+			samples[i] = (int16)((i * 2713) % 20000 - 10000);
+
+#ifdef SCUMM_LITTLE_ENDIAN
+		const byte flags = Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN;
+#else
+		const byte flags = Audio::FLAG_16BITS;
+#endif
+
+		// A channel created at the output rate and slowed down afterwards
+		// must be resampled the same way as one created at the lower rate
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle,
+			Audio::makeRawStream((const byte *)samples, sizeof(samples), 22050, flags, DisposeAfterUse::NO));
+		mixer.setChannelRate(handle, 11025);
+
+		int16 changed[1024];
+		impl.mixCallback((byte *)changed, sizeof(changed));
+		mixer.stopHandle(handle);
+
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle,
+			Audio::makeRawStream((const byte *)samples, sizeof(samples), 11025, flags, DisposeAfterUse::NO));
+
+		int16 expected[1024];
+		impl.mixCallback((byte *)expected, sizeof(expected));
+		mixer.stopHandle(handle);
+
+		int mismatches = 0;
+		for (int i = 0; i < ARRAYSIZE(expected); i++)
+			mismatches += (changed[i] != expected[i]) ? 1 : 0;
+		TS_ASSERT_EQUALS(mismatches, 0);
+#endif
+	}
+
+	void test_profiler_buckets() {
+		TS_ASSERT_EQUALS(Audio::MixerProfiler::getBucketIndex(0), 0);
+		TS_ASSERT_EQUALS(Audio::MixerProfiler::getBucketIndex(63), 0);
+		TS_ASSERT_EQUALS(Audio::MixerProfiler::getBucketIndex(64), 1);
+		TS_ASSERT_EQUALS(Audio::MixerProfiler::getBucketIndex(127), 1);
+		TS_ASSERT_EQUALS(Audio::MixerProfiler::getBucketIndex(128), 2);
+		TS_ASSERT_EQUALS(Audio::MixerProfiler::getBucketIndex(0xffffffff), Audio::MixerProfiler::kNumHistogramBuckets - 1);
+	}
+
+	void test_profiler() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl impl(22050, false);
+		Audio::Mixer &mixer = impl;
+		impl.setReady(true);
+
+		Audio::MixerProfiler *profiler = mixer.getProfiler();
+		TS_ASSERT(profiler);
+		TS_ASSERT(!profiler->isEnabled());
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSpeechSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, false), 3);
+
+		int16 buffer[512];
+		impl.mixCallback((byte *)buffer, sizeof(buffer));
+		TS_ASSERT_EQUALS(profiler->getNumCallbacks(), 0u);
+
+		profiler->setEnabled(true);
+		for (int i = 0; i < 4; i++)
+			impl.mixCallback((byte *)buffer, sizeof(buffer));
+
+		TS_ASSERT_EQUALS(profiler->getNumCallbacks(), 4u);
+		uint32 total = 0;
+		for (int i = 0; i < Audio::MixerProfiler::kNumHistogramBuckets; i++)
+			total += profiler->getHistogramBucket(i);
+		TS_ASSERT_EQUALS(total, 4u);
+
+		bool found = false;
+		for (int i = 0; i < Audio::MixerProfiler::kNumChannels; i++) {
+			Audio::MixerProfiler::ChannelStats stats;
+			if (profiler->getChannelStats(i, stats)) {
+				found = true;
+				TS_ASSERT_EQUALS(stats.id, 3);
+				TS_ASSERT_EQUALS(stats.type, Audio::Mixer::kSpeechSoundType);
+				TS_ASSERT_EQUALS(stats.calls, 4u);
+				TS_ASSERT_EQUALS(stats.frames, 4u * 512);
+				TS_ASSERT_EQUALS(stats.starvations, 0u);
+			}
+		}
+		TS_ASSERT(found);
+
+		// Stopped sounds move to the finished list
+		mixer.stopHandle(handle);
+		for (int i = 0; i < Audio::MixerProfiler::kNumChannels; i++) {
+			Audio::MixerProfiler::ChannelStats stats;
+			TS_ASSERT(!profiler->getChannelStats(i, stats));
+		}
+		TS_ASSERT(!profiler->getReport().empty());
+
+		profiler->reset();
+		TS_ASSERT_EQUALS(profiler->getNumCallbacks(), 0u);
+#endif
+	}
+};
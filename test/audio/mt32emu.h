@@ -0,0 +1,62 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+
+#ifdef USE_MT32EMU
+// Avoid the FileStream API, which needs the standard library
+#define MT32EMU_FILE_STREAM_H
+
+#include "audio/softsynth/mt32/c_interface/cpp_interface.h"
+#include "audio/softsynth/mt32/BReverbModel.h"
+#endif
+
+class MT32EmuTestSuite : public CxxTest::TestSuite
+{
+#ifdef USE_MT32EMU
+	static const uint kReverbLength = 3000;
+
+	template<class Sample>
+	static void checkReverbBlocks(MT32Emu::RendererType rendererType, Sample scale) {
+		Sample inLeft[kReverbLength], inRight[kReverbLength];
+		uint32 seed = 1;
+		for (uint i = 0; i < kReverbLength; i++) {
+			// A burst of noise followed by silence, to hear the tail
+			seed = seed * 1103515245 + 12345;
+			inLeft[i] = i < 500 ? Sample((int16)(seed >> 16)) * scale : 0;
+			inRight[i] = i < 500 ? Sample((int16)(seed >> 8)) * scale : 0;
+		}
+
+		for (int mode = MT32Emu::REVERB_MODE_ROOM; mode <= MT32Emu::REVERB_MODE_TAP_DELAY; mode++) {
+			MT32Emu::BReverbModel *whole = MT32Emu::BReverbModel::createBReverbModel((MT32Emu::ReverbMode)mode, true, rendererType);
+			MT32Emu::BReverbModel *single = MT32Emu::BReverbModel::createBReverbModel((MT32Emu::ReverbMode)mode, true, rendererType);
+			whole->open();
+			single->open();
+			whole->setParameters(5, 6);
+			single->setParameters(5, 6);
+
+			// Processing a sample at a time runs the stages in the original order
+			Sample wholeLeft[kReverbLength], wholeRight[kReverbLength];
+			Sample singleLeft[kReverbLength], singleRight[kReverbLength];
+			TS_ASSERT(whole->process(inLeft, inRight, wholeLeft, wholeRight, kReverbLength));
+			for (uint i = 0; i < kReverbLength; i++)
+				TS_ASSERT(single->process(inLeft + i, inRight + i, singleLeft + i, singleRight + i, 1));
+
+			TS_ASSERT_SAME_DATA(wholeLeft, singleLeft, sizeof(wholeLeft));
+			TS_ASSERT_SAME_DATA(wholeRight, singleRight, sizeof(wholeRight));
+			TS_ASSERT(whole->isActive());
+
+			delete whole;
+			delete single;
+		}
+	}
+
+#endif
+
+	public:
+	void test_reverb_blocks() {
+#ifdef USE_MT32EMU
+		checkReverbBlocks<MT32Emu::IntSample>(MT32Emu::RendererType_BIT16S, 1);
+		checkReverbBlocks<MT32Emu::FloatSample>(MT32Emu::RendererType_FLOAT, 1.0f / 32768);
+#endif
+	}
+};
@@ -0,0 +1,219 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "audio/decoders/raw.h"
+#include "audio/rate_intern.h"
+
+#include "common/memstream.h"
+#include "common/textconsole.h"
+
+#include <math.h>
+
+class RateMixerTestSuite : public CxxTest::TestSuite {
+private:
+	static const int kMaxFrames = 67;
+
+	static int16 nextSample(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return (int16)(seed >> 8);
+	}
+
+	template<bool inStereo, bool reverseStereo>
+	void compareWithGeneric(Audio::RateMixer::MixFunc func) {
+		static const Audio::st_volume_t volumes[] = { 0, 1, 127, 255, 256 };
+		uint32 seed = 0x5eed;
+
+		for (int frames = 0; frames <= kMaxFrames; frames++) {
+			for (int v = 0; v < ARRAYSIZE(volumes); v++) {
+				int16 src[kMaxFrames * 2], expected[kMaxFrames * 2], actual[kMaxFrames * 2];
+
+				for (int i = 0; i < kMaxFrames * 2; i++) {
+					src[i] = nextSample(seed);
+					expected[i] = actual[i] = nextSample(seed);
+				}
+				// Exercise saturation at both ends
+				src[0] = -32768;
+				expected[0] = actual[0] = -32000;
+				src[1] = 32767;
+				expected[1] = actual[1] = 32000;
+
+				const Audio::st_volume_t volL = volumes[v];
+				const Audio::st_volume_t volR = volumes[ARRAYSIZE(volumes) - 1 - v];
+
+				Audio::RateMixer::mixFunc = Audio::RateMixer::mixNone;
+				Audio::RateMixer::mix<inStereo, true, reverseStereo>(expected, src, frames, volL, volR);
+
+				Audio::RateMixer::mixFunc = func;
+				Audio::RateMixer::mix<inStereo, true, reverseStereo>(actual, src, frames, volL, volR);
+
+				TS_ASSERT_EQUALS(memcmp(expected, actual, sizeof(expected)), 0);
+			}
+		}
+	}
+
+	static Audio::AudioStream *makeToneStream(int rate, double freq, int numSamples) {
+		int16 *samples = (int16 *)malloc(numSamples * sizeof(int16));
+		for (int i = 0; i < numSamples; i++)
+			samples[i] = (int16)(sin(2 * M_PI * freq * i / rate) * 16000);
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream((const byte *)samples, numSamples * sizeof(int16), DisposeAfterUse::YES);
+		return Audio::makeRawStream(stream, rate, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                            | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                            );
+	}
+
+	/** Amplitude of freq in samples, using the Goertzel algorithm over a Hann window. */
+	static double toneLevel(const int16 *samples, int numSamples, int rate, double freq) {
+		const double coeff = 2 * cos(2 * M_PI * freq / rate);
+		double s1 = 0, s2 = 0;
+		for (int i = 0; i < numSamples; i++) {
+			const double window = 0.5 - 0.5 * cos(2 * M_PI * i / (numSamples - 1));
+			const double s0 = samples[i] * window + coeff * s1 - s2;
+			s2 = s1;
+			s1 = s0;
+		}
+		return sqrt(s1 * s1 + s2 * s2 - coeff * s1 * s2);
+	}
+
+	/**
+	 * Upsample a tone from 11025Hz to 48000Hz and return the level of its
+	 * first image (at 11025Hz - freq) relative to the tone itself, in dB.
+	 */
+	static double imageRejection(Audio::ResamplerQuality quality) {
+		const int inRate = 11025, outRate = 48000, outSamples = 48000;
+		const double freq = 3000;
+
+		Audio::AudioStream *input = makeToneStream(inRate, freq, inRate + 1024);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false, false, false, quality);
+		int16 *output = new int16[outSamples];
+		memset(output, 0, outSamples * sizeof(int16));
+		converter->convert(*input, output, outSamples, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+
+		// Skip the start, where the filter is still filling up
+		const double tone = toneLevel(output + 1024, outSamples - 1024, outRate, freq);
+		const double image = toneLevel(output + 1024, outSamples - 1024, outRate, inRate - freq);
+
+		delete[] output;
+		delete converter;
+		delete input;
+		return 20 * log10(image / tone);
+	}
+
+	static int convertAll(Audio::ResamplerQuality quality, int inRate, int outRate, int numSamples) {
+		Audio::AudioStream *input = makeToneStream(inRate, 440, numSamples);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false, true, false, quality);
+		int16 output[2048];
+		int total = 0, len;
+		do {
+			memset(output, 0, sizeof(output));
+			len = converter->convert(*input, output, ARRAYSIZE(output) / 2, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			total += len;
+		} while (!(input->endOfStream() && !converter->needsDraining()));
+
+		delete converter;
+		delete input;
+		return total;
+	}
+
+	void compareAllLayouts(Audio::RateMixer::MixFunc func) {
+		compareWithGeneric<true, false>(func);
+		compareWithGeneric<true, true>(func);
+		compareWithGeneric<false, false>(func);
+	}
+
+public:
+	void setUp() {
+		Audio::RateMixer::mixFunc = Audio::RateMixer::mixNone;
+	}
+
+	void tearDown() {
+		Audio::RateMixer::mixFunc = nullptr;
+	}
+
+	void test_sinc_constant() {
+		const int numSamples = 4096;
+		int16 *samples = (int16 *)malloc(numSamples * sizeof(int16));
+		for (int i = 0; i < numSamples; i++)
+			samples[i] = 12345;
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream((const byte *)samples, numSamples * sizeof(int16), DisposeAfterUse::YES);
+		Audio::AudioStream *input = Audio::makeRawStream(stream, 22050, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                 | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                 );
+
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 44100, false, false, false, Audio::kResamplerSinc);
+		int16 output[2048];
+		memset(output, 0, sizeof(output));
+		TS_ASSERT_EQUALS(converter->convert(*input, output, ARRAYSIZE(output), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), (int)ARRAYSIZE(output));
+
+		// Past the filter delay, a constant signal must come through unchanged
+		for (int i = 64; i < ARRAYSIZE(output); i++)
+			TS_ASSERT_EQUALS(output[i], 12345);
+
+		delete converter;
+		delete input;
+	}
+
+	void test_sinc_length() {
+		// The filter delay is flushed at the end of the stream, so no input is lost
+		TS_ASSERT_EQUALS(convertAll(Audio::kResamplerLinear, 11025, 22050, 11025), 22050);
+		TS_ASSERT_EQUALS(convertAll(Audio::kResamplerSinc, 11025, 22050, 11025), 22050);
+		TS_ASSERT_EQUALS(convertAll(Audio::kResamplerSinc, 44100, 22050, 44100), 22050);
+	}
+
+	void test_sinc_matching_rate() {
+		const int rate = 22050, numSamples = 4096, split = 1000;
+		Audio::AudioStream *input = makeToneStream(rate, 440, numSamples);
+		Audio::RateConverter *converter = Audio::makeRateConverter(rate, rate, false, false, false, Audio::kResamplerSinc);
+		int16 output[split];
+		memset(output, 0, sizeof(output));
+		TS_ASSERT_EQUALS(converter->convert(*input, output, split, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume), split);
+
+		// Matching rates must copy the input verbatim
+		for (int i = 0; i < split; i++)
+			TS_ASSERT_EQUALS(output[i], (int16)(sin(2 * M_PI * 440 * i / rate) * 16000));
+
+		// Halving the rate afterwards must not lose the input already buffered
+		converter->setOutputRate(rate / 2);
+		int total = 0, len;
+		do {
+			len = converter->convert(*input, output, split, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			total += len;
+		} while (!(input->endOfStream() && !converter->needsDraining()));
+		TS_ASSERT_EQUALS(total, (numSamples - split) / 2);
+
+		delete converter;
+		delete input;
+	}
+
+	void test_sinc_image_rejection() {
+		const double linear = imageRejection(Audio::kResamplerLinear);
+		const double sinc = imageRejection(Audio::kResamplerSinc);
+
+		TS_ASSERT_LESS_THAN(sinc, -60.0);
+		TS_ASSERT_LESS_THAN(sinc, linear - 30.0);
+	}
+
+	void test_mix_sse2() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			compareAllLayouts(Audio::RateMixer::mixSSE2);
+#endif
+	}
+
+	void test_mix_avx2() {
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			compareAllLayouts(Audio::RateMixer::mixAVX2);
+#endif
+	}
+
+	void test_mix_neon() {
+#ifdef SCUMMVM_NEON
+		compareAllLayouts(Audio::RateMixer::mixNEON);
+#endif
+	}
+};
@@ -0,0 +1,205 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/soundcache.h"
+#include "audio/decoders/raw.h"
+
+#include "common/config-manager.h"
+#include "common/memstream.h"
+
+#include "../system/null_osystem.h"
+
+static int numDecodes = 0;
+
+static Audio::SeekableAudioStream *makeTestStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse) {
+	numDecodes++;
+
+	byte flags = Audio::FLAG_16BITS | Audio::FLAG_STEREO;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= Audio::FLAG_LITTLE_ENDIAN;
+#endif
+	return Audio::makeRawStream(stream, 11025, flags, disposeAfterUse);
+}
+
+class SoundCacheTestSuite : public CxxTest::TestSuite
+{
+	int16 _data[4096];
+
+	Common::SeekableReadStream *makeData() {
+		return new Common::MemoryReadStream((const byte *)_data, sizeof(_data));
+	}
+
+	static int readAll(Audio::AudioStream *stream, int16 *buffer, int size) {
+		int total = 0;
+		while (!stream->endOfData() && total < size) {
+			const int read = stream->readBuffer(buffer + total, MIN(size - total, 1000));
+			if (read <= 0)
+				break;
+			total += read;
+		}
+		return total;
+	}
+
+	/** Play a sound through the cache to the end. */
+	void play(uint32 offset) {
+		int16 buffer[5000];
+		Audio::SeekableAudioStream *stream = SoundCacheMan.makeStream("sounds.dat", offset, makeData(), DisposeAfterUse::YES, makeTestStream);
+		TS_ASSERT_EQUALS(readAll(stream, buffer, ARRAYSIZE(buffer)), 4096);
+		delete stream;
+	}
+
+	public:
+	void setUp() {
+		for (int i = 0; i < ARRAYSIZE(_data); i++)
+			_data[i] = i * 7;
+		numDecodes = 0;
+	}
+
+	void tearDown() {
+		ConfMan.removeKey("sound_cache_size", Common::ConfigManager::kApplicationDomain);
+		if (Audio::SoundCacheManager::hasInstance())
+			SoundCacheMan.clear();
+	}
+
+	void test_replay() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		TS_ASSERT(!SoundCacheMan.getStream("sounds.dat", 16));
+
+		int16 buffer[5000];
+		for (int i = 0; i < 3; i++) {
+			Audio::SeekableAudioStream *stream = SoundCacheMan.makeStream("sounds.dat", 16, makeData(), DisposeAfterUse::YES, makeTestStream);
+			TS_ASSERT(stream);
+			TS_ASSERT(stream->isStereo());
+			TS_ASSERT_EQUALS(stream->getRate(), 11025);
+			TS_ASSERT_EQUALS(stream->getLength().totalNumberOfFrames(), 2048);
+			TS_ASSERT_EQUALS(readAll(stream, buffer, ARRAYSIZE(buffer)), 4096);
+			TS_ASSERT_SAME_DATA(buffer, _data, sizeof(_data));
+			delete stream;
+		}
+
+		// Only the first request decodes
+		TS_ASSERT_EQUALS(numDecodes, 1);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 1u);
+		TS_ASSERT_EQUALS(SoundCacheMan.getSize(), sizeof(_data));
+
+		// Different offsets are different sounds
+		play(32);
+		TS_ASSERT_EQUALS(numDecodes, 2);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 2u);
+#endif
+	}
+
+	void test_partial_play() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Sounds are only cached once they were played to the end
+		int16 buffer[1000];
+		Audio::SeekableAudioStream *stream = SoundCacheMan.makeStream("sounds.dat", 0, makeData(), DisposeAfterUse::YES, makeTestStream);
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 1000), 1000);
+		TS_ASSERT_SAME_DATA(buffer, _data, sizeof(buffer));
+		delete stream;
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 0u);
+
+		// Or if they were seeked in
+		stream = SoundCacheMan.makeStream("sounds.dat", 0, makeData(), DisposeAfterUse::YES, makeTestStream);
+		TS_ASSERT(stream->seek(Audio::Timestamp(0, 1000, 11025)));
+		TS_ASSERT_EQUALS(readAll(stream, buffer, ARRAYSIZE(buffer)), 1000);
+		TS_ASSERT_SAME_DATA(buffer, _data + 2000, sizeof(buffer));
+		delete stream;
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 0u);
+
+		play(0);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 1u);
+		TS_ASSERT_EQUALS(numDecodes, 3);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumMisses(), 3u);
+#endif
+	}
+
+	void test_seek() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::SeekableAudioStream *stream = SoundCacheMan.makeStream("sounds.dat", 0, makeData(), DisposeAfterUse::YES, makeTestStream);
+		TS_ASSERT(stream);
+
+		int16 buffer[16];
+		TS_ASSERT(stream->seek(Audio::Timestamp(0, 1000, 11025)));
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 16), 16);
+		TS_ASSERT_SAME_DATA(buffer, _data + 2000, sizeof(buffer));
+
+		TS_ASSERT(!stream->seek(Audio::Timestamp(0, 3000, 11025)));
+		TS_ASSERT(stream->endOfData());
+
+		TS_ASSERT(stream->rewind());
+		TS_ASSERT_EQUALS(stream->readBuffer(buffer, 16), 16);
+		TS_ASSERT_SAME_DATA(buffer, _data, sizeof(buffer));
+		delete stream;
+#endif
+	}
+
+	void test_eviction() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Room for four sounds of 8 KB each
+		ConfMan.setInt("sound_cache_size", 32, Common::ConfigManager::kApplicationDomain);
+
+		for (int i = 0; i < 4; i++)
+			play(i);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 4u);
+
+		// Touch the first sound, so that the second one is evicted next
+		Audio::SeekableAudioStream *first = SoundCacheMan.getStream("sounds.dat", 0);
+		TS_ASSERT(first);
+
+		play(4);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 4u);
+		TS_ASSERT_EQUALS(SoundCacheMan.getSize(), 32u * 1024);
+
+		Audio::SeekableAudioStream *stream = SoundCacheMan.getStream("sounds.dat", 0);
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT(!SoundCacheMan.getStream("sounds.dat", 1));
+
+		// Streams keep playing after their sound is evicted
+		SoundCacheMan.clear();
+		int16 buffer[5000];
+		TS_ASSERT_EQUALS(readAll(first, buffer, ARRAYSIZE(buffer)), 4096);
+		TS_ASSERT_SAME_DATA(buffer, _data, sizeof(_data));
+		delete first;
+#endif
+	}
+
+	void test_uncacheable() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// Sounds over a quarter of the cache size are passed through
+		ConfMan.setInt("sound_cache_size", 16, Common::ConfigManager::kApplicationDomain);
+
+		Audio::SeekableAudioStream *stream = SoundCacheMan.makeStream("sounds.dat", 0, makeData(), DisposeAfterUse::YES, makeTestStream);
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 0u);
+
+		int16 buffer[5000];
+		TS_ASSERT_EQUALS(readAll(stream, buffer, ARRAYSIZE(buffer)), 4096);
+		TS_ASSERT_SAME_DATA(buffer, _data, sizeof(_data));
+		delete stream;
+
+		// Such sounds are remembered, and still counted as misses
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumUncacheable(), 1u);
+		play(0);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumUncacheable(), 1u);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumMisses(), 2u);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumHits(), 0u);
+
+		// A size of 0 disables the cache
+		ConfMan.setInt("sound_cache_size", 0, Common::ConfigManager::kApplicationDomain);
+		delete SoundCacheMan.makeStream("sounds.dat", 0, makeData(), DisposeAfterUse::YES, makeTestStream);
+		TS_ASSERT_EQUALS(SoundCacheMan.getNumSounds(), 0u);
+#endif
+	}
+};
@@ -0,0 +1,59 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/graphics/null/null-graphics.h"
+
+#include "common/array.h"
+#include "common/rect.h"
+
+class GraphicsManagerTestSuite : public CxxTest::TestSuite
+{
+	/** Records the copies which reach copyRectToScreen(). */
+	class CopyRecordingGraphicsManager : public NullGraphicsManager {
+	public:
+		struct Copy {
+			const void *buf;
+			int pitch;
+			Common::Rect rect;
+		};
+
+		void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) override {
+			Copy copy;
+			copy.buf = buf;
+			copy.pitch = pitch;
+			copy.rect = Common::Rect(x, y, x + w, y + h);
+			_copies.push_back(copy);
+		}
+
+		Common::Array<Copy> _copies;
+	};
+
+	public:
+	void test_copy_rects_to_screen() {
+		const Common::Rect rects[] = {
+			Common::Rect(0, 0, 320, 200),
+			Common::Rect(10, 20, 30, 25),
+			Common::Rect(319, 199, 320, 200)
+		};
+		const int pitch = 640;
+		static byte buffer[640 * 200];
+
+		CopyRecordingGraphicsManager manager;
+#ifdef USE_RGB_COLOR
+		const Graphics::PixelFormat format(2, 5, 6, 5, 0, 11, 5, 0, 0);
+		manager.initSize(320, 200, &format);
+		const int bytesPerPixel = 2;
+#else
+		manager.initSize(320, 200);
+		const int bytesPerPixel = 1;
+#endif
+		manager.copyRectsToScreen(buffer, pitch, rects, ARRAYSIZE(rects));
+
+		TS_ASSERT_EQUALS(manager._copies.size(), (uint)ARRAYSIZE(rects));
+		for (uint i = 0; i < manager._copies.size(); i++) {
+			const CopyRecordingGraphicsManager::Copy &copy = manager._copies[i];
+			TS_ASSERT_EQUALS(copy.buf, (const void *)(buffer + rects[i].top * pitch + rects[i].left * bytesPerPixel));
+			TS_ASSERT_EQUALS(copy.pitch, pitch);
+			TS_ASSERT_EQUALS(copy.rect, rects[i]);
+		}
+	}
+};
@@ -0,0 +1,167 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/fs/fs-factory.h"
+#include "backends/fs/posix/posix-mmapstream.h"
+
+#include "common/config-manager.h"
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/prefetch.h"
+
+#include "../system/null_osystem.h"
+
+// Written into the build directory, removed by 'make clean'
+static const char *const kMmapTestFile = "test/mmapstream.dat";
+
+class PosixMmapStreamTestSuite : public CxxTest::TestSuite
+{
+	static byte getTestByte(uint32 pos) {
+		return (byte)(pos * 7 + pos / 251);
+	}
+
+	static void writeTestFile(uint32 size) {
+		Common::DumpFile file;
+		TS_ASSERT(file.open(Common::FSNode(kMmapTestFile)));
+
+		byte buffer[4096];
+		for (uint32 pos = 0; pos < size; pos += sizeof(buffer)) {
+			const uint32 chunk = MIN<uint32>(size - pos, sizeof(buffer));
+			for (uint32 i = 0; i < chunk; i++)
+				buffer[i] = getTestByte(pos + i);
+			file.write(buffer, chunk);
+		}
+	}
+
+	static bool isMapped(Common::SeekableReadStream *stream) {
+		return dynamic_cast<PosixMmapStream *>(stream) != nullptr;
+	}
+
+	/** The settings are only picked up when a game starts. */
+	static void applySettings() {
+		g_system->getFilesystemFactory()->engineInit();
+	}
+
+	public:
+	void tearDown() {
+		ConfMan.removeKey("mmap_game_data", Common::ConfigManager::kApplicationDomain);
+		ConfMan.removeKey("savepath", Common::ConfigManager::kApplicationDomain);
+		applySettings();
+	}
+
+	void test_disabled_by_default() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		writeTestFile(PosixMmapStream::kMinMappedSize);
+
+		Common::SeekableReadStream *stream = Common::FSNode(kMmapTestFile).createReadStream();
+		TS_ASSERT(stream);
+		TS_ASSERT(!isMapped(stream));
+		delete stream;
+#endif
+	}
+
+	void test_read() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		Common::install_null_g_system();
+
+		ConfMan.setBool("mmap_game_data", true, Common::ConfigManager::kApplicationDomain);
+		applySettings();
+		const uint32 size = PosixMmapStream::kMinMappedSize + 1000;
+		writeTestFile(size);
+
+		Common::SeekableReadStream *stream = Common::FSNode(kMmapTestFile).createReadStream();
+		TS_ASSERT(isMapped(stream));
+		TS_ASSERT_EQUALS(stream->size(), (int64)size);
+
+		byte buffer[16];
+		TS_ASSERT(stream->seek(123456));
+		TS_ASSERT_EQUALS(stream->read(buffer, sizeof(buffer)), sizeof(buffer));
+		for (uint32 i = 0; i < sizeof(buffer); i++)
+			TS_ASSERT_EQUALS(buffer[i], getTestByte(123456 + i));
+
+		// Views into the mapping stay valid after the file is closed
+		TS_ASSERT(stream->seek(size - 100));
+		Common::SeekableReadStream *view = stream->readStream(200);
+		TS_ASSERT(stream->eos());
+		delete stream;
+
+		TS_ASSERT_EQUALS(view->size(), 100);
+		for (uint32 i = 0; i < 100; i++)
+			TS_ASSERT_EQUALS(view->readByte(), getTestByte(size - 100 + i));
+		delete view;
+#endif
+	}
+
+	void test_not_mapped() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		ConfMan.setBool("mmap_game_data", true, Common::ConfigManager::kApplicationDomain);
+
+		// Savefiles may be truncated while mapped
+		writeTestFile(PosixMmapStream::kMinMappedSize);
+		ConfMan.set("savepath", "test", Common::ConfigManager::kApplicationDomain);
+		applySettings();
+		Common::SeekableReadStream *stream = Common::FSNode(kMmapTestFile).createReadStream();
+		TS_ASSERT(stream);
+		TS_ASSERT(!isMapped(stream));
+		delete stream;
+
+		// Small files are not worth mapping
+		ConfMan.removeKey("savepath", Common::ConfigManager::kApplicationDomain);
+		applySettings();
+		writeTestFile(1000);
+		stream = Common::FSNode(kMmapTestFile).createReadStream();
+		TS_ASSERT(stream);
+		TS_ASSERT(!isMapped(stream));
+		TS_ASSERT_EQUALS(stream->size(), 1000);
+		delete stream;
+#endif
+	}
+
+	void test_settings_cached() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		Common::install_null_g_system();
+
+		ConfMan.setBool("mmap_game_data", true, Common::ConfigManager::kApplicationDomain);
+		applySettings();
+		writeTestFile(PosixMmapStream::kMinMappedSize);
+
+		// Streams may be created on other threads while the game runs, so
+		// changes are only seen once the settings are applied again
+		ConfMan.setBool("mmap_game_data", false, Common::ConfigManager::kApplicationDomain);
+		Common::SeekableReadStream *stream = Common::FSNode(kMmapTestFile).createReadStream();
+		TS_ASSERT(isMapped(stream));
+		delete stream;
+
+		applySettings();
+		stream = Common::FSNode(kMmapTestFile).createReadStream();
+		TS_ASSERT(stream);
+		TS_ASSERT(!isMapped(stream));
+		delete stream;
+#endif
+	}
+
+	void test_prefetch_keeps_mapping() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(HAS_MMAP)
+		Common::install_null_g_system();
+
+		ConfMan.setBool("mmap_game_data", true, Common::ConfigManager::kApplicationDomain);
+		applySettings();
+		writeTestFile(PosixMmapStream::kMinMappedSize);
+
+		Common::FSDirectory dir("test");
+		Common::Array<Common::Path> paths;
+		paths.push_back("mmapstream.dat");
+		Common::PrefetchRequestPtr request = dir.prefetch(paths);
+		request->wait();
+
+		// The mapped file is not copied into memory
+		Common::SeekableReadStream *stream = request->takeStream("mmapstream.dat");
+		TS_ASSERT(isMapped(stream));
+		delete stream;
+		PrefetchMan.clear();
+#endif
+	}
+};
@@ -0,0 +1,58 @@
+#ifndef TEST_BENCHMARK_ALLOCATIONS_H
+#define TEST_BENCHMARK_ALLOCATIONS_H
+
+#include <stdlib.h>
+
+/**
+ * Counting of the heap allocations made by the benchmarks.
+ *
+ * The benchmarks are built into a runner of their own, so malloc() and
+ * friends can be replaced there to count the allocations of the code
+ * measured, including those of the libraries it uses. This relies on
+ * glibc, which allows replacing them and still exports its own versions.
+ * Elsewhere, the allocations are not counted.
+ */
+namespace Benchmark {
+
+#if defined(__GLIBC__)
+#define BENCHMARK_COUNTS_ALLOCATIONS 1
+#else
+#define BENCHMARK_COUNTS_ALLOCATIONS 0
+#endif
+
+/** The number of allocations made since the runner started. */
+size_t allocationCount = 0;
+
+} // End of namespace Benchmark
+
+#if BENCHMARK_COUNTS_ALLOCATIONS
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void __libc_free(void *ptr);
+
+void *malloc(size_t size) __THROW {
+	Benchmark::allocationCount++;
+	return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) __THROW {
+	Benchmark::allocationCount++;
+	return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) __THROW {
+	Benchmark::allocationCount++;
+	return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) __THROW {
+	__libc_free(ptr);
+}
+
+} // End of extern "C"
+#endif
+
+#endif
@@ -0,0 +1,153 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audiostream.h"
+#include "audio/decoders/raw.h"
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+#include "../system/null_osystem.h"
+
+#include <math.h>
+
+#ifdef USE_MT32EMU
+// Avoid the FileStream API, which needs the standard library
+#define MT32EMU_FILE_STREAM_H
+
+#include "audio/softsynth/mt32/c_interface/cpp_interface.h"
+#endif
+
+/**
+ * Measures how fast the resamplers and the MT-32 emulator produce samples.
+ *
+ * The MT-32 ROMs are not distributed with ScummVM, so the emulator is only
+ * measured if MT32_CONTROL.ROM and MT32_PCM.ROM are in the working directory.
+ */
+class AudioBenchmarkSuite : public CxxTest::TestSuite {
+	static const int kResampleSeconds = 60;
+
+	/** Resample a 440Hz tone of @p numSamples mono samples to stereo, and return the time it took in milliseconds. */
+	static uint32 timeResample(Audio::ResamplerQuality quality, int inRate, int outRate, int numSamples) {
+		int16 *samples = (int16 *)malloc(numSamples * sizeof(int16));
+		for (int i = 0; i < numSamples; i++)
+			samples[i] = (int16)(sin(2 * M_PI * 440 * i / inRate) * 16000);
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream((const byte *)samples, numSamples * sizeof(int16), DisposeAfterUse::YES);
+		Audio::AudioStream *input = Audio::makeRawStream(stream, inRate, Audio::FLAG_16BITS
+#ifdef SCUMM_LITTLE_ENDIAN
+		                                                 | Audio::FLAG_LITTLE_ENDIAN
+#endif
+		                                                 );
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, false, true, false, quality);
+
+		const uint32 start = g_system->getMillis();
+		int16 output[2048];
+		do {
+			memset(output, 0, sizeof(output));
+			converter->convert(*input, output, ARRAYSIZE(output) / 2, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+		} while (!(input->endOfStream() && !converter->needsDraining()));
+		const uint32 time = MAX<uint32>(g_system->getMillis() - start, 1);
+
+		delete converter;
+		delete input;
+		return time;
+	}
+
+#ifdef USE_MT32EMU
+	static bool addROM(MT32Emu::Service &service, const char *name, mt32emu_return_code expected, byte *&data) {
+		Common::FSNode node(name);
+		Common::SeekableReadStream *stream = node.exists() ? node.createReadStream() : nullptr;
+		if (!stream)
+			return false;
+
+		const uint32 size = stream->size();
+		data = new byte[size];
+		stream->read(data, size);
+		delete stream;
+
+		return service.addROMData(data, size) == expected;
+	}
+#endif
+
+public:
+	void test_resampler() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		const uint32 linearTime = timeResample(Audio::kResamplerLinear, 11025, 48000, 11025 * kResampleSeconds);
+		const uint32 sincTime = timeResample(Audio::kResamplerSinc, 11025, 48000, 11025 * kResampleSeconds);
+
+		TS_TRACE(Common::String::format("Resampler: %d seconds of 11025Hz mono to 48000Hz stereo in %u ms linear, %u ms sinc",
+			kResampleSeconds, linearTime, sincTime).c_str());
+#endif
+	}
+
+	/** Render a fixed MIDI sequence and report how many frames per second the emulator produces. */
+	void test_mt32emu_synth() {
+#if defined(USE_MT32EMU) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		MT32Emu::Service service;
+		service.createContext();
+
+		byte *controlData = nullptr, *pcmData = nullptr;
+		if (!addROM(service, "MT32_CONTROL.ROM", MT32EMU_RC_ADDED_CONTROL_ROM, controlData) ||
+		    !addROM(service, "MT32_PCM.ROM", MT32EMU_RC_ADDED_PCM_ROM, pcmData)) {
+			TS_TRACE("MT-32 ROMs not found, skipping the benchmark");
+			service.freeContext();
+			delete[] controlData;
+			delete[] pcmData;
+			return;
+		}
+
+		TS_ASSERT_EQUALS(service.openSynth(), MT32EMU_RC_OK);
+		service.setMIDIDelayMode(MT32Emu::MIDIDelayMode_IMMEDIATE);
+
+		const uint32 rate = service.getActualStereoOutputSamplerate();
+		const uint32 framesPerStep = rate / 20;
+		int16 buffer[2 * 4096];
+		assert(framesPerStep <= ARRAYSIZE(buffer) / 2);
+
+		static const byte programs[] = { 0, 48, 33, 88, 52, 61, 24, 11 };
+		static const byte chord[] = { 48, 55, 60, 64, 67, 72 };
+
+		const uint32 startMillis = g_system->getMillis();
+		uint32 frames = 0;
+
+		// 30 seconds of chords played on eight parts, changing every half second
+		for (int step = 0; step < 600; step++) {
+			if (step % 10 == 0) {
+				for (int channel = 1; channel <= 8; channel++) {
+					if (step == 0)
+						service.playMsg(0xC0 | channel | (programs[channel - 1] << 8));
+					else
+						service.playMsg(0xB0 | channel | (0x7B << 8));
+
+					const byte root = (step / 10) % 12;
+					for (int note = 0; note < ARRAYSIZE(chord); note += 2) {
+						const byte key = chord[(note + channel) % ARRAYSIZE(chord)] + root;
+						service.playMsg(0x90 | channel | (key << 8) | (100 << 16));
+					}
+				}
+			}
+
+			service.renderBit16s(buffer, framesPerStep);
+			frames += framesPerStep;
+		}
+
+		const uint32 elapsed = MAX<uint32>(g_system->getMillis() - startMillis, 1);
+		TS_TRACE(Common::String::format("MT-32: rendered %u frames in %u ms, %u frames per second (%.1fx real time)",
+			frames, elapsed, (uint32)((uint64)frames * 1000 / elapsed), (double)frames * 1000 / elapsed / rate).c_str());
+
+		service.closeSynth();
+		service.freeContext();
+		delete[] controlData;
+		delete[] pcmData;
+#endif
+	}
+};
@@ -0,0 +1,99 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/str.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+#include "graphics/surface.h"
+
+#include "../system/null_osystem.h"
+
+#ifdef USE_BINK
+#include "video/bink_decoder.h"
+#endif
+
+class BinkBenchmarkSuite : public CxxTest::TestSuite {
+#ifdef USE_BINK
+	static const char *const kFileName;
+
+	static uint32 hashFrame(const Graphics::Surface *surface) {
+		// FNV-1a over the visible pixels, ignoring the padding of the rows
+		uint32 hash = 2166136261u;
+		for (int y = 0; y < surface->h; y++) {
+			const byte *row = (const byte *)surface->getBasePtr(0, y);
+			for (int x = 0; x < surface->w * surface->format.bytesPerPixel; x++)
+				hash = (hash ^ row[x]) * 16777619u;
+		}
+		return hash;
+	}
+
+	/**
+	 * Decode all the frames of the video, and return the time it took in
+	 * milliseconds, or 0 if the video could not be opened.
+	 */
+	static uint32 decodeAll(bool parallel, Common::Array<uint32> &hashes) {
+		Common::FSNode node(kFileName);
+		Common::SeekableReadStream *stream = node.createReadStream();
+		if (!stream)
+			return 0;
+
+		Video::BinkDecoder decoder;
+		decoder.setParallelDecoding(parallel);
+		if (!decoder.loadStream(stream))
+			return 0;
+
+		hashes.clear();
+
+		const uint32 startMillis = g_system->getMillis();
+
+		const uint32 frameCount = decoder.getFrameCount();
+		for (uint32 i = 0; i < frameCount; i++) {
+			const Graphics::Surface *surface = decoder.decodeNextFrame();
+			TS_ASSERT(surface);
+			if (!surface)
+				break;
+
+			hashes.push_back(hashFrame(surface));
+		}
+
+		return MAX<uint32>(g_system->getMillis() - startMillis, 1);
+	}
+#endif
+
+	public:
+	/**
+	 * Decode a video serially and in parallel, check that both give the same
+	 * frames, and report how many frames per second each decodes.
+	 *
+	 * No Bink video is distributed with ScummVM, so this only runs if
+	 * BENCHMARK.BIK is in the working directory.
+	 */
+	void test_decode() {
+#if defined(USE_BINK) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Array<uint32> serialHashes, parallelHashes;
+		const uint32 serialMillis = decodeAll(false, serialHashes);
+		if (!serialMillis) {
+			TS_TRACE(Common::String::format("%s not found, skipping the benchmark", kFileName).c_str());
+			return;
+		}
+
+		const uint32 parallelMillis = decodeAll(true, parallelHashes);
+		TS_ASSERT(parallelHashes == serialHashes);
+
+		const uint32 frames = serialHashes.size();
+		TS_TRACE(Common::String::format("Bink: decoded %u frames serially in %u ms, %u frames per second",
+			frames, serialMillis, (uint32)((uint64)frames * 1000 / serialMillis)).c_str());
+		TS_TRACE(Common::String::format("Bink: decoded %u frames in parallel in %u ms, %u frames per second",
+			frames, parallelMillis, (uint32)((uint64)frames * 1000 / parallelMillis)).c_str());
+#endif
+	}
+};
+
+#ifdef USE_BINK
+const char *const BinkBenchmarkSuite::kFileName = "BENCHMARK.BIK";
+#endif
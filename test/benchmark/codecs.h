@@ -0,0 +1,65 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#include "graphics/pixelformat.h"
+
+#include "image/codecs/msvideo1.h"
+#include "image/codecs/rpza.h"
+
+#include "../image/codec_frames.h"
+#include "../system/null_osystem.h"
+
+/**
+ * Measures how fast the RPZA and MS Video 1 decoders convert generated
+ * frames to 16 and 32 bpp.
+ */
+class CodecBenchmarkSuite : public CxxTest::TestSuite {
+	static const int kWidth = 320;
+	static const int kHeight = 240;
+	static const int kNumFrames = 2000;
+
+public:
+	void test_generated_frames() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::MemoryWriteStreamDynamic rpzaFrame(DisposeAfterUse::YES);
+		Common::MemoryWriteStreamDynamic msvideo1Frame(DisposeAfterUse::YES);
+		CodecFrameGenerator generator(4);
+		generator.createRPZAFrame(rpzaFrame, kWidth, kHeight);
+		generator.createMSVideo1Frame(msvideo1Frame, kWidth, kHeight);
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0)
+		};
+		for (uint i = 0; i < ARRAYSIZE(formats); i++) {
+			Image::RPZADecoder rpza(kWidth, kHeight);
+			Image::MSVideo1Decoder msvideo1(kWidth, kHeight, 16);
+			rpza.setOutputPixelFormat(formats[i]);
+			msvideo1.setOutputPixelFormat(formats[i]);
+
+			uint32 rpzaTime = g_system->getMillis();
+			for (int j = 0; j < kNumFrames; j++) {
+				Common::MemoryReadStream stream(rpzaFrame.getData(), rpzaFrame.size());
+				rpza.decodeFrame(stream);
+			}
+			rpzaTime = g_system->getMillis() - rpzaTime;
+
+			uint32 msvideo1Time = g_system->getMillis();
+			for (int j = 0; j < kNumFrames; j++) {
+				Common::MemoryReadStream stream(msvideo1Frame.getData(), msvideo1Frame.size());
+				msvideo1.decodeFrame(stream);
+			}
+			msvideo1Time = g_system->getMillis() - msvideo1Time;
+
+			TS_TRACE(Common::String::format("Codecs: %d %dx%d frames to %d bpp in %u ms RPZA, %u ms MS Video 1",
+				kNumFrames, kWidth, kHeight, formats[i].bytesPerPixel * 8, rpzaTime, msvideo1Time).c_str());
+		}
+#endif
+	}
+};
@@ -0,0 +1,673 @@
+#include <cxxtest/TestSuite.h>
+
+#include "allocations.h"
+
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/str.h"
+#include "common/system.h"
+#include "common/util.h"
+
+#include "graphics/palette.h"
+#include "graphics/surface.h"
+
+#include "image/bmp.h"
+#include "image/gif.h"
+#include "image/iff.h"
+#include "image/jpeg.h"
+#include "image/pcx.h"
+#include "image/pict.h"
+#include "image/png.h"
+
+#include "../system/null_osystem.h"
+
+#ifdef USE_JPEG
+// The original release of libjpeg v6b did not contain any extern "C" in case
+// its header files are included in a C++ environment.
+extern "C" {
+#include <jpeglib.h>
+}
+#endif
+
+/**
+ * Measures how fast the image decoders are, to catch regressions.
+ *
+ * Each decoder loads images generated in memory, which mix gradients, noise
+ * and flat areas, for at least kMinDecodeMicros. The images are also checked
+ * to decode to the pixels they were generated from, except for JPEG.
+ *
+ * Any PNG, JPEG, GIF, BMP, PICT, IFF or PCX file in an image-benchmark
+ * directory in the working directory is measured as well.
+ *
+ * The results are reported as traces, giving for each image the megabytes
+ * of pixels decoded per second and the heap allocations made per decode.
+ */
+class ImageBenchmarkSuite : public CxxTest::TestSuite {
+	static const int kWidth = 640;
+	static const int kHeight = 480;
+	static const uint32 kMinDecodeMicros = 500000;
+	static const int kMinDecodes = 5;
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) | (_seed << 16);
+	}
+
+	/**
+	 * Return the color index of a pixel of the generated images. The top
+	 * half is a gradient, the bottom left quarter is noise and the bottom
+	 * right quarter is made of flat blocks.
+	 */
+	byte generatePixel(int x, int y, const byte *blockColors) {
+		if (y < kHeight / 2)
+			return (x / 3 + y / 2) & 0xFF;
+		if (x < kWidth / 2)
+			return nextRandom() & 0xFF;
+		return blockColors[((y / 32) * (kWidth / 32) + x / 32) & 0xFF];
+	}
+
+	void createImages(Graphics::Surface &paletted, Graphics::Surface &rgb, Graphics::Palette &palette) {
+		palette.resize(256, false);
+		for (uint i = 0; i < 256; i++)
+			palette.set(i, i, (i * 3) & 0xFF, 255 - i);
+
+		byte blockColors[256];
+		for (uint i = 0; i < 256; i++)
+			blockColors[i] = nextRandom() & 0xFF;
+
+		paletted.create(kWidth, kHeight, Graphics::PixelFormat::createFormatCLUT8());
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++)
+				paletted.setPixel(x, y, generatePixel(x, y, blockColors));
+		}
+
+		// The RGB image varies its channels separately, unlike the palette
+		rgb.create(kWidth, kHeight, Graphics::PixelFormat::createFormatRGB24());
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				const byte index = paletted.getPixel(x, y);
+				rgb.setPixel(x, y, rgb.format.RGBToColor(index, (index + y) & 0xFF, (x * 2) & 0xFF));
+			}
+		}
+	}
+
+	static void getRGB(const Graphics::Surface &surface, const Graphics::Palette &palette, int x, int y, byte &r, byte &g, byte &b) {
+		const uint32 color = surface.getPixel(x, y);
+		if (surface.format.isCLUT8())
+			palette.get(color, r, g, b);
+		else
+			surface.format.colorToRGB(color, r, g, b);
+	}
+
+	/** Return whether a decoded image has the pixels of the one generated. */
+	static bool isSameImage(const Graphics::Surface &expected, const Graphics::Palette &expectedPalette,
+			const Image::ImageDecoder &decoder) {
+		const Graphics::Surface *surface = decoder.getSurface();
+		if (!surface || surface->w != expected.w || surface->h != expected.h)
+			return false;
+
+		for (int y = 0; y < surface->h; y++) {
+			for (int x = 0; x < surface->w; x++) {
+				byte r1, g1, b1, r2, g2, b2;
+				getRGB(expected, expectedPalette, x, y, r1, g1, b1);
+				getRGB(*surface, decoder.getPalette(), x, y, r2, g2, b2);
+				if (r1 != r2 || g1 != g2 || b1 != b2)
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	static void writePalette(Common::WriteStream &out, const Graphics::Palette &palette) {
+		for (uint i = 0; i < palette.size(); i++) {
+			byte r, g, b;
+			palette.get(i, r, g, b);
+			out.writeByte(r);
+			out.writeByte(g);
+			out.writeByte(b);
+		}
+	}
+
+	/** Compress data with PackBits, as used by IFF and PICT. */
+	static void writePackBits(Common::WriteStream &out, const byte *data, uint size) {
+		uint i = 0;
+		while (i < size) {
+			uint run = 1;
+			while (i + run < size && run < 128 && data[i + run] == data[i])
+				run++;
+
+			if (run >= 3) {
+				out.writeByte(257 - run);
+				out.writeByte(data[i]);
+				i += run;
+				continue;
+			}
+
+			// Copy the bytes up to the next run of three
+			const uint start = i;
+			while (i < size && i - start < 128) {
+				if (i + 2 < size && data[i] == data[i + 1] && data[i] == data[i + 2])
+					break;
+				i++;
+			}
+
+			out.writeByte(i - start - 1);
+			out.write(data + start, i - start);
+		}
+	}
+
+	static void writeBMP8(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		Image::writePalettedBMP(out, surface, palette.data());
+	}
+
+	static void writeBMP24(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		Image::writeBMP(out, surface);
+	}
+
+#ifdef USE_PNG
+	static void writePNG24(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		Image::writePNG(out, surface);
+	}
+#endif
+
+#ifdef USE_JPEG
+	struct JPEGDestination {
+		jpeg_destination_mgr pub;
+		Common::WriteStream *stream;
+		JOCTET buffer[4096];
+	};
+
+	static void initDestination(j_compress_ptr cinfo) {
+		JPEGDestination *dest = (JPEGDestination *)cinfo->dest;
+		dest->pub.next_output_byte = dest->buffer;
+		dest->pub.free_in_buffer = sizeof(dest->buffer);
+	}
+
+	static boolean emptyOutputBuffer(j_compress_ptr cinfo) {
+		JPEGDestination *dest = (JPEGDestination *)cinfo->dest;
+		dest->stream->write(dest->buffer, sizeof(dest->buffer));
+		initDestination(cinfo);
+		return TRUE;
+	}
+
+	static void termDestination(j_compress_ptr cinfo) {
+		JPEGDestination *dest = (JPEGDestination *)cinfo->dest;
+		dest->stream->write(dest->buffer, sizeof(dest->buffer) - dest->pub.free_in_buffer);
+	}
+
+	static void writeJPEG(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		jpeg_compress_struct cinfo;
+		jpeg_error_mgr jerr;
+		cinfo.err = jpeg_std_error(&jerr);
+		jpeg_create_compress(&cinfo);
+
+		JPEGDestination dest;
+		dest.pub.init_destination = initDestination;
+		dest.pub.empty_output_buffer = emptyOutputBuffer;
+		dest.pub.term_destination = termDestination;
+		dest.stream = &out;
+		cinfo.dest = &dest.pub;
+
+		cinfo.image_width = surface.w;
+		cinfo.image_height = surface.h;
+		cinfo.input_components = 3;
+		cinfo.in_color_space = JCS_RGB;
+		jpeg_set_defaults(&cinfo);
+		jpeg_set_quality(&cinfo, 85, TRUE);
+		jpeg_start_compress(&cinfo, TRUE);
+
+		Common::Array<JSAMPLE> row(surface.w * 3);
+		while (cinfo.next_scanline < cinfo.image_height) {
+			for (int x = 0; x < surface.w; x++)
+				surface.format.colorToRGB(surface.getPixel(x, cinfo.next_scanline), row[x * 3], row[x * 3 + 1], row[x * 3 + 2]);
+
+			JSAMPROW rowPtr = row.data();
+			jpeg_write_scanlines(&cinfo, &rowPtr, 1);
+		}
+
+		jpeg_finish_compress(&cinfo);
+		jpeg_destroy_compress(&cinfo);
+	}
+#endif
+
+#ifdef USE_GIF
+	/**
+	 * Write a GIF without compression, by clearing the LZW dictionary
+	 * before the codes get wider than 9 bits.
+	 */
+	static void writeGIF(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		out.write("GIF89a", 6);
+		out.writeUint16LE(surface.w);
+		out.writeUint16LE(surface.h);
+		out.writeByte(0xF7); // 256 colors global palette
+		out.writeByte(0);    // Background color
+		out.writeByte(0);    // Aspect ratio
+		writePalette(out, palette);
+
+		out.writeByte(0x2C); // Image descriptor
+		out.writeUint16LE(0);
+		out.writeUint16LE(0);
+		out.writeUint16LE(surface.w);
+		out.writeUint16LE(surface.h);
+		out.writeByte(0);
+		out.writeByte(8);    // LZW minimum code size
+
+		Common::Array<byte> data;
+		uint32 bits = 0;
+		int bitCount = 0;
+
+		auto writeCode = [&](uint16 code) {
+			bits |= code << bitCount;
+			bitCount += 9;
+			while (bitCount >= 8) {
+				data.push_back(bits & 0xFF);
+				bits >>= 8;
+				bitCount -= 8;
+			}
+		};
+
+		// Each code after the first one following a clear code adds an
+		// entry to the dictionary, which starts at 258
+		writeCode(0x100);
+		int codes = 0;
+		for (int y = 0; y < surface.h; y++) {
+			const byte *line = (const byte *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; x++) {
+				writeCode(line[x]);
+				if (++codes == 250) {
+					writeCode(0x100);
+					codes = 0;
+				}
+			}
+		}
+		writeCode(0x101);
+
+		if (bitCount > 0)
+			data.push_back(bits & 0xFF);
+
+		for (uint i = 0; i < data.size(); i += 255) {
+			const uint size = MIN<uint>(data.size() - i, 255);
+			out.writeByte(size);
+			out.write(&data[i], size);
+		}
+
+		out.writeByte(0);    // Block terminator
+		out.writeByte(0x3B); // Trailer
+	}
+#endif
+
+	static void writePCX(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		out.writeByte(0x0A); // ZSoft PCX
+		out.writeByte(5);    // Version
+		out.writeByte(1);    // RLE
+		out.writeByte(8);    // Bits per pixel
+		out.writeUint16LE(0);
+		out.writeUint16LE(0);
+		out.writeUint16LE(surface.w - 1);
+		out.writeUint16LE(surface.h - 1);
+		out.writeUint16LE(72);
+		out.writeUint16LE(72);
+		for (int i = 0; i < 48; i++)
+			out.writeByte(0);    // EGA palette
+		out.writeByte(0);
+		out.writeByte(1);    // Planes
+		out.writeUint16LE(surface.w);
+		for (int i = 0; i < 60; i++)
+			out.writeByte(0);
+
+		for (int y = 0; y < surface.h; y++) {
+			const byte *line = (const byte *)surface.getBasePtr(0, y);
+			int x = 0;
+			while (x < surface.w) {
+				int run = 1;
+				while (x + run < surface.w && run < 63 && line[x + run] == line[x])
+					run++;
+
+				if (run > 1 || line[x] >= 0xC0)
+					out.writeByte(0xC0 | run);
+				out.writeByte(line[x]);
+				x += run;
+			}
+		}
+
+		out.writeByte(12);
+		writePalette(out, palette);
+	}
+
+	/** Write an ILBM with 8 bitplanes compressed with PackBits. */
+	static void writeIFF(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		Common::MemoryWriteStreamDynamic body(DisposeAfterUse::YES);
+		const int planePitch = ((surface.w + 15) >> 4) << 1;
+		Common::Array<byte> plane(planePitch);
+
+		for (int y = 0; y < surface.h; y++) {
+			const byte *line = (const byte *)surface.getBasePtr(0, y);
+			for (int p = 0; p < 8; p++) {
+				memset(plane.data(), 0, planePitch);
+				for (int x = 0; x < surface.w; x++) {
+					if (line[x] & (1 << p))
+						plane[x >> 3] |= 0x80 >> (x & 7);
+				}
+				writePackBits(body, plane.data(), planePitch);
+			}
+		}
+
+		if (body.size() & 1)
+			body.writeByte(0);
+
+		out.writeUint32BE(MKTAG('F', 'O', 'R', 'M'));
+		out.writeUint32BE(4 + 8 + 20 + 8 + 768 + 8 + body.size());
+		out.writeUint32BE(MKTAG('I', 'L', 'B', 'M'));
+
+		out.writeUint32BE(MKTAG('B', 'M', 'H', 'D'));
+		out.writeUint32BE(20);
+		out.writeUint16BE(surface.w);
+		out.writeUint16BE(surface.h);
+		out.writeUint16BE(0);
+		out.writeUint16BE(0);
+		out.writeByte(8);    // Planes
+		out.writeByte(0);    // Masking
+		out.writeByte(1);    // Compression
+		out.writeByte(0);
+		out.writeUint16BE(0);
+		out.writeByte(1);
+		out.writeByte(1);
+		out.writeUint16BE(surface.w);
+		out.writeUint16BE(surface.h);
+
+		out.writeUint32BE(MKTAG('C', 'M', 'A', 'P'));
+		out.writeUint32BE(768);
+		writePalette(out, palette);
+
+		out.writeUint32BE(MKTAG('B', 'O', 'D', 'Y'));
+		out.writeUint32BE(body.size());
+		out.write(body.getData(), body.size());
+	}
+
+	static void writePICTRect(Common::WriteStream &out, int width, int height) {
+		out.writeUint16BE(0);
+		out.writeUint16BE(0);
+		out.writeUint16BE(height);
+		out.writeUint16BE(width);
+	}
+
+	static void writePICTHeader(Common::WriteStream &out, int width, int height) {
+		out.writeUint16BE(1);        // Size, unused, but non-zero for no 512 byte header
+		writePICTRect(out, width, height);
+		out.writeUint16BE(0x0011);   // VersionOp
+		out.writeUint16BE(0x02FF);
+		out.writeUint16BE(0x0C00);   // HeaderOp
+		out.writeUint16BE(0xFFFE);
+		out.writeUint16BE(0);
+		out.writeUint32BE(0x00480000);
+		out.writeUint32BE(0x00480000);
+		writePICTRect(out, width, height);
+		out.writeUint32BE(0);
+	}
+
+	static void writePICTPixMap(Common::WriteStream &out, int width, int height, uint16 packType, uint16 pixelType,
+			uint16 pixelSize, uint16 cmpCount, uint16 cmpSize) {
+		writePICTRect(out, width, height);
+		out.writeUint16BE(0);        // Version
+		out.writeUint16BE(packType);
+		out.writeUint32BE(0);        // Pack size
+		out.writeUint32BE(0x00480000);
+		out.writeUint32BE(0x00480000);
+		out.writeUint16BE(pixelType);
+		out.writeUint16BE(pixelSize);
+		out.writeUint16BE(cmpCount);
+		out.writeUint16BE(cmpSize);
+		out.writeUint32BE(0);        // Plane bytes
+		out.writeUint32BE(0);        // Color table
+		out.writeUint32BE(0);        // Reserved
+	}
+
+	static void writePICTRows(Common::WriteStream &out, const Common::Array<byte> &rows, int rowSize, int height) {
+		uint32 size = 0;
+		for (int y = 0; y < height; y++) {
+			Common::MemoryWriteStreamDynamic packed(DisposeAfterUse::YES);
+			writePackBits(packed, &rows[y * rowSize], rowSize);
+			out.writeUint16BE(packed.size());
+			out.write(packed.getData(), packed.size());
+			size += 2 + packed.size();
+		}
+
+		// The opcodes are word-aligned
+		if (size & 1)
+			out.writeByte(0);
+
+		out.writeUint16BE(0x00FF);   // OpEndPic
+	}
+
+	static void writePICT8(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		writePICTHeader(out, surface.w, surface.h);
+
+		out.writeUint16BE(0x0098);   // PackBitsRect
+		out.writeUint16BE(0x8000 | surface.w);
+		writePICTPixMap(out, surface.w, surface.h, 0, 0, 8, 1, 8);
+		out.writeUint32BE(0);        // Seed
+		out.writeUint16BE(0);        // Flags
+		out.writeUint16BE(palette.size() - 1);
+		for (uint i = 0; i < palette.size(); i++) {
+			byte r, g, b;
+			palette.get(i, r, g, b);
+			out.writeUint16BE(i);
+			out.writeUint16BE(r * 0x101);
+			out.writeUint16BE(g * 0x101);
+			out.writeUint16BE(b * 0x101);
+		}
+		writePICTRect(out, surface.w, surface.h);
+		writePICTRect(out, surface.w, surface.h);
+		out.writeUint16BE(0);        // Mode
+
+		Common::Array<byte> rows(surface.w * surface.h);
+		for (int y = 0; y < surface.h; y++)
+			memcpy(&rows[y * surface.w], surface.getBasePtr(0, y), surface.w);
+		writePICTRows(out, rows, surface.w, surface.h);
+	}
+
+	/** Write a 32-bit PICT with the color components packed in planes. */
+	static void writePICT24(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette) {
+		writePICTHeader(out, surface.w, surface.h);
+
+		out.writeUint16BE(0x009A);   // DirectBitsRect
+		out.writeUint32BE(0xFF);     // Base address
+		out.writeUint16BE(0x8000 | (surface.w * 4));
+		writePICTPixMap(out, surface.w, surface.h, 4, 16, 32, 3, 8);
+		writePICTRect(out, surface.w, surface.h);
+		writePICTRect(out, surface.w, surface.h);
+		out.writeUint16BE(0);        // Mode
+
+		const int rowSize = surface.w * 3;
+		Common::Array<byte> rows(rowSize * surface.h);
+		for (int y = 0; y < surface.h; y++) {
+			byte *row = &rows[y * rowSize];
+			for (int x = 0; x < surface.w; x++)
+				surface.format.colorToRGB(surface.getPixel(x, y), row[x], row[x + surface.w], row[x + surface.w * 2]);
+		}
+		writePICTRows(out, rows, rowSize, surface.h);
+	}
+
+	struct Result {
+		uint32 decodes;
+		uint64 micros;
+		size_t allocations;
+		uint32 pixelBytes;
+	};
+
+	/**
+	 * Decode an image again and again for at least kMinDecodeMicros.
+	 *
+	 * @return Whether the image could be decoded.
+	 */
+	static bool measure(Image::ImageDecoder &decoder, const byte *data, uint32 size, Result &result) {
+		result.decodes = 0;
+		result.allocations = 0;
+		result.pixelBytes = 0;
+
+		const uint64 startMicros = g_system->getMicros();
+		do {
+			Common::MemoryReadStream stream(data, size);
+			const size_t allocations = Benchmark::allocationCount;
+			if (!decoder.loadStream(stream))
+				return false;
+			result.allocations += Benchmark::allocationCount - allocations;
+			result.decodes++;
+			result.micros = g_system->getMicros() - startMicros;
+		} while (result.micros < kMinDecodeMicros || result.decodes < kMinDecodes);
+
+		const Graphics::Surface *surface = decoder.getSurface();
+		if (!surface)
+			return false;
+
+		result.pixelBytes = surface->w * surface->h * surface->format.bytesPerPixel;
+		return true;
+	}
+
+	static void report(const Common::String &name, uint32 size, const Result &result) {
+		const double megabytes = (double)result.pixelBytes * result.decodes / (1024 * 1024);
+		const double seconds = MAX<uint64>(result.micros, 1) / 1000000.0;
+
+		Common::String allocations = "not counted";
+		if (BENCHMARK_COUNTS_ALLOCATIONS)
+			allocations = Common::String::format("%.1f", (double)result.allocations / result.decodes);
+
+		TS_TRACE(Common::String::format("%s: %u bytes, %u decodes, %.1f MB/s, allocations per decode: %s",
+			name.c_str(), size, result.decodes, megabytes / seconds, allocations.c_str()).c_str());
+	}
+
+	typedef void (*WriteFunc)(Common::WriteStream &out, const Graphics::Surface &surface, const Graphics::Palette &palette);
+
+	/** Generate an image with @p write, check that it decodes right, and measure it. */
+	static void benchmark(const char *name, Image::ImageDecoder &decoder, WriteFunc write,
+			const Graphics::Surface &surface, const Graphics::Palette &palette, bool exact = true) {
+		Common::MemoryWriteStreamDynamic image(DisposeAfterUse::YES);
+		write(image, surface, palette);
+
+		Result result;
+		const bool decoded = measure(decoder, image.getData(), image.size(), result);
+		TS_ASSERT(decoded);
+		if (!decoded)
+			return;
+
+		if (exact)
+			TS_ASSERT(isSameImage(surface, palette, decoder));
+
+		report(name, image.size(), result);
+	}
+
+	/** Return a decoder for a file, from its extension. */
+	static Image::ImageDecoder *createDecoder(const Common::String &name) {
+		if (name.hasSuffixIgnoreCase(".bmp"))
+			return new Image::BitmapDecoder();
+		if (name.hasSuffixIgnoreCase(".pcx"))
+			return new Image::PCXDecoder();
+		if (name.hasSuffixIgnoreCase(".iff") || name.hasSuffixIgnoreCase(".lbm") || name.hasSuffixIgnoreCase(".ilbm"))
+			return new Image::IFFDecoder();
+		if (name.hasSuffixIgnoreCase(".pict") || name.hasSuffixIgnoreCase(".pct"))
+			return new Image::PICTDecoder();
+#ifdef USE_PNG
+		if (name.hasSuffixIgnoreCase(".png"))
+			return new Image::PNGDecoder();
+#endif
+#ifdef USE_JPEG
+		if (name.hasSuffixIgnoreCase(".jpg") || name.hasSuffixIgnoreCase(".jpeg"))
+			return new Image::JPEGDecoder();
+#endif
+#ifdef USE_GIF
+		if (name.hasSuffixIgnoreCase(".gif"))
+			return new Image::GIFDecoder();
+#endif
+		return nullptr;
+	}
+
+public:
+	void test_generated_images() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		_seed = 1;
+		Graphics::Surface paletted, rgb;
+		Graphics::Palette palette(0);
+		createImages(paletted, rgb, palette);
+
+		{
+			Image::BitmapDecoder decoder;
+			benchmark("BMP 8-bit", decoder, writeBMP8, paletted, palette);
+			benchmark("BMP 24-bit", decoder, writeBMP24, rgb, palette);
+		}
+#ifdef USE_PNG
+		{
+			Image::PNGDecoder decoder;
+			benchmark("PNG 24-bit", decoder, writePNG24, rgb, palette);
+		}
+#endif
+#ifdef USE_JPEG
+		{
+			Image::JPEGDecoder decoder;
+			benchmark("JPEG", decoder, writeJPEG, rgb, palette, false);
+		}
+#endif
+#ifdef USE_GIF
+		{
+			Image::GIFDecoder decoder;
+			benchmark("GIF", decoder, writeGIF, paletted, palette);
+		}
+#endif
+		{
+			Image::PCXDecoder decoder;
+			benchmark("PCX 8-bit", decoder, writePCX, paletted, palette);
+		}
+		{
+			Image::IFFDecoder decoder;
+			benchmark("IFF ILBM", decoder, writeIFF, paletted, palette);
+		}
+		{
+			Image::PICTDecoder decoder;
+			benchmark("PICT 8-bit", decoder, writePICT8, paletted, palette);
+			benchmark("PICT 24-bit", decoder, writePICT24, rgb, palette);
+		}
+
+		paletted.free();
+		rgb.free();
+#endif
+	}
+
+	void test_image_files() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::FSNode dir("image-benchmark");
+		Common::FSList files;
+		if (!dir.isDirectory() || !dir.getChildren(files, Common::FSNode::kListFilesOnly)) {
+			TS_TRACE("No image-benchmark directory, skipping the image files");
+			return;
+		}
+
+		Common::sort(files.begin(), files.end());
+		for (const auto &file : files) {
+			Common::ScopedPtr<Image::ImageDecoder> decoder(createDecoder(file.getName()));
+			if (!decoder)
+				continue;
+
+			Common::ScopedPtr<Common::SeekableReadStream> stream(file.createReadStream());
+			if (!stream)
+				continue;
+
+			Common::Array<byte> data(stream->size());
+			stream->read(data.data(), data.size());
+
+			Result result;
+			const bool decoded = measure(*decoder, data.data(), data.size(), result);
+			TS_ASSERT(decoded);
+			if (decoded)
+				report(file.getName(), data.size(), result);
+		}
+#endif
+	}
+};
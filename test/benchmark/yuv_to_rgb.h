@@ -0,0 +1,78 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/str.h"
+#include "common/system.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "../system/null_osystem.h"
+
+/**
+ * Measures how fast 640x480 YUV420 frames are converted, by the tables and
+ * by each of the SIMD converters the CPU supports.
+ */
+class YUVToRGBBenchmarkSuite : public CxxTest::TestSuite {
+	static const int kNumFrames = 2000;
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+
+	/** Return the time to convert kNumFrames frames, in milliseconds. */
+	static uint32 timeConvert(Graphics::YUVToRGBRowConverter::ConvertFunc func) {
+		byte *y = new byte[640 * 480];
+		byte *u = new byte[320 * 240];
+		byte *v = new byte[320 * 240];
+		uint32 seed = 0x5eed;
+		for (int i = 0; i < 640 * 480; i++)
+			y[i] = nextRandom(seed);
+		for (int i = 0; i < 320 * 240; i++) {
+			u[i] = nextRandom(seed);
+			v[i] = nextRandom(seed);
+		}
+
+		Graphics::Surface dst;
+		dst.create(640, 480, Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+
+		Graphics::YUVToRGBRowConverter::convertFunc = func;
+		const uint32 start = g_system->getMillis();
+		for (int i = 0; i < kNumFrames; i++)
+			YUVToRGBMan.convert420(&dst, Graphics::YUVToRGBManager::kScaleITU, y, u, v, 640, 480, 640, 320);
+		const uint32 time = g_system->getMillis() - start;
+		Graphics::YUVToRGBRowConverter::convertFunc = nullptr;
+
+		dst.free();
+		delete[] y;
+		delete[] u;
+		delete[] v;
+		return time;
+	}
+
+	static void traceConvert(const char *name, Graphics::YUVToRGBRowConverter::ConvertFunc func) {
+		TS_TRACE(Common::String::format("YUV to RGB: %d 640x480 YUV420 frames in %u ms with %s",
+			kNumFrames, timeConvert(func), name).c_str());
+	}
+
+public:
+	void test_convert420() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		traceConvert("tables", Graphics::YUVToRGBRowConverter::convertNone);
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			traceConvert("SSE2", Graphics::YUVToRGBRowConverter::convertSSE2);
+#endif
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			traceConvert("AVX2", Graphics::YUVToRGBRowConverter::convertAVX2);
+#endif
+#ifdef SCUMMVM_NEON
+		traceConvert("NEON", Graphics::YUVToRGBRowConverter::convertNEON);
+#endif
+#endif
+	}
+};
@@ -0,0 +1,174 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/compression/deflate.h"
+#include "common/compression/unzip.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/ptr.h"
+
+/**
+ * A test suite for the ZIP archive reader in common/compression/unzip.cpp.
+ * The archive is generated at runtime, with members small enough to be
+ * decompressed at once and members large enough to be streamed.
+ */
+class UnzipTestSuite : public CxxTest::TestSuite {
+#ifdef USE_ZLIB
+	struct Member {
+		const char *name;
+		uint32 size;
+		bool deflate;
+	};
+
+	static const Member *getMembers() {
+		static const Member members[] = {
+			{ "small.txt", 100, false },
+			{ "dir/", 0, false },
+			{ "dir/packed.bin", 65536, true },
+			{ "dir/large.bin", 2 * 1024 * 1024, true },
+			{ "stored.bin", 1024 * 1024, false },
+			{ nullptr, 0, false }
+		};
+		return members;
+	}
+
+	static byte getByte(const Member &member, uint32 pos) {
+		return (byte)((pos * 7) ^ (pos >> 9) ^ member.size);
+	}
+
+	static void writeEntry(Common::MemoryWriteStreamDynamic &out, bool central, const Member &member,
+	                       uint32 crc, uint32 compressedSize, uint32 offset) {
+		const uint16 nameLength = strlen(member.name);
+		const bool isDirectory = member.name[nameLength - 1] == '/';
+
+		out.writeUint32LE(central ? 0x02014b50 : 0x04034b50);
+		if (central)
+			out.writeUint16LE(0x0314); // made by Unix
+		out.writeUint16LE(20);
+		out.writeUint16LE(0);
+		out.writeUint16LE(member.deflate ? 8 : 0);
+		out.writeUint32LE(0);
+		out.writeUint32LE(crc);
+		out.writeUint32LE(compressedSize);
+		out.writeUint32LE(member.size);
+		out.writeUint16LE(nameLength);
+		out.writeUint16LE(0);
+		if (central) {
+			out.writeUint16LE(0);
+			out.writeUint16LE(0);
+			out.writeUint16LE(0);
+			out.writeUint32LE(isDirectory ? 0x41ed0010 : 0x81a40000);
+			out.writeUint32LE(offset);
+		}
+		out.write(member.name, nameLength);
+	}
+
+	static Common::SeekableReadStream *makeZip() {
+		Common::MemoryWriteStreamDynamic zip(DisposeAfterUse::NO);
+		Common::MemoryWriteStreamDynamic centralDir(DisposeAfterUse::YES);
+		int numMembers = 0;
+
+		for (const Member *member = getMembers(); member->name; member++, numMembers++) {
+			byte *data = new byte[MAX<uint32>(member->size, 1)];
+			for (uint32 i = 0; i < member->size; i++)
+				data[i] = getByte(*member, i);
+
+			// Deflate as gzip, and strip its header and trailer
+			Common::MemoryWriteStreamDynamic *gzipOut = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+			Common::ScopedPtr<Common::WriteStream> compressor(Common::wrapCompressedWriteStream(gzipOut));
+			compressor->write(data, member->size);
+			compressor->finalize();
+
+			const byte *gzipData = gzipOut->getData();
+			const uint32 gzipSize = gzipOut->size();
+			const uint32 crc = READ_LE_UINT32(gzipData + gzipSize - 8);
+
+			const byte *contents = member->deflate ? gzipData + 10 : data;
+			const uint32 contentsSize = member->deflate ? gzipSize - 18 : member->size;
+
+			writeEntry(centralDir, true, *member, crc, contentsSize, zip.pos());
+			writeEntry(zip, false, *member, crc, contentsSize, 0);
+			zip.write(contents, contentsSize);
+
+			delete[] data;
+		}
+
+		const uint32 centralDirOffset = zip.pos();
+		zip.write(centralDir.getData(), centralDir.size());
+
+		zip.writeUint32LE(0x06054b50);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(numMembers);
+		zip.writeUint16LE(numMembers);
+		zip.writeUint32LE(centralDir.size());
+		zip.writeUint32LE(centralDirOffset);
+		zip.writeUint16LE(0);
+
+		return new Common::MemoryReadStream(zip.getData(), zip.size(), DisposeAfterUse::YES);
+	}
+
+	static bool checkContents(Common::SeekableReadStream *stream, const Member &member, uint32 pos, uint32 size) {
+		byte *buffer = new byte[size];
+		bool result = stream->seek(pos) && stream->read(buffer, size) == size;
+		for (uint32 i = 0; i < size && result; i++)
+			result = buffer[i] == getByte(member, pos + i);
+		delete[] buffer;
+		return result;
+	}
+#endif
+
+	public:
+	void test_members() {
+#ifdef USE_ZLIB
+		Common::ScopedPtr<Common::Archive> archive(Common::makeZipArchive(makeZip()));
+		TS_ASSERT(archive);
+
+		Common::ArchiveMemberList list;
+		TS_ASSERT_EQUALS(archive->listMembers(list), 5);
+		TS_ASSERT(archive->isPathDirectory("dir"));
+		TS_ASSERT(!archive->hasFile("missing.txt"));
+
+		for (const Member *member = getMembers(); member->name; member++) {
+			if (member->size == 0)
+				continue;
+
+			TS_ASSERT(archive->hasFile(member->name));
+			TS_ASSERT(!archive->isPathDirectory(member->name));
+
+			Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember(member->name));
+			TS_ASSERT(stream);
+			TS_ASSERT_EQUALS(stream->size(), member->size);
+			TS_ASSERT(checkContents(stream.get(), *member, 0, member->size));
+		}
+#endif
+	}
+
+	void test_streamed_members() {
+#ifdef USE_ZLIB
+		Common::ScopedPtr<Common::Archive> archive(Common::makeZipArchive(makeZip()));
+		const Member &large = getMembers()[3];
+
+		Common::ScopedPtr<Common::SeekableReadStream> stream(archive->createReadStreamForMember(large.name));
+		TS_ASSERT(stream);
+
+		// Seek forward, then back again, which inflates the whole member
+		TS_ASSERT(checkContents(stream.get(), large, 1500000, 1000));
+		TS_ASSERT(checkContents(stream.get(), large, 1000, 1000));
+		TS_ASSERT_EQUALS(stream->pos(), 2000);
+		TS_ASSERT(checkContents(stream.get(), large, large.size - 10, 10));
+		TS_ASSERT(stream->seek(-20, SEEK_CUR));
+		TS_ASSERT(checkContents(stream.get(), large, large.size - 20, 20));
+		TS_ASSERT(!stream->eos());
+		byte b;
+		TS_ASSERT_EQUALS(stream->read(&b, 1), 0u);
+		TS_ASSERT(stream->eos());
+
+		// Streamed members stay readable after the archive is closed
+		Common::ScopedPtr<Common::SeekableReadStream> stored(archive->createReadStreamForMember(getMembers()[4].name));
+		archive.reset();
+		TS_ASSERT(checkContents(stream.get(), large, 0, large.size));
+		TS_ASSERT(checkContents(stored.get(), getMembers()[4], 0, getMembers()[4].size));
+#endif
+	}
+};
@@ -0,0 +1,189 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/atomic.h"
+#include "common/memstream.h"
+#include "common/prefetch.h"
+#include "common/taskpool.h"
+
+#include "../system/null_osystem.h"
+
+// Members are opened on worker threads
+static Common::Atomic<int> numOpened(0);
+
+class PrefetchTestMember : public Common::ArchiveMember {
+public:
+	PrefetchTestMember(const Common::Path &path, const char *contents, bool background) :
+		_path(path), _contents(contents), _background(background) {}
+
+	Common::SeekableReadStream *createReadStream() const override {
+		numOpened.fetchAdd(1);
+		return new Common::MemoryReadStream((const byte *)_contents, strlen(_contents));
+	}
+	Common::SeekableReadStream *createReadStreamForAltStream(Common::AltStreamType altStreamType) const override { return nullptr; }
+	Common::String getName() const override { return _path.toString(); }
+	Common::Path getPathInArchive() const override { return _path; }
+	Common::String getFileName() const override { return _path.getLastComponent().toString(); }
+	bool supportsBackgroundRead() const override { return _background; }
+
+private:
+	Common::Path _path;
+	const char *_contents;
+	bool _background;
+};
+
+/**
+ * An archive holding "a.txt", which can be read in the background, and
+ * "b.txt", which cannot.
+ */
+class PrefetchTestArchive : public Common::Archive {
+public:
+	bool hasFile(const Common::Path &path) const override {
+		return path.equalsIgnoreCase("a.txt") || path.equalsIgnoreCase("b.txt");
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		list.push_back(getMember("a.txt"));
+		list.push_back(getMember("b.txt"));
+		return 2;
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		if (path.equalsIgnoreCase("a.txt"))
+			return Common::ArchiveMemberPtr(new PrefetchTestMember(path, "first member", true));
+		if (path.equalsIgnoreCase("b.txt"))
+			return Common::ArchiveMemberPtr(new PrefetchTestMember(path, "second", false));
+		return Common::ArchiveMemberPtr();
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		Common::ArchiveMemberPtr member = getMember(path);
+		return member ? member->createReadStream() : nullptr;
+	}
+};
+
+class PrefetchTestSuite : public CxxTest::TestSuite
+{
+	static Common::String readAll(Common::SeekableReadStream *stream) {
+		Common::String result;
+		if (stream)
+			result = stream->readString(0, stream->size());
+		delete stream;
+		return result;
+	}
+
+	static Common::Array<Common::Path> makePaths() {
+		Common::Array<Common::Path> paths;
+		paths.push_back("a.txt");
+		paths.push_back("b.txt");
+		paths.push_back("missing.txt");
+		return paths;
+	}
+
+	public:
+	void setUp() {
+		numOpened.store(0);
+	}
+
+	void tearDown() {
+		if (Common::PrefetchManager::hasInstance())
+			PrefetchMan.clear();
+	}
+
+	void test_take() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		PrefetchTestArchive archive;
+		Common::PrefetchRequestPtr request = archive.prefetch(makePaths());
+		TS_ASSERT_EQUALS(request->getNumMembers(), 2u);
+
+		// Nothing is opened on the calling thread. Without worker threads,
+		// the members are only loaded when they are taken.
+		if (TaskPoolMan.getNumWorkers() == 0)
+			TS_ASSERT_EQUALS(numOpened.load(), 0);
+		TS_ASSERT(!request->isDone());
+
+		TS_ASSERT_EQUALS(readAll(request->takeStream("A.TXT")), "first member");
+		TS_ASSERT_EQUALS(readAll(request->takeStream("b.txt")), "second");
+		TS_ASSERT_EQUALS(numOpened.load(), 2);
+		TS_ASSERT(request->isDone());
+
+		TS_ASSERT(!request->takeStream("a.txt"));
+		TS_ASSERT(!request->takeStream("missing.txt"));
+#endif
+	}
+
+	void test_wait() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		PrefetchTestArchive archive;
+		Common::PrefetchRequestPtr request = archive.prefetch(makePaths());
+		if (TaskPoolMan.getNumWorkers() == 0)
+			TS_ASSERT(!request->isReady("a.txt"));
+
+		request->wait();
+		TS_ASSERT(request->isDone());
+		TS_ASSERT(request->isReady("a.txt"));
+		TS_ASSERT(request->isReady("b.txt"));
+		TS_ASSERT_EQUALS(numOpened.load(), 2);
+
+		// Loaded members are not opened again
+		TS_ASSERT_EQUALS(readAll(request->takeStream("b.txt")), "second");
+		TS_ASSERT_EQUALS(numOpened.load(), 2);
+		TS_ASSERT(!request->isReady("b.txt"));
+
+		request->cancel();
+		TS_ASSERT(!request->isReady("a.txt"));
+		TS_ASSERT(!request->takeStream("a.txt"));
+#endif
+	}
+
+	void test_search_set() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::SearchSet searchSet;
+		searchSet.add("test", new PrefetchTestArchive());
+
+		// The request does not need to be kept
+		searchSet.prefetch(makePaths())->wait();
+		TS_ASSERT_EQUALS(PrefetchMan.getNumRequests(), 1u);
+		TS_ASSERT_EQUALS(numOpened.load(), 2);
+
+		TS_ASSERT_EQUALS(readAll(searchSet.createReadStreamForMember("a.txt")), "first member");
+		TS_ASSERT_EQUALS(readAll(searchSet.createReadStreamForMember("b.txt")), "second");
+		TS_ASSERT_EQUALS(numOpened.load(), 2);
+		TS_ASSERT_EQUALS(PrefetchMan.getNumRequests(), 0u);
+
+		// Once taken, the members are opened from the archive again
+		TS_ASSERT_EQUALS(readAll(searchSet.createReadStreamForMember("a.txt")), "first member");
+		TS_ASSERT_EQUALS(numOpened.load(), 3);
+
+		// Other archives do not see the prefetched members
+		PrefetchTestArchive archive;
+		searchSet.prefetch(makePaths());
+		delete archive.createReadStreamForMember("a.txt");
+		TS_ASSERT_EQUALS(PrefetchMan.getNumRequests(), 1u);
+#endif
+	}
+
+	void test_archive_destroyed() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		// The requests of an archive must not be found by a new archive
+		// allocated at the same address
+		Common::SearchSet *searchSet = new Common::SearchSet();
+		searchSet->add("test", new PrefetchTestArchive());
+		searchSet->prefetch(makePaths());
+		TS_ASSERT_EQUALS(PrefetchMan.getNumRequests(), 1u);
+
+		delete searchSet;
+		TS_ASSERT_EQUALS(PrefetchMan.getNumRequests(), 0u);
+		if (TaskPoolMan.getNumWorkers() == 0)
+			TS_ASSERT_EQUALS(numOpened.load(), 0);
+#endif
+	}
+};
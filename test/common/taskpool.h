@@ -0,0 +1,81 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/taskpool.h"
+
+#include "../system/null_osystem.h"
+
+class TaskPoolTestSuite : public CxxTest::TestSuite
+{
+	struct Counter {
+		Counter() : value(0) {}
+
+		Common::Atomic<uint32> value;
+	};
+
+	public:
+	void test_group() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Counter counter;
+		Common::TaskGroup group;
+		for (int i = 0; i < 100; i++)
+			group.run([&counter]() { counter.value.fetchAdd(1); });
+
+		group.wait();
+		TS_ASSERT(group.isDone());
+		TS_ASSERT_EQUALS(counter.value.load(), 100u);
+
+		// Waiting again, or for an empty group, returns at once
+		group.wait();
+		Common::TaskGroup empty;
+		TS_ASSERT(empty.isDone());
+		empty.wait();
+#endif
+	}
+
+	void test_nested_groups() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Counter counter;
+		{
+			Common::TaskGroup group;
+			for (int i = 0; i < 8; i++) {
+				group.run([&counter]() {
+					Common::TaskGroup inner;
+					for (int j = 0; j < 8; j++)
+						inner.run([&counter]() { counter.value.fetchAdd(1); });
+					inner.wait();
+					counter.value.fetchAdd(100);
+				});
+			}
+			// The destructor waits for the tasks
+		}
+		TS_ASSERT_EQUALS(counter.value.load(), 8u * 108u);
+#endif
+	}
+
+	void test_async() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Future<int> empty;
+		TS_ASSERT(!empty.isValid());
+
+		Common::Future<int> future = Common::async([]() { return 6 * 7; });
+		TS_ASSERT(future.isValid());
+		TS_ASSERT_EQUALS(future.get(), 42);
+		TS_ASSERT(future.isReady());
+
+		Common::Array<Common::Future<uint32> > futures;
+		for (uint32 i = 0; i < 16; i++)
+			futures.push_back(Common::async([i]() { return i * i; }));
+
+		uint32 sum = 0;
+		for (uint i = 0; i < futures.size(); i++)
+			sum += futures[i].get();
+		TS_ASSERT_EQUALS(sum, 1240u);
+#endif
+	}
+};
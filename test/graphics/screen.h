@@ -0,0 +1,134 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/array.h"
+#include "common/rect.h"
+
+#include "graphics/screen.h"
+
+/**
+ * Gives access to the rectangles made from the dirty tiles.
+ */
+class TileScreen : public Graphics::Screen {
+public:
+	TileScreen(int width, int height) : Graphics::Screen(width, height) {}
+
+	void getRects(Common::Array<Common::Rect> &rects) { getDirtyTileRects(rects); }
+};
+
+class ScreenTestSuite : public CxxTest::TestSuite {
+	/** Return whether the rectangles cover exactly the pixels in @p expected. */
+	static bool coversExactly(const Common::Array<Common::Rect> &rects, const Common::Array<Common::Rect> &expected, int width, int height) {
+		for (int y = 0; y < height; y++) {
+			for (int x = 0; x < width; x++) {
+				int covered = 0;
+				for (uint i = 0; i < rects.size(); i++)
+					covered += rects[i].contains(x, y) ? 1 : 0;
+
+				bool inExpected = false;
+				for (uint i = 0; i < expected.size(); i++)
+					inExpected = inExpected || expected[i].contains(x, y);
+
+				// The rectangles must not overlap either
+				if (covered != (inExpected ? 1 : 0))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+public:
+	void test_tiles_merge_into_spans() {
+		TileScreen screen(100, 50);
+		screen.setDirtyTileSize(16);
+		// A newly created screen is entirely dirty
+		TS_ASSERT(screen.isDirty());
+		screen.clearDirtyRects();
+		TS_ASSERT(!screen.isDirty());
+
+		// Many small overlapping rects within the same two tiles
+		for (int i = 0; i < 20; i++)
+			screen.addDirtyRect(Common::Rect(i, 2, i + 4, 6));
+		// A block spanning three rows of tiles
+		screen.addDirtyRect(Common::Rect(40, 10, 70, 40));
+		TS_ASSERT(screen.isDirty());
+
+		Common::Array<Common::Rect> rects;
+		screen.getRects(rects);
+
+		Common::Array<Common::Rect> expected;
+		expected.push_back(Common::Rect(0, 0, 32, 16));
+		expected.push_back(Common::Rect(32, 0, 80, 48));
+		TS_ASSERT_EQUALS(rects.size(), 2u);
+		TS_ASSERT(coversExactly(rects, expected, 100, 50));
+
+		screen.clearDirtyRects();
+		TS_ASSERT(!screen.isDirty());
+		screen.getRects(rects);
+		TS_ASSERT(rects.empty());
+	}
+
+	void test_tiles_clip_to_screen() {
+		TileScreen screen(100, 50);
+		screen.setDirtyTileSize(16);
+		screen.clearDirtyRects();
+
+		screen.addDirtyRect(Common::Rect(90, 40, 120, 70));
+		screen.addDirtyRect(Common::Rect(-10, -10, 0, 0));
+
+		Common::Array<Common::Rect> rects;
+		screen.getRects(rects);
+
+		Common::Array<Common::Rect> expected;
+		expected.push_back(Common::Rect(80, 32, 100, 50));
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT(coversExactly(rects, expected, 100, 50));
+
+		screen.makeAllDirty();
+		screen.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		if (!rects.empty())
+			TS_ASSERT(rects[0] == Common::Rect(0, 0, 100, 50));
+	}
+
+	void test_tiles_keep_disjoint_areas_apart() {
+		TileScreen screen(64, 64);
+		screen.setDirtyTileSize(8);
+		screen.clearDirtyRects();
+
+		// A checkerboard of tiles, so that no two of them can be merged
+		Common::Array<Common::Rect> expected;
+		for (int y = 0; y < 64; y += 8) {
+			for (int x = (y / 8) & 1 ? 8 : 0; x < 64; x += 16) {
+				expected.push_back(Common::Rect(x + 1, y + 1, x + 7, y + 7));
+				screen.addDirtyRect(expected.back());
+				expected.back() = Common::Rect(x, y, x + 8, y + 8);
+			}
+		}
+
+		Common::Array<Common::Rect> rects;
+		screen.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), expected.size());
+		TS_ASSERT(coversExactly(rects, expected, 64, 64));
+	}
+
+	void test_switching_modes_keeps_dirty_areas() {
+		TileScreen screen(100, 50);
+		screen.clearDirtyRects();
+		screen.addDirtyRect(Common::Rect(10, 10, 20, 20));
+
+		screen.setDirtyTileSize(16);
+		TS_ASSERT(screen.isDirty());
+
+		Common::Array<Common::Rect> rects;
+		screen.getRects(rects);
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		if (!rects.empty())
+			TS_ASSERT(rects[0] == Common::Rect(0, 0, 100, 50));
+
+		screen.setDirtyTileSize(0);
+		TS_ASSERT(screen.isDirty());
+		screen.getRects(rects);
+		TS_ASSERT(rects.empty());
+	}
+};
@@ -0,0 +1,176 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "common/system.h"
+#include "common/textconsole.h"
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "../system/null_osystem.h"
+
+/**
+ * Checks that the SIMD converters give the same pixels as the tables, for
+ * all the chroma subsamplings, luminance scales and a range of formats.
+ */
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum Subsampling {
+		k444,
+		k422,
+		k420,
+		k420Alpha,
+		k410
+	};
+
+	// Not a multiple of the vector sizes, so the tables convert the end of each row
+	static const int kWidth = 252;
+	static const int kHeight = 64;
+
+	static uint32 nextRandom(uint32 &seed) {
+		seed = seed * 1103515245 + 12345;
+		return seed >> 16;
+	}
+
+	static void convert(Graphics::Surface &dst, Subsampling subsampling, Graphics::YUVToRGBManager::LuminanceScale scale,
+	                    const byte *y, const byte *u, const byte *v, const byte *a, int width, int height, int uvPitch) {
+		switch (subsampling) {
+		case k444:
+			YUVToRGBMan.convert444(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		case k422:
+			YUVToRGBMan.convert422(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		case k420:
+			YUVToRGBMan.convert420(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		case k420Alpha:
+			YUVToRGBMan.convert420Alpha(&dst, scale, y, u, v, a, width, height, width, uvPitch);
+			break;
+		case k410:
+			YUVToRGBMan.convert410(&dst, scale, y, u, v, width, height, width, uvPitch);
+			break;
+		}
+	}
+
+	/**
+	 * Convert with the tables and with @p func, and compare the results.
+	 */
+	static bool compare(Graphics::YUVToRGBRowConverter::ConvertFunc func, const Graphics::PixelFormat &format,
+	                    Subsampling subsampling, Graphics::YUVToRGBManager::LuminanceScale scale,
+	                    const byte *y, const byte *u, const byte *v, const byte *a, int width, int height, int uvPitch) {
+		Graphics::Surface expected, actual;
+		expected.create(width, height, format);
+		actual.create(width, height, format);
+
+		Graphics::YUVToRGBRowConverter::convertFunc = Graphics::YUVToRGBRowConverter::convertNone;
+		convert(expected, subsampling, scale, y, u, v, a, width, height, uvPitch);
+
+		Graphics::YUVToRGBRowConverter::convertFunc = func;
+		convert(actual, subsampling, scale, y, u, v, a, width, height, uvPitch);
+
+		Graphics::YUVToRGBRowConverter::convertFunc = nullptr;
+
+		bool equal = true;
+		for (int i = 0; i < height && equal; i++)
+			equal = memcmp(expected.getBasePtr(0, i), actual.getBasePtr(0, i), width * format.bytesPerPixel) == 0;
+
+		expected.free();
+		actual.free();
+		return equal;
+	}
+
+	static void compareAll(Graphics::YUVToRGBRowConverter::ConvertFunc func) {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The manager locks a mutex
+		Common::install_null_g_system();
+#endif
+
+		static const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 0, 10, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 0, 5, 10, 15),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24)
+		};
+
+		// The chroma planes have the extra row and column needed for YUV410
+		const int uvPitch = kWidth + 1;
+		byte *y = new byte[kWidth * kHeight];
+		byte *a = new byte[kWidth * kHeight];
+		byte *u = new byte[uvPitch * (kHeight + 1)];
+		byte *v = new byte[uvPitch * (kHeight + 1)];
+
+		uint32 seed = 0x5eed;
+		for (int i = 0; i < kWidth * kHeight; i++) {
+			y[i] = nextRandom(seed);
+			a[i] = nextRandom(seed);
+		}
+		for (int i = 0; i < uvPitch * (kHeight + 1); i++) {
+			u[i] = nextRandom(seed);
+			v[i] = nextRandom(seed);
+		}
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			for (int s = k444; s <= k410; s++) {
+				TS_ASSERT(compare(func, formats[f], (Subsampling)s, Graphics::YUVToRGBManager::kScaleFull, y, u, v, a, kWidth, kHeight, uvPitch));
+				TS_ASSERT(compare(func, formats[f], (Subsampling)s, Graphics::YUVToRGBManager::kScaleITU, y, u, v, a, kWidth, kHeight, uvPitch));
+			}
+		}
+
+		delete[] y;
+		delete[] a;
+		delete[] u;
+		delete[] v;
+
+		// Every luminance against every chroma value, so the clipping is
+		// checked at both ends of the range
+		y = new byte[256 * 256];
+		u = new byte[256 * 256];
+		v = new byte[256 * 256];
+		for (int i = 0; i < 256; i++) {
+			for (int j = 0; j < 256; j++) {
+				y[i * 256 + j] = j;
+				u[i * 256 + j] = i;
+				v[i * 256 + j] = i + j;
+			}
+		}
+
+		for (int f = 0; f < ARRAYSIZE(formats); f++) {
+			TS_ASSERT(compare(func, formats[f], k444, Graphics::YUVToRGBManager::kScaleFull, y, u, v, nullptr, 256, 256, 256));
+			TS_ASSERT(compare(func, formats[f], k444, Graphics::YUVToRGBManager::kScaleITU, y, u, v, nullptr, 256, 256, 256));
+		}
+
+		delete[] y;
+		delete[] u;
+		delete[] v;
+	}
+
+public:
+	void test_itu_scale() {
+		for (int i = 0; i <= 219; i++)
+			TS_ASSERT_EQUALS(i * 255 / 219, i + ((i * Graphics::YUVToRGBRowConverter::kITUScale) >> 16));
+	}
+
+	void test_convert_sse2() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() >= 2)
+			compareAll(Graphics::YUVToRGBRowConverter::convertSSE2);
+#endif
+	}
+
+	void test_convert_avx2() {
+#ifdef SCUMMVM_AVX2
+		if (instrset_detect() >= 8)
+			compareAll(Graphics::YUVToRGBRowConverter::convertAVX2);
+#endif
+	}
+
+	void test_convert_neon() {
+#ifdef SCUMMVM_NEON
+		compareAll(Graphics::YUVToRGBRowConverter::convertNEON);
+#endif
+	}
+};
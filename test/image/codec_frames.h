@@ -0,0 +1,181 @@
+#ifndef TEST_IMAGE_CODEC_FRAMES_H
+#define TEST_IMAGE_CODEC_FRAMES_H
+
+#include "common/memstream.h"
+#include "common/util.h"
+
+/**
+ * Generates frames of the codecs which write RGB straight to the output
+ * format, or convert their colors to it, from a fixed seed.
+ */
+class CodecFrameGenerator {
+public:
+	CodecFrameGenerator(uint32 seed) : _seed(seed) {}
+
+	/**
+	 * Generate an RPZA frame with a random mix of fill, four color and
+	 * sixteen color blocks.
+	 */
+	void createRPZAFrame(Common::MemoryWriteStreamDynamic &frame, uint16 width, uint16 height) {
+		Common::MemoryWriteStreamDynamic blocks(DisposeAfterUse::YES);
+
+		int blocksLeft = ((width + 3) / 4) * ((height + 3) / 4);
+		while (blocksLeft > 0) {
+			const int count = MIN<int>(blocksLeft, (nextRandom() & 0x1F) + 1);
+
+			switch (nextRandom() % 3) {
+			case 0:
+				blocks.writeByte(0xA0 | (count - 1));
+				blocks.writeUint16BE(nextRandom() & 0x7FFF);
+				break;
+			case 1:
+				blocks.writeByte(0xC0 | (count - 1));
+				blocks.writeUint16BE(nextRandom() & 0x7FFF);
+				blocks.writeUint16BE(nextRandom() & 0x7FFF);
+				for (int i = 0; i < count; i++)
+					blocks.writeUint32BE(nextRandom());
+				break;
+			default:
+				for (int i = 0; i < count; i++) {
+					for (int j = 0; j < 16; j++)
+						blocks.writeUint16BE(nextRandom() & 0x7FFF);
+				}
+				break;
+			}
+
+			blocksLeft -= count;
+		}
+
+		frame.writeByte(0xE1);
+		writeUint24BE(frame, 4 + blocks.size());
+		frame.write(blocks.getData(), blocks.size());
+	}
+
+	/**
+	 * Generate a 16-bit MS Video 1 frame with a random mix of one, two and
+	 * eight color blocks.
+	 */
+	void createMSVideo1Frame(Common::MemoryWriteStreamDynamic &frame, uint16 width, uint16 height) {
+		const int blockCount = (width / 4) * (height / 4);
+		for (int block = 0; block < blockCount; block++) {
+			switch (nextRandom() % 3) {
+			case 0:
+				// Avoid the skip codes, which are 0x84xx to 0x87xx
+				frame.writeUint16LE((nextRandom() & 0x7FFF) | 0x8800);
+				break;
+			case 1:
+				frame.writeUint16LE(nextRandom() & 0x7FFF);
+				frame.writeUint16LE(nextRandom() & 0x7FFF);
+				frame.writeUint16LE(nextRandom());
+				break;
+			default:
+				frame.writeUint16LE(nextRandom() & 0x7FFF);
+				frame.writeUint16LE(nextRandom() | 0x8000);
+				for (int i = 0; i < 7; i++)
+					frame.writeUint16LE(nextRandom());
+				break;
+			}
+		}
+	}
+
+	enum CinepakCodebooks {
+		kCinepakCodebooksNone,    ///< Keep the codebooks of the previous frame
+		kCinepakCodebooksPartial, ///< Replace some entries of each codebook
+		kCinepakCodebooksFull     ///< Replace all entries of each codebook
+	};
+
+	/**
+	 * Generate a Cinepak frame split into strips, each with its own codebooks,
+	 * and a random mix of V1 and V4 blocks covering the whole frame.
+	 */
+	void createCinepakFrame(Common::MemoryWriteStreamDynamic &frame, uint16 width, uint16 height, uint16 stripCount, CinepakCodebooks codebooks) {
+		Common::MemoryWriteStreamDynamic strips(DisposeAfterUse::YES);
+
+		const uint16 stripHeight = (height / stripCount) & ~3;
+		for (uint16 strip = 0; strip < stripCount; strip++) {
+			Common::MemoryWriteStreamDynamic chunks(DisposeAfterUse::YES);
+
+			if (codebooks != kCinepakCodebooksNone) {
+				writeCinepakCodebook(chunks, 0x20, codebooks == kCinepakCodebooksPartial);
+				writeCinepakCodebook(chunks, 0x22, codebooks == kCinepakCodebooksPartial);
+			}
+
+			const uint16 rows = (strip == stripCount - 1) ? height - strip * stripHeight : stripHeight;
+			writeCinepakVectors(chunks, (width / 4) * (rows / 4));
+
+			strips.writeUint16BE(0x1000);
+			strips.writeUint16BE(12 + chunks.size());
+			strips.writeUint16BE(0);
+			strips.writeUint16BE(0);
+			strips.writeUint16BE(rows);
+			strips.writeUint16BE(width);
+			strips.write(chunks.getData(), chunks.size());
+		}
+
+		frame.writeByte(1);
+		writeUint24BE(frame, 10 + strips.size());
+		frame.writeUint16BE(width);
+		frame.writeUint16BE(height);
+		frame.writeUint16BE(stripCount);
+		frame.write(strips.getData(), strips.size());
+	}
+
+private:
+	/** Write a V4 (0x20) or V1 (0x22) codebook chunk with YUV entries. */
+	void writeCinepakCodebook(Common::MemoryWriteStreamDynamic &chunks, byte chunkID, bool partial) {
+		Common::MemoryWriteStreamDynamic entries(DisposeAfterUse::YES);
+
+		for (int i = 0; i < 256; i += 32) {
+			// Partial updates flag the entries which follow, 32 at a time
+			const uint32 flags = partial ? nextRandom() : 0xFFFFFFFF;
+			if (partial)
+				entries.writeUint32BE(flags);
+
+			for (int j = 0; j < 32; j++) {
+				if (flags & (0x80000000 >> j)) {
+					entries.writeUint32BE(nextRandom());
+					entries.writeUint16BE(nextRandom());
+				}
+			}
+		}
+
+		chunks.writeByte(partial ? chunkID | 1 : chunkID);
+		writeUint24BE(chunks, 4 + entries.size());
+		chunks.write(entries.getData(), entries.size());
+	}
+
+	/** Write a vectors chunk (0x30), where each flag picks a V4 or a V1 block. */
+	void writeCinepakVectors(Common::MemoryWriteStreamDynamic &chunks, int blockCount) {
+		Common::MemoryWriteStreamDynamic vectors(DisposeAfterUse::YES);
+
+		for (int block = 0; block < blockCount; block += 32) {
+			const uint32 flags = nextRandom();
+			vectors.writeUint32BE(flags);
+
+			for (int i = 0; i < 32 && block + i < blockCount; i++) {
+				if (flags & (0x80000000 >> i))
+					vectors.writeUint32BE(nextRandom());
+				else
+					vectors.writeByte(nextRandom());
+			}
+		}
+
+		chunks.writeByte(0x30);
+		writeUint24BE(chunks, 4 + vectors.size());
+		chunks.write(vectors.getData(), vectors.size());
+	}
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) | (_seed << 16);
+	}
+
+	static void writeUint24BE(Common::WriteStream &stream, uint32 value) {
+		stream.writeByte(value >> 16);
+		stream.writeUint16BE(value & 0xFFFF);
+	}
+};
+
+#endif
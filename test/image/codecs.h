@@ -0,0 +1,254 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/system.h"
+#include "common/textconsole.h"
+#include "common/util.h"
+
+#include "graphics/surface.h"
+
+#include "image/codecs/cinepak.h"
+#include "image/codecs/msvideo1.h"
+#include "image/codecs/rpza.h"
+#ifdef USE_INDEO45
+#include "image/codecs/indeo5.h"
+#endif
+
+#include "codec_frames.h"
+#include "../system/null_osystem.h"
+
+#ifdef USE_INDEO45
+/**
+ * An Indeo 5 decoder outputting frames of random planes, as decoded intra
+ * frames would be.
+ */
+class TestIndeo5Decoder : public Image::Indeo5Decoder {
+public:
+	TestIndeo5Decoder(uint16 width, uint16 height) : Image::Indeo5Decoder(width, height) {}
+
+	/**
+	 * Output a frame split into the given number of bands, and return a
+	 * copy of the converted surface.
+	 */
+	Graphics::Surface *outputRandomFrame(uint32 seed, int numBands) {
+		Image::Indeo::IVIPicConfig picConf;
+		picConf._picWidth = _width;
+		picConf._picHeight = _height;
+		picConf._chromaWidth = (_width + 3) / 4;
+		picConf._chromaHeight = (_height + 3) / 4;
+		picConf._tileWidth = _width;
+		picConf._tileHeight = _height;
+		picConf._lumaBands = 1;
+		picConf._chromaBands = 1;
+		if (Image::Indeo::IVIPlaneDesc::initPlanes(_ctx._planes, &picConf, false) < 0)
+			return nullptr;
+
+		// Values outside of the range of a byte test the clipping as well
+		for (int p = 0; p < 3; p++) {
+			Image::Indeo::IVIBandDesc &band = _ctx._planes[p]._bands[0];
+			band._buf = band._bufs[0];
+			for (int i = 0; i < band._pitch * band._aHeight; i++) {
+				seed = seed * 1103515245 + 12345;
+				band._buf[i] = (int16)((seed >> 16) % 320) - 160;
+			}
+		}
+
+		if (!_surface) {
+			_surface = new Graphics::Surface();
+			_surface->create(_width, _height, getPixelFormat());
+		}
+
+		Image::Indeo::AVFrame frame;
+		frame.setDimensions(_width, _height);
+		frame.getBuffer(0);
+		outputFrame(&frame, numBands);
+
+		Graphics::Surface *copy = new Graphics::Surface();
+		copy->copyFrom(*_surface);
+		return copy;
+	}
+};
+#endif
+
+/**
+ * Checks that the codecs which write RGB straight to the output format give
+ * the same pixels in every format, using frames generated from a fixed seed.
+ */
+class CodecsTestSuite : public CxxTest::TestSuite {
+	/**
+	 * Check that every pixel of a frame decoded in another format is the
+	 * reference pixel converted to that format.
+	 */
+	static void checkConversion(const Graphics::Surface *reference, const Graphics::Surface *surface) {
+		TS_ASSERT(reference && surface);
+		if (!reference || !surface)
+			return;
+
+		TS_ASSERT_EQUALS(reference->w, surface->w);
+		TS_ASSERT_EQUALS(reference->h, surface->h);
+
+		int mismatches = 0;
+		for (int y = 0; y < surface->h; y++) {
+			for (int x = 0; x < surface->w; x++) {
+				byte r, g, b;
+				reference->format.colorToRGB(reference->getPixel(x, y), r, g, b);
+				if (surface->getPixel(x, y) != surface->format.RGBToColor(r, g, b))
+					mismatches++;
+			}
+		}
+
+		TS_ASSERT_EQUALS(mismatches, 0);
+	}
+
+	/**
+	 * Decode a frame from a fresh codec using the given output format.
+	 */
+	template<typename Decoder>
+	static Graphics::Surface *decodeCopy(Decoder &decoder, Common::MemoryWriteStreamDynamic &frame, const Graphics::PixelFormat &format) {
+		TS_ASSERT(decoder.setOutputPixelFormat(format));
+
+		Common::MemoryReadStream stream(frame.getData(), frame.size());
+		const Graphics::Surface *surface = decoder.decodeFrame(stream);
+		TS_ASSERT(surface);
+		if (!surface)
+			return nullptr;
+
+		TS_ASSERT_EQUALS(surface->format, format);
+
+		Graphics::Surface *copy = new Graphics::Surface();
+		copy->copyFrom(*surface);
+		return copy;
+	}
+
+	static void freeCopy(Graphics::Surface *surface) {
+		if (surface) {
+			surface->free();
+			delete surface;
+		}
+	}
+
+	static const Graphics::PixelFormat kFormat555;
+	static const Graphics::PixelFormat kFormat565;
+	static const Graphics::PixelFormat kFormatRGBA;
+
+public:
+	void test_rpza_formats() {
+		Common::MemoryWriteStreamDynamic frame(DisposeAfterUse::YES);
+		CodecFrameGenerator(2).createRPZAFrame(frame, 66, 46);
+
+		Image::RPZADecoder referenceDecoder(66, 46), decoder565(66, 46), decoderRGBA(66, 46);
+		Graphics::Surface *reference = decodeCopy(referenceDecoder, frame, kFormat555);
+		Graphics::Surface *surface565 = decodeCopy(decoder565, frame, kFormat565);
+		Graphics::Surface *surfaceRGBA = decodeCopy(decoderRGBA, frame, kFormatRGBA);
+
+		checkConversion(reference, surface565);
+		checkConversion(reference, surfaceRGBA);
+
+		freeCopy(reference);
+		freeCopy(surface565);
+		freeCopy(surfaceRGBA);
+	}
+
+	void test_msvideo1_formats() {
+		Common::MemoryWriteStreamDynamic frame(DisposeAfterUse::YES);
+		CodecFrameGenerator(3).createMSVideo1Frame(frame, 64, 48);
+
+		Image::MSVideo1Decoder referenceDecoder(64, 48, 16), decoder565(64, 48, 16), decoderRGBA(64, 48, 16);
+		Graphics::Surface *reference = decodeCopy(referenceDecoder, frame, kFormat555);
+		Graphics::Surface *surface565 = decodeCopy(decoder565, frame, kFormat565);
+		Graphics::Surface *surfaceRGBA = decodeCopy(decoderRGBA, frame, kFormatRGBA);
+
+		checkConversion(reference, surface565);
+		checkConversion(reference, surfaceRGBA);
+
+		freeCopy(reference);
+		freeCopy(surface565);
+		freeCopy(surfaceRGBA);
+	}
+
+	void test_cinepak_formats() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The decoder picks its initial format from the screen format
+		Common::install_null_g_system();
+
+		// A key frame, then frames updating some or none of the codebook entries
+		const CodecFrameGenerator::CinepakCodebooks codebooks[] = {
+			CodecFrameGenerator::kCinepakCodebooksFull,
+			CodecFrameGenerator::kCinepakCodebooksPartial,
+			CodecFrameGenerator::kCinepakCodebooksNone
+		};
+		const int frameCount = ARRAYSIZE(codebooks);
+
+		CodecFrameGenerator generator(4);
+		Common::MemoryWriteStreamDynamic *frames[frameCount];
+		for (int i = 0; i < frameCount; i++) {
+			frames[i] = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+			generator.createCinepakFrame(*frames[i], 64, 48, 2, codebooks[i]);
+		}
+
+		// The reference is decoded to 32bpp, which keeps all of the color
+		Image::CinepakDecoder referenceDecoder, decoder555, decoder565, switchingDecoder;
+		const Graphics::PixelFormat switchingFormats[] = { kFormatRGBA, kFormat565, kFormat555 };
+
+		for (int i = 0; i < frameCount; i++) {
+			Graphics::Surface *reference = decodeCopy(referenceDecoder, *frames[i], kFormatRGBA);
+
+			// Codebooks converted to the output format as they are loaded
+			Graphics::Surface *surface555 = decodeCopy(decoder555, *frames[i], kFormat555);
+			Graphics::Surface *surface565 = decodeCopy(decoder565, *frames[i], kFormat565);
+			checkConversion(reference, surface555);
+			checkConversion(reference, surface565);
+
+			// Codebooks converted again when the output format changes, with
+			// the surface recreated in the new format
+			Graphics::Surface *switched = decodeCopy(switchingDecoder, *frames[i], switchingFormats[i]);
+			checkConversion(reference, switched);
+
+			freeCopy(reference);
+			freeCopy(surface555);
+			freeCopy(surface565);
+			freeCopy(switched);
+		}
+
+		for (int i = 0; i < frameCount; i++)
+			delete frames[i];
+#endif
+	}
+
+	void test_indeo_bands() {
+#if NULL_OSYSTEM_IS_AVAILABLE && defined(USE_INDEO45)
+		// The bands are output on the worker threads of the task pool
+		Common::install_null_g_system();
+
+		// Bands of 16 lines, with a shorter last one
+		// The decoder holds large tables
+		TestIndeo5Decoder *decoder = new TestIndeo5Decoder(72, 100);
+		Graphics::Surface *reference = decoder->outputRandomFrame(5, 1);
+		TS_ASSERT(reference);
+
+		const int bandCounts[] = { 2, 3, 6 };
+		for (int i = 0; i < ARRAYSIZE(bandCounts) && reference; i++) {
+			Graphics::Surface *surface = decoder->outputRandomFrame(5, bandCounts[i]);
+			TS_ASSERT(surface);
+			if (!surface)
+				break;
+
+			int mismatches = 0;
+			for (int y = 0; y < surface->h; y++) {
+				if (memcmp(surface->getBasePtr(0, y), reference->getBasePtr(0, y), surface->w * surface->format.bytesPerPixel))
+					mismatches++;
+			}
+			TS_ASSERT_EQUALS(mismatches, 0);
+
+			freeCopy(surface);
+		}
+
+		freeCopy(reference);
+		delete decoder;
+#endif
+	}
+};
+
+const Graphics::PixelFormat CodecsTestSuite::kFormat555(2, 5, 5, 5, 0, 10, 5, 0, 0);
+const Graphics::PixelFormat CodecsTestSuite::kFormat565(2, 5, 6, 5, 0, 11, 5, 0, 0);
+const Graphics::PixelFormat CodecsTestSuite::kFormatRGBA(4, 8, 8, 8, 8, 24, 16, 8, 0);
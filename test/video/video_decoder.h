@@ -0,0 +1,181 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/scummsys.h"
+
+#include "graphics/surface.h"
+#include "video/video_decoder.h"
+
+#include "../system/null_osystem.h"
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite
+{
+	/**
+	 * A video of paletted frames filled with their frame number. The palette
+	 * is inverted every tenth frame.
+	 */
+	class TestDecoder : public Video::VideoDecoder {
+	public:
+		TestDecoder(int frameCount = 3, bool decodeAhead = false) :
+			_frameCount(frameCount), _decodeAhead(decodeAhead) {}
+
+		bool loadStream(Common::SeekableReadStream *stream) override {
+			addTrack(new TestVideoTrack(_frameCount));
+			return true;
+		}
+
+	protected:
+		bool supportsDecodeAhead() const override { return _decodeAhead; }
+
+	private:
+		int _frameCount;
+		bool _decodeAhead;
+
+		class TestVideoTrack : public FixedRateVideoTrack {
+		public:
+			TestVideoTrack(int frameCount) : _curFrame(-1), _frameCount(frameCount), _seeked(true) {
+				_surface.create(4, 2, Graphics::PixelFormat::createFormatCLUT8());
+			}
+			~TestVideoTrack() { _surface.free(); }
+
+			uint16 getWidth() const override { return _surface.w; }
+			uint16 getHeight() const override { return _surface.h; }
+			Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+			int getCurFrame() const override { return _curFrame; }
+			int getFrameCount() const override { return _frameCount; }
+
+			const Graphics::Surface *decodeNextFrame() override {
+				_curFrame++;
+				_surface.fillRect(Common::Rect(_surface.w, _surface.h), _curFrame * 100);
+
+				_dirtyPalette = _seeked || _curFrame % 10 == 0;
+				_seeked = false;
+				if (_dirtyPalette) {
+					const bool inverted = (_curFrame / 10) & 1;
+					for (int i = 0; i < 256; i++) {
+						const byte index = inverted ? 255 - i : i;
+						_palette[i * 3 + 0] = index;
+						_palette[i * 3 + 1] = 255 - index;
+						_palette[i * 3 + 2] = 0;
+					}
+				}
+
+				return &_surface;
+			}
+
+			const byte *getPalette() const override { return _palette; }
+			bool hasDirtyPalette() const override { return _dirtyPalette; }
+
+			bool isSeekable() const override { return true; }
+			bool seek(const Audio::Timestamp &time) override {
+				_curFrame = getFrameAtTime(time) - 1;
+				_seeked = true;
+				return true;
+			}
+
+		protected:
+			Common::Rational getFrameRate() const override { return 10; }
+
+		private:
+			int _curFrame;
+			int _frameCount;
+			bool _seeked;
+			bool _dirtyPalette;
+			Graphics::Surface _surface;
+			byte _palette[256 * 3];
+		};
+	};
+
+public:
+	void test_decode_into() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The decoder locks a mutex
+		Common::install_null_g_system();
+
+		TestDecoder decoder;
+		decoder.loadStream(nullptr);
+
+		// Larger than the frames, which must be clipped
+		Graphics::Surface screen;
+		screen.create(6, 3, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+
+		for (int frame = 0; frame < 3; frame++) {
+			screen.fillRect(Common::Rect(screen.w, screen.h), 0);
+
+			TS_ASSERT(decoder.decodeNextFrameInto(screen));
+			TS_ASSERT_EQUALS(decoder.getCurFrame(), frame);
+
+			const byte index = frame * 100;
+			const uint16 color = screen.format.RGBToColor(index, 255 - index, 0);
+			for (int y = 0; y < screen.h; y++) {
+				for (int x = 0; x < screen.w; x++) {
+					const uint16 expected = (x < 4 && y < 2) ? color : 0;
+					TS_ASSERT_EQUALS(*(const uint16 *)screen.getBasePtr(x, y), expected);
+				}
+			}
+		}
+
+		TS_ASSERT(decoder.endOfVideo());
+		screen.free();
+#endif
+	}
+	/** Play a video, recording each frame as the RGB colors of its pixels. */
+	static Common::Array<uint32> playVideo(TestDecoder &decoder) {
+		Common::Array<uint32> frames;
+		const byte *palette = nullptr;
+
+		decoder.start();
+		while (!decoder.endOfVideo()) {
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			if (!frame)
+				break;
+
+			if (decoder.hasDirtyPalette())
+				palette = decoder.getPalette();
+			TS_ASSERT(palette);
+			if (!palette)
+				break;
+
+			frames.push_back(decoder.getCurFrame());
+			for (int y = 0; y < frame->h; y++) {
+				for (int x = 0; x < frame->w; x++) {
+					const byte *color = palette + *(const byte *)frame->getBasePtr(x, y) * 3;
+					frames.push_back((color[0] << 16) | (color[1] << 8) | color[2]);
+				}
+			}
+		}
+
+		return frames;
+	}
+
+	void test_decode_ahead() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		// The frame number and the colors of the 4x2 pixels
+		const uint kFrameSize = 1 + 4 * 2;
+
+		Common::install_null_g_system();
+
+		TestDecoder decoder(25, false);
+		decoder.loadStream(nullptr);
+		const Common::Array<uint32> expected = playVideo(decoder);
+		TS_ASSERT_EQUALS(expected.size(), 25u * kFrameSize);
+
+		// The frames decoded on the worker threads are the same
+		TestDecoder aheadDecoder(25, true);
+		aheadDecoder.loadStream(nullptr);
+		aheadDecoder.setDecodeAhead(4);
+		const Common::Array<uint32> frames = playVideo(aheadDecoder);
+		TS_ASSERT(frames == expected);
+		TS_ASSERT_EQUALS(aheadDecoder.getCurFrame(), 24);
+
+		// As are those after seeking back while frames were decoded ahead
+		aheadDecoder.rewind();
+		aheadDecoder.decodeNextFrame();
+		aheadDecoder.decodeNextFrame();
+		TS_ASSERT(aheadDecoder.seekToFrame(12));
+		TS_ASSERT_EQUALS(aheadDecoder.getCurFrame(), 11);
+		const Common::Array<uint32> seekFrames = playVideo(aheadDecoder);
+		TS_ASSERT_EQUALS(seekFrames.size(), 13u * kFrameSize);
+		TS_ASSERT(seekFrames == Common::Array<uint32>(&expected[12 * kFrameSize], 13 * kFrameSize));
+#endif
+	}
+};
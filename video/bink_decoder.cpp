@@ -29,8 +29,9 @@
 #include "common/util.h"
 #include "common/textconsole.h"
 #include "common/intrinsics.h"
+#include "common/memstream.h"
 #include "common/stream.h"
-#include "common/substream.h"
+#include "common/taskpool.h"
 #include "common/file.h"
 #include "common/str.h"
 #include "common/bitstream.h"
@@ -65,6 +66,7 @@ namespace Video {
 
 BinkDecoder::BinkDecoder() {
 	_bink = 0;
+	_parallelDecoding = true;
 }
 
 BinkDecoder::~BinkDecoder() {
@@ -169,6 +171,10 @@ void BinkDecoder::readNextPacket() {
 
 	uint32 frameSize = frame.size;
 
+	// The packets are read into memory, so that the audio can be decoded
+	// on the worker threads while the video is decoded here
+	Common::TaskGroup audioTasks;
+
 	for (uint32 i = 0; i < _audioTracks.size(); i++) {
 		AudioInfo &audio = _audioTracks[i];
 
@@ -182,19 +188,24 @@ void BinkDecoder::readNextPacket() {
 		if (audioPacketLength >= 4) {
 			// Get our track - audio index plus one as the first track is video
 			BinkAudioTrack *audioTrack = (BinkAudioTrack *)getTrack(i + 1);
-			uint32 audioPacketStart = _bink->pos();
 			uint32 audioPacketEnd   = _bink->pos() + audioPacketLength;
 
 			//                  Number of samples in bytes
 			audio.sampleCount = _bink->readUint32LE() / (2 * audio.channels);
 
-			audio.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-					audioPacketStart + 4, audioPacketEnd), DisposeAfterUse::YES);
+			audio.bits = readPacket(audioPacketLength - 4);
+
+			auto decodeAudio = [&audio, audioTrack]() {
+				audioTrack->decodePacket();
 
-			audioTrack->decodePacket();
+				delete audio.bits;
+				audio.bits = 0;
+			};
 
-			delete audio.bits;
-			audio.bits = 0;
+			if (_parallelDecoding)
+				audioTasks.run(decodeAudio);
+			else
+				decodeAudio();
 
 			_bink->seek(audioPacketEnd);
 
@@ -202,16 +213,21 @@ void BinkDecoder::readNextPacket() {
 		}
 	}
 
-	uint32 videoPacketStart = _bink->pos();
-	uint32 videoPacketEnd   = _bink->pos() + frameSize;
+	frame.bits = readPacket(frameSize);
 
-	frame.bits = new Common::BitStream32LELSB(new Common::SeekableSubReadStream(_bink,
-			videoPacketStart, videoPacketEnd), DisposeAfterUse::YES);
-
-	videoTrack->decodePacket(frame);
+	videoTrack->decodePacket(frame, _parallelDecoding);
 
 	delete frame.bits;
 	frame.bits = 0;
+
+	audioTasks.wait();
+}
+
+Common::BitStream32LELSB *BinkDecoder::readPacket(uint32 size) {
+	byte *data = (byte *)malloc(MAX<uint32>(size, 1));
+	size = _bink->read(data, size);
+
+	return new Common::BitStream32LELSB(new Common::MemoryReadStream(data, size, DisposeAfterUse::YES), DisposeAfterUse::YES);
 }
 
 VideoDecoder::AudioTrack *BinkDecoder::getAudioTrack(int index) {
@@ -245,7 +261,7 @@ BinkDecoder::AudioInfo::~AudioInfo() {
 }
 
 BinkDecoder::BinkVideoTrack::BinkVideoTrack(uint32 width, uint32 height, uint32 frameCount, const Common::Rational &frameRate, bool swapPlanes, bool hasAlpha, uint32 id) :
-		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr) {
+		_frameCount(frameCount), _frameRate(frameRate), _swapPlanes(swapPlanes), _hasAlpha(hasAlpha), _id(id), _surface(nullptr), _outputSurface(nullptr) {
 	_curFrame = -1;
 
 	for (int i = 0; i < 16; i++)
@@ -444,10 +460,10 @@ bool BinkDecoder::BinkVideoTrack::rewind() {
 	return true;
 }
 
-void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
+void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame, bool parallel) {
 	assert(frame.bits);
 
-	if (!_surface) {
+	if (!_surface && !_outputSurface) {
 		_surface = new Graphics::Surface();
 		_surface->create(_surfaceWidth, _surfaceHeight, _pixelFormat);
 		// Since we over-allocate to make surfaces even-sized
@@ -476,24 +492,66 @@ void BinkDecoder::BinkVideoTrack::decodePacket(VideoFrame &frame) {
 			break;
 	}
 
-	// Convert the YUV data we have to our format
+	// Convert the YUV data we have to our format, split into bands of
+	// whole block rows for the worker threads
+	int bandHeight = _surfaceHeight;
+	if (parallel)
+		bandHeight = MAX<int>(((_surfaceHeight / (TaskPoolMan.getNumWorkers() + 1)) + 15) & ~15, 16);
+
+	convertPlanes(_outputSurface ? _outputSurface : _surface, bandHeight);
+
+	// And swap the planes with the reference planes
+	for (int i = 0; i < 4; i++)
+		SWAP(_curPlanes[i], _oldPlanes[i]);
+
+	_curFrame++;
+}
+
+bool BinkDecoder::BinkVideoTrack::setOutputSurface(Graphics::Surface *surface) {
+	// The planes are converted in whole pairs of lines, so the surface
+	// must hold the padding of odd-sized videos
+	if (surface && (surface->w < _surfaceWidth || surface->h < _surfaceHeight ||
+			(surface->format.bytesPerPixel != 2 && surface->format.bytesPerPixel != 4)))
+		return false;
+
+	_outputSurface = surface;
+	return true;
+}
+
+void BinkDecoder::BinkVideoTrack::convertPlanes(Graphics::Surface *dst, int bandHeight) {
+	if (bandHeight >= _surfaceHeight) {
+		convertBand(dst, 0, _surfaceHeight);
+		return;
+	}
+
+	Common::TaskGroup group;
+	for (int y = 0; y < _surfaceHeight; y += bandHeight) {
+		const int height = MIN(bandHeight, _surfaceHeight - y);
+		group.run([this, dst, y, height]() { convertBand(dst, y, height); });
+	}
+	group.wait();
+}
+
+void BinkDecoder::BinkVideoTrack::convertBand(Graphics::Surface *dst, int y, int height) {
+	Graphics::Surface band;
+	band.init(_surfaceWidth, height, dst->pitch, dst->getBasePtr(0, y), dst->format);
+
+	const uint32 yPitch  = _yBlockWidth  * 8;
+	const uint32 uvPitch = _uvBlockWidth * 8;
+	const uint32 yOffset  = y * yPitch;
+	const uint32 uvOffset = (y / 2) * uvPitch;
+
 	// The width used here is the surface-width, and not the video-width
 	// to allow for odd-sized videos.
 	if (_hasAlpha) {
 		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2] && _curPlanes[3]);
-		YUVToRGBMan.convert420Alpha(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2], _curPlanes[3],
-				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
+		YUVToRGBMan.convert420Alpha(&band, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0] + yOffset, _curPlanes[1] + uvOffset,
+				_curPlanes[2] + uvOffset, _curPlanes[3] + yOffset, _surfaceWidth, height, yPitch, uvPitch);
 	} else {
 		assert(_curPlanes[0] && _curPlanes[1] && _curPlanes[2]);
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0], _curPlanes[1], _curPlanes[2],
-				_surfaceWidth, _surfaceHeight, _yBlockWidth * 8, _uvBlockWidth * 8);
+		YUVToRGBMan.convert420(&band, Graphics::YUVToRGBManager::kScaleITU, _curPlanes[0] + yOffset, _curPlanes[1] + uvOffset,
+				_curPlanes[2] + uvOffset, _surfaceWidth, height, yPitch, uvPitch);
 	}
-
-	// And swap the planes with the reference planes
-	for (int i = 0; i < 4; i++)
-		SWAP(_curPlanes[i], _oldPlanes[i]);
-
-	_curFrame++;
 }
 
 void BinkDecoder::BinkVideoTrack::decodePlane(VideoFrame &video, int planeIdx, bool isChroma) {
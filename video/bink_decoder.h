@@ -76,9 +76,19 @@ public:
 
 	Common::Rational getFrameRate();
 
+	/**
+	 * Set whether to use the worker threads of the task pool. The audio
+	 * packets of a frame are then decoded while the video packet is, and the
+	 * conversion of the video frame to RGB is split between the threads.
+	 *
+	 * This is enabled by default, and does not change the decoded frames.
+	 */
+	void setParallelDecoding(bool parallel) { _parallelDecoding = parallel; }
+
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
+	bool supportsDecodeAhead() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 	bool seekIntern(const Audio::Timestamp &time);
 	uint32 findKeyFrame(uint32 frame) const;
@@ -162,14 +172,19 @@ private:
 
 		int getCurFrame() const override { return _curFrame; }
 		int getFrameCount() const override { return _frameCount; }
-		const Graphics::Surface *decodeNextFrame() override { return _surface; }
+		const Graphics::Surface *decodeNextFrame() override { return _outputSurface ? _outputSurface : _surface; }
+		bool setOutputSurface(Graphics::Surface *surface) override;
 		bool isSeekable() const  override{ return true; }
 		bool seek(const Audio::Timestamp &time) override { return true; }
 		bool rewind() override;
 		void setCurFrame(uint32 frame) { _curFrame = frame; }
 
-		/** Decode a video packet. */
-		void decodePacket(VideoFrame &frame);
+		/**
+		 * Decode a video packet.
+		 *
+		 * @param parallel	Whether to convert the frame to RGB on the worker threads
+		 */
+		void decodePacket(VideoFrame &frame, bool parallel);
 
 		Common::Rational getFrameRate() const override { return _frameRate; }
 
@@ -251,6 +266,7 @@ private:
 		int _frameCount;
 
 		Graphics::Surface *_surface;
+		Graphics::Surface *_outputSurface; ///< The surface to decode into instead of _surface, if set
 		Graphics::PixelFormat _pixelFormat;
 		uint16 _width;
 		uint16 _height;
@@ -292,6 +308,11 @@ private:
 		/** Decode a plane. */
 		void decodePlane(VideoFrame &video, int planeIdx, bool isChroma);
 
+		/** Convert the decoded planes to RGB into @p dst, in bands of @p bandHeight lines. */
+		void convertPlanes(Graphics::Surface *dst, int bandHeight);
+		/** Convert @p height lines of the decoded planes into @p dst, starting at line @p y. */
+		void convertBand(Graphics::Surface *dst, int y, int height);
+
 		/** Read/Initialize a bundle for decoding a plane. */
 		void readBundle(VideoFrame &video, Source source);
 
@@ -379,10 +400,15 @@ private:
 
 	Common::SeekableReadStream *_bink;
 
+	bool _parallelDecoding;
+
 	Common::Array<AudioInfo> _audioTracks; ///< All audio tracks.
 	Common::Array<VideoFrame> _frames;      ///< All video frames.
 
 	void initAudioTrack(AudioInfo &audio);
+
+	/** Read @p size bytes of a packet into a bit stream. */
+	Common::BitStream32LELSB *readPacket(uint32 size);
 };
 
 } // End of namespace Video
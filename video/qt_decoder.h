@@ -162,6 +162,9 @@ protected:
 	Common::QuickTimeParser::SampleDesc *readSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize);
 	Common::QuickTimeParser::SampleDesc *readPanoSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize);
 
+	// The audio is buffered and the VR angles updated after each frame
+	bool supportsDecodeAhead() const override { return false; }
+
 private:
 	void init();
 
@@ -86,11 +86,17 @@ public:
 
 	Common::Rational getFrameRate() const;
 
+	/**
+	 * Return the next area changed by the last frame decoded, or nullptr once
+	 * there are no more. This is not meant for videos decoded ahead.
+	 */
 	virtual const Common::Rect *getNextDirtyRect();
 
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
+	// readNextPacket() decodes the whole frame and queues the audio
+	bool supportsDecodeAhead() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 
 	virtual void handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize);
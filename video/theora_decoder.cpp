@@ -53,6 +53,10 @@ TheoraDecoder::TheoraDecoder() {
 	_videoTrack = 0;
 	_audioTrack = 0;
 	_hasVideo = _hasAudio = false;
+
+	_frameDropping = true;
+	_decodeTime = -1;
+	resetFrameStats();
 }
 
 TheoraDecoder::~TheoraDecoder() {
@@ -220,6 +224,7 @@ void TheoraDecoder::close() {
 	_fileStream = 0;
 
 	_hasVideo = _hasAudio = false;
+	resetFrameStats();
 }
 
 void TheoraDecoder::readNextPacket() {
@@ -228,8 +233,10 @@ void TheoraDecoder::readNextPacket() {
 		while (!_videoTrack->endOfTrack()) {
 			// theora is one in, one out...
 			if (ogg_stream_packetout(&_theoraOut, &_oggPacket) > 0) {
-				if (_videoTrack->decodePacket(_oggPacket))
+				if (_videoTrack->decodePacket(_oggPacket)) {
+					finishFrame(_decodeTime);
 					break;
+				}
 			} else if (_theoraOut.e_o_s || _fileStream->eos()) {
 				// If we can't get any more frames, we're done.
 				_videoTrack->setEndOfVideo();
@@ -245,8 +252,54 @@ void TheoraDecoder::readNextPacket() {
 		}
 	}
 
-	// Then make sure we have enough audio buffered
+	// Then make sure we have enough audio buffered, while the frame is
+	// being converted
 	ensureAudioBufferSize();
+
+	if (_hasVideo)
+		_videoTrack->waitForConversion();
+}
+
+const Graphics::Surface *TheoraDecoder::decodeNextFrame() {
+	// The frames are compared against the clock as it was when the frame
+	// was asked for, rather than reading it while decoding
+	_decodeTime = (isPlaying() && !isPaused()) ? (int32)getTime() : -1;
+	const Graphics::Surface *frame = VideoDecoder::decodeNextFrame();
+	_decodeTime = -1;
+
+	return frame;
+}
+
+void TheoraDecoder::finishFrame(int32 time) {
+	// Only a video being played can fall behind
+	if (time >= 0) {
+		// A frame is only asked for once its start time has passed, so it is
+		// late when the next one is due already and nothing would show it
+		const bool late = (uint32)time >= _videoTrack->getNextFrameStartTime();
+
+		_frameStats.decodedFrames++;
+		if (late)
+			_frameStats.lateFrames++;
+
+		if (_frameDropping) {
+			_videoTrack->updatePostProcessing(late);
+
+			// The first frame is always converted, so that there is one to
+			// show.
+			if (late && !_videoTrack->isKeyFrame() && _videoTrack->hasFrame()) {
+				_frameStats.droppedFrames++;
+				return;
+			}
+		}
+	}
+
+	_videoTrack->startConversion();
+}
+
+void TheoraDecoder::resetFrameStats() {
+	_frameStats.decodedFrames = 0;
+	_frameStats.lateFrames = 0;
+	_frameStats.droppedFrames = 0;
 }
 
 Common::Rational TheoraDecoder::getFrameRate() const {
@@ -262,9 +315,10 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_
 		error("Found unknown Theora format (must be YUV420, YUV422 or YUV444)");
 	}
 
-	int postProcessingMax;
-	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &postProcessingMax, sizeof(postProcessingMax));
-	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &postProcessingMax, sizeof(postProcessingMax));
+	th_decode_ctl(_theoraDecode, TH_DECCTL_GET_PPLEVEL_MAX, &_postProcessingMax, sizeof(_postProcessingMax));
+	th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &_postProcessingMax, sizeof(_postProcessingMax));
+	_postProcessingLevel = _postProcessingMax;
+	_framesOnTime = 0;
 
 	_x = theoraInfo.pic_x;
 	_y = theoraInfo.pic_y;
@@ -280,6 +334,8 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_
 	_frameRate = Common::Rational(theoraInfo.fps_numerator, theoraInfo.fps_denominator);
 
 	_endOfVideo = false;
+	_keyFrame = false;
+	_frameStartTime = 0.0;
 	_nextFrameStartTime = 0.0;
 	_curFrame = -1;
 	_surface = nullptr;
@@ -287,6 +343,7 @@ TheoraDecoder::TheoraVideoTrack::TheoraVideoTrack(th_info &theoraInfo, th_setup_
 }
 
 TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
+	_conversionTasks.wait();
 	th_decode_free(_theoraDecode);
 
 	if (_surface) {
@@ -303,13 +360,18 @@ TheoraDecoder::TheoraVideoTrack::~TheoraVideoTrack() {
 }
 
 bool TheoraDecoder::TheoraVideoTrack::decodePacket(ogg_packet &oggPacket) {
+	const bool keyFrame = th_packet_iskeyframe(&oggPacket) == 1;
+
 	if (th_decode_packetin(_theoraDecode, &oggPacket, 0) == 0) {
 		_curFrame++;
+		_keyFrame = keyFrame;
 
-		// Convert YUV data to RGB data
-		th_ycbcr_buffer yuv;
-		th_decode_ycbcr_out(_theoraDecode, yuv);
-		translateYUVtoRGBA(yuv);
+		// Get the YUV data, which is converted to RGB by startConversion()
+		th_decode_ycbcr_out(_theoraDecode, _yuvBuffer);
+
+		// The granule time is when the frame stops being shown, so the
+		// frame starts when the previous one ends
+		_frameStartTime = _nextFrameStartTime;
 
 		double time = th_granule_time(_theoraDecode, oggPacket.granulepos);
 
@@ -334,18 +396,18 @@ enum TheoraYUVBuffers {
 	kBufferV = 2
 };
 
-void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer) {
+void TheoraDecoder::TheoraVideoTrack::startConversion() {
 	// Width and height of all buffers have to be divisible by 2.
-	assert((YUVBuffer[kBufferY].width & 1) == 0);
-	assert((YUVBuffer[kBufferY].height & 1) == 0);
-	assert((YUVBuffer[kBufferU].width & 1) == 0);
-	assert((YUVBuffer[kBufferV].width & 1) == 0);
+	assert((_yuvBuffer[kBufferY].width & 1) == 0);
+	assert((_yuvBuffer[kBufferY].height & 1) == 0);
+	assert((_yuvBuffer[kBufferU].width & 1) == 0);
+	assert((_yuvBuffer[kBufferV].width & 1) == 0);
 
 	// UV components must be half or equal the Y component
-	assert((YUVBuffer[kBufferU].width == YUVBuffer[kBufferY].width >> 1) || (YUVBuffer[kBufferU].width == YUVBuffer[kBufferY].width));
-	assert((YUVBuffer[kBufferV].width == YUVBuffer[kBufferY].width >> 1) || (YUVBuffer[kBufferV].width == YUVBuffer[kBufferY].width));
-	assert((YUVBuffer[kBufferU].height == YUVBuffer[kBufferY].height >> 1) || (YUVBuffer[kBufferU].height == YUVBuffer[kBufferY].height));
-	assert((YUVBuffer[kBufferV].height == YUVBuffer[kBufferY].height >> 1) || (YUVBuffer[kBufferV].height == YUVBuffer[kBufferY].height));
+	assert((_yuvBuffer[kBufferU].width == _yuvBuffer[kBufferY].width >> 1) || (_yuvBuffer[kBufferU].width == _yuvBuffer[kBufferY].width));
+	assert((_yuvBuffer[kBufferV].width == _yuvBuffer[kBufferY].width >> 1) || (_yuvBuffer[kBufferV].width == _yuvBuffer[kBufferY].width));
+	assert((_yuvBuffer[kBufferU].height == _yuvBuffer[kBufferY].height >> 1) || (_yuvBuffer[kBufferU].height == _yuvBuffer[kBufferY].height));
+	assert((_yuvBuffer[kBufferV].height == _yuvBuffer[kBufferY].height >> 1) || (_yuvBuffer[kBufferV].height == _yuvBuffer[kBufferY].height));
 
 	if (!_surface) {
 		_surface = new Graphics::Surface();
@@ -359,16 +421,63 @@ void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(th_ycbcr_buffer &YUVBuf
 		                      _surface->getBasePtr(_x, _y), _surface->format);
 	}
 
+	// Split the frame into bands of lines for the worker threads, which
+	// convert them while the audio is decoded
+	const int height = _yuvBuffer[kBufferY].height;
+	int bandHeight = height;
+	if (TaskPoolMan.getNumWorkers() > 0)
+		bandHeight = MAX<int>(((height / (TaskPoolMan.getNumWorkers() + 1)) + 15) & ~15, 16);
+
+	for (int y = 0; y < height; y += bandHeight) {
+		const int lines = MIN(bandHeight, height - y);
+		_conversionTasks.run([this, y, lines]() { translateYUVtoRGBA(y, lines); });
+	}
+}
+
+void TheoraDecoder::TheoraVideoTrack::updatePostProcessing(bool late) {
+	int level = _postProcessingLevel;
+
+	if (late) {
+		_framesOnTime = 0;
+		if (level > 0)
+			level--;
+	} else if (++_framesOnTime >= MAX(_frameRate.toInt(), 1)) {
+		_framesOnTime = 0;
+		if (level < _postProcessingMax)
+			level++;
+	}
+
+	if (level != _postProcessingLevel) {
+		_postProcessingLevel = level;
+		th_decode_ctl(_theoraDecode, TH_DECCTL_SET_PPLEVEL, &level, sizeof(level));
+	}
+}
+
+void TheoraDecoder::TheoraVideoTrack::translateYUVtoRGBA(int y, int height) {
+	Graphics::Surface band;
+	band.init(_surface->w, height, _surface->pitch, _surface->getBasePtr(0, y), _surface->format);
+
+	const int yStride = _yuvBuffer[kBufferY].stride;
+	const int uvStride = _yuvBuffer[kBufferU].stride;
+	const int width = _yuvBuffer[kBufferY].width;
+	const byte *ySrc = _yuvBuffer[kBufferY].data + y * yStride;
+
 	switch (_theoraPixelFormat) {
-	case TH_PF_420:
-		YUVToRGBMan.convert420(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+	case TH_PF_420: {
+		const int uvOffset = (y / 2) * uvStride;
+		YUVToRGBMan.convert420(&band, Graphics::YUVToRGBManager::kScaleITU, ySrc, _yuvBuffer[kBufferU].data + uvOffset, _yuvBuffer[kBufferV].data + uvOffset, width, height, yStride, uvStride);
 		break;
-	case TH_PF_422:
-		YUVToRGBMan.convert422(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+	}
+	case TH_PF_422: {
+		const int uvOffset = y * uvStride;
+		YUVToRGBMan.convert422(&band, Graphics::YUVToRGBManager::kScaleITU, ySrc, _yuvBuffer[kBufferU].data + uvOffset, _yuvBuffer[kBufferV].data + uvOffset, width, height, yStride, uvStride);
 		break;
-	case TH_PF_444:
-		YUVToRGBMan.convert444(_surface, Graphics::YUVToRGBManager::kScaleITU, YUVBuffer[kBufferY].data, YUVBuffer[kBufferU].data, YUVBuffer[kBufferV].data, YUVBuffer[kBufferY].width, YUVBuffer[kBufferY].height, YUVBuffer[kBufferY].stride, YUVBuffer[kBufferU].stride);
+	}
+	case TH_PF_444: {
+		const int uvOffset = y * uvStride;
+		YUVToRGBMan.convert444(&band, Graphics::YUVToRGBManager::kScaleITU, ySrc, _yuvBuffer[kBufferU].data + uvOffset, _yuvBuffer[kBufferV].data + uvOffset, width, height, yStride, uvStride);
 		break;
+	}
 	default:
 		error("Unsupported Theora pixel format");
 	}
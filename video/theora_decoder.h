@@ -27,6 +27,7 @@
 #define VIDEO_THEORA_DECODER_H
 
 #include "common/rational.h"
+#include "common/taskpool.h"
 #include "video/video_decoder.h"
 #include "audio/mixer.h"
 #include "graphics/surface.h"
@@ -70,11 +71,45 @@ public:
 	bool loadStream(Common::SeekableReadStream *stream);
 	void close();
 
+	const Graphics::Surface *decodeNextFrame();
+
 	/** Frames per second of the loaded video. */
 	Common::Rational getFrameRate() const;
 
+	/** Counters of the frames decoded while the video was playing. */
+	struct FrameStats {
+		uint32 decodedFrames; ///< Frames decoded by libtheora
+		uint32 lateFrames;    ///< Frames asked for after the next one was due
+		uint32 droppedFrames; ///< Late frames which were not converted
+	};
+
+	/**
+	 * Set whether frames decoded too late to be shown are dropped.
+	 *
+	 * When the decoder falls behind the time of the video, the frames whose
+	 * turn has already passed are decoded, as the next ones depend on them,
+	 * but not converted to RGB. Key frames are always converted. The post
+	 * processing level is lowered as well while frames are late, and raised
+	 * again once they are on time.
+	 *
+	 * This is enabled by default.
+	 */
+	void setFrameDropping(bool enable) { _frameDropping = enable; }
+
+	/**
+	 * Return the frame counters since the video was loaded or the counters
+	 * were reset.
+	 */
+	const FrameStats &getFrameStats() const { return _frameStats; }
+
+	/** Reset the frame counters. */
+	void resetFrameStats();
+
 protected:
 	void readNextPacket();
+	// Late frames are dropped against the clock of the video when
+	// decodeNextFrame() is called, not while decoding ahead
+	bool supportsDecodeAhead() const { return false; }
 
 private:
 	class TheoraVideoTrack : public VideoTrack {
@@ -101,10 +136,31 @@ private:
 		bool decodePacket(ogg_packet &oggPacket);
 		void setEndOfVideo() { _endOfVideo = true; }
 
+		/** Return the time the last decoded frame is due, in milliseconds. */
+		uint32 getFrameStartTime() const { return (uint32)(_frameStartTime * 1000); }
+		bool isKeyFrame() const { return _keyFrame; }
+		bool hasFrame() const { return _surface != nullptr; }
+
+		/**
+		 * Start converting the last decoded frame, on the worker threads
+		 * if there are any. The frame must not be decoded further until
+		 * waitForConversion() returned.
+		 */
+		void startConversion();
+		void waitForConversion() { _conversionTasks.wait(); }
+
+		/**
+		 * Lower the post processing level when frames are late, and raise
+		 * it again after a second of frames on time.
+		 */
+		void updatePostProcessing(bool late);
+
 	private:
 		int _curFrame;
 		bool _endOfVideo;
+		bool _keyFrame;
 		Common::Rational _frameRate;
+		double _frameStartTime;
 		double _nextFrameStartTime;
 
 		Graphics::Surface *_surface;
@@ -119,8 +175,15 @@ private:
 
 		th_dec_ctx *_theoraDecode;
 		th_pixel_fmt _theoraPixelFormat;
+		th_ycbcr_buffer _yuvBuffer;
 
-		void translateYUVtoRGBA(th_ycbcr_buffer &YUVBuffer);
+		int _postProcessingLevel;
+		int _postProcessingMax;
+		int _framesOnTime;
+
+		Common::TaskGroup _conversionTasks;
+
+		void translateYUVtoRGBA(int y, int height);
 	};
 
 	class VorbisAudioTrack : public AudioTrack {
@@ -154,6 +217,7 @@ private:
 	int bufferData();
 	bool queueAudio();
 	void ensureAudioBufferSize();
+	void finishFrame(int32 time);
 
 	Common::SeekableReadStream *_fileStream;
 
@@ -168,6 +232,10 @@ private:
 
 	TheoraVideoTrack *_videoTrack;
 	VorbisAudioTrack *_audioTrack;
+
+	bool _frameDropping;
+	FrameStats _frameStats;
+	int32 _decodeTime; ///< Time of the video when the frame was asked for, -1 if not playing
 };
 
 } // End of namespace Video
@@ -27,9 +27,31 @@
 #include "common/rational.h"
 #include "common/file.h"
 #include "common/system.h"
+#include "common/taskpool.h"
+
+#include "graphics/blit.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * A frame decoded ahead, with the state of the track after decoding it.
+ */
+struct VideoDecoder::DecodedFrame {
+	DecodedFrame() : hasSurface(false), dirtyPalette(false), curFrame(-1), curFrameDelay(0), nextFrameStartTime(0), endOfTrack(false) {}
+	~DecodedFrame() { surface.free(); }
+
+	Graphics::Surface surface;
+	bool hasSurface;
+	bool dirtyPalette;
+	byte palette[256 * 3];
+
+	int curFrame;
+	int curFrameDelay;
+	uint32 nextFrameStartTime;
+	bool endOfTrack;
+};
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -48,9 +70,28 @@ VideoDecoder::VideoDecoder() {
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
 	_videoCodecAccuracy = Image::CodecAccuracy::Default;
+
+	_decodeAheadFrames = 0;
+	_decodeAheadActive = false;
+	_decodeAheadStop = false;
+	_decodeAheadEnded = false;
+	_decodeAheadTrack = 0;
+	_decodeAheadGroup = 0;
+	_shownFrame = 0;
+}
+
+VideoDecoder::~VideoDecoder() {
+	// Subclasses close the video in their destructor, so the worker is
+	// done by now
+	discardDecodedFrames();
+	freeDecodedFrames();
+	delete _decodeAheadGroup;
 }
 
 void VideoDecoder::close() {
+	discardDecodedFrames();
+	freeDecodedFrames();
+
 	if (isPlaying())
 		stop();
 
@@ -136,6 +177,9 @@ void VideoDecoder::pauseVideo(bool pause) {
 	if (_pauseLevel == 1 && pause) {
 		_pauseStartTime = g_system->getMillis(); // Store the starting time from pausing to keep it for later
 
+		// No decoding ahead while paused
+		stopDecodeAhead();
+
 		for (auto &track : _tracks)
 			track->pause(true);
 	} else if (_pauseLevel == 0) {
@@ -212,6 +256,29 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (_decodeAheadActive) {
+		DecodedFrame *frame = takeDecodedFrame();
+		if (frame)
+			return showDecodedFrame(frame);
+
+		// All the frames decoded ahead were shown, so the tracks are back
+		// to the frame shown
+		_decodeAheadActive = false;
+	}
+
+	_decodeAheadTrack = findDecodeAheadTrack();
+	if (_decodeAheadTrack) {
+		// The tracks reuse their surface for the next frame, so this one is
+		// copied as well before the worker starts
+		_decodeAheadMutex.lock();
+		DecodedFrame *frame = takeFreeFrame();
+		_decodeAheadMutex.unlock();
+
+		decodeFrame(*frame);
+		_decodeAheadEnded = frame->endOfTrack;
+		return showDecodedFrame(frame);
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -232,11 +299,67 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+bool VideoDecoder::decodeNextFrameInto(Graphics::Surface &dst) {
+	// Frames decoded ahead are already in surfaces of their own
+	VideoTrack *directTrack = 0;
+	if (!_decodeAheadActive && !findDecodeAheadTrack()) {
+		for (auto &track : _tracks) {
+			if (track->getTrackType() == Track::kTrackTypeVideo) {
+				// Only decode straight into the surface when one video
+				// track is present
+				if (directTrack) {
+					directTrack = 0;
+					break;
+				}
+
+				directTrack = (VideoTrack *)track;
+			}
+		}
+
+		if (directTrack && !directTrack->setOutputSurface(&dst))
+			directTrack = 0;
+	}
+
+	const Graphics::Surface *frame = decodeNextFrame();
+
+	if (directTrack)
+		directTrack->setOutputSurface(0);
+
+	if (!frame)
+		return false;
+
+	if (frame == &dst)
+		return true;
+
+	const uint w = MIN(frame->w, dst.w);
+	const uint h = MIN(frame->h, dst.h);
+
+	if (frame->format == dst.format) {
+		Graphics::copyBlit((byte *)dst.getPixels(), (const byte *)frame->getPixels(), dst.pitch, frame->pitch, w, h, dst.format.bytesPerPixel);
+		return true;
+	}
+
+	if (frame->format.isCLUT8()) {
+		if (!_palette)
+			return false;
+
+		uint32 map[256];
+		Graphics::convertPaletteToMap(map, _palette, 256, dst.format);
+		return Graphics::crossBlitMap((byte *)dst.getPixels(), (const byte *)frame->getPixels(), dst.pitch, frame->pitch, w, h, dst.format.bytesPerPixel, map);
+	}
+
+	return Graphics::crossBlit((byte *)dst.getPixels(), (const byte *)frame->getPixels(), dst.pitch, frame->pitch, w, h, dst.format, frame->format);
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// The tracks must be back to the frame shown before they turn around
+	if (reverse && !rewindDecodeAhead())
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (auto &track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)track)->isReversed() != reverse) {
@@ -261,7 +384,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (const auto &track : _tracks)
 		if (track->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)track)->getCurFrame() + 1;
+			frame += getTrackCurFrame((const VideoTrack *)track) + 1;
 
 	return frame;
 }
@@ -271,7 +394,7 @@ int VideoDecoder::getCurFrameDelay() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrameDelay() + 1;
+			frame += getTrackCurFrameDelay((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -309,13 +432,15 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	const VideoTrack *nextVideoTrack = getShownNextVideoTrack();
+
+	if (endOfVideo() || _needsUpdate || !nextVideoTrack)
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getTrackNextFrameStartTime(nextVideoTrack);
 
-	if (_nextVideoTrack->isReversed()) {
+	if (nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
 		if (nextFrameStartTime >= currentTime)
 			return 0;
@@ -332,8 +457,8 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 
 bool VideoDecoder::endOfVideo() const {
 	for (const auto &track : _tracks) {
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && getTrackNextFrameStartTime((const VideoTrack *)track) >= (uint)_endTime.msecs();
+		bool endReached = trackEnded(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -356,6 +481,8 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	discardDecodedFrames();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -390,6 +517,8 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	discardDecodedFrames();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
@@ -456,6 +585,8 @@ void VideoDecoder::stop() {
 	if (!isPlaying())
 		return;
 
+	stopDecodeAhead();
+
 	// Stop audio here so we don't have it affect getTime()
 	stopAudio();
 
@@ -588,6 +719,9 @@ bool VideoDecoder::setOutputPixelFormats(const Common::List<Graphics::PixelForma
 void VideoDecoder::setVideoCodecAccuracy(Image::CodecAccuracy accuracy) {
 	_videoCodecAccuracy = accuracy;
 
+	// Frames decoded ahead already keep the previous accuracy
+	stopDecodeAhead();
+
 	for (Track *track : _tracks) {
 		if (track->getTrackType() == Track::kTrackTypeVideo)
 			static_cast<VideoTrack *>(track)->setCodecAccuracy(accuracy);
@@ -817,6 +951,9 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::Path &baseNa
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	// The worker goes through the tracks
+	stopDecodeAhead();
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -958,8 +1095,9 @@ void VideoDecoder::setEndFrame(uint frame) {
 }
 
 void VideoDecoder::resetStartTime() {
-	if (_nextVideoTrack) {
-		Audio::Timestamp curTime = _nextVideoTrack->getFrameTime(_nextVideoTrack->getCurFrame());
+	const VideoTrack *nextVideoTrack = getShownNextVideoTrack();
+	if (nextVideoTrack) {
+		Audio::Timestamp curTime = nextVideoTrack->getFrameTime(getTrackCurFrame(nextVideoTrack));
 		if (isPlaying()) {
 			_startTime = g_system->getMillis() - (curTime.msecs() / _playbackRate).toInt();
 		}
@@ -982,7 +1120,7 @@ const VideoDecoder::Track *VideoDecoder::getTrack(uint track) const {
 
 bool VideoDecoder::endOfVideoTracks() const {
 	for (const auto &track : _tracks)
-		if (track->getTrackType() == Track::kTrackTypeVideo && !track->endOfTrack())
+		if (track->getTrackType() == Track::kTrackTypeVideo && !trackEnded(track))
 			return false;
 
 	return true;
@@ -1049,8 +1187,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *videoTrack = (const VideoTrack *)track;
 
-		bool videoEndTimeReached = _endTimeSet && videoTrack->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = videoTrack->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getTrackNextFrameStartTime(videoTrack) >= (uint)_endTime.msecs();
+		bool endReached = trackEnded(videoTrack) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -1067,6 +1205,8 @@ bool VideoDecoder::hasAudio() const {
 }
 
 void VideoDecoder::eraseTrack(Track *track) {
+	discardDecodedFrames();
+
 	for (uint idx = 0; idx < _externalTracks.size(); ++idx) {
 		if (_externalTracks[idx] == track)
 			_externalTracks.remove_at(idx);
@@ -1083,4 +1223,248 @@ void VideoDecoder::eraseTrack(Track *track) {
 	}
 }
 
+void VideoDecoder::setDecodeAhead(uint frames) {
+	Common::StackLock lock(_decodeAheadMutex);
+	_decodeAheadFrames = frames;
+}
+
+VideoDecoder::VideoTrack *VideoDecoder::findDecodeAheadTrack() const {
+	if (_decodeAheadFrames == 0 || isPaused() || !supportsDecodeAhead() || TaskPoolMan.getNumWorkers() == 0)
+		return 0;
+
+	VideoTrack *videoTrack = 0;
+
+	for (const auto &track : _tracks) {
+		if (track->getTrackType() == Track::kTrackTypeVideo) {
+			// Frames are only decoded ahead when one video track is present
+			if (videoTrack)
+				return 0;
+
+			videoTrack = (VideoTrack *)track;
+		}
+	}
+
+	if (!videoTrack || videoTrack->isReversed())
+		return 0;
+
+	return videoTrack;
+}
+
+void VideoDecoder::decodeFrame(DecodedFrame &frame) {
+	readNextPacket();
+
+	const Graphics::Surface *surface = 0;
+	frame.dirtyPalette = false;
+
+	if (_nextVideoTrack) {
+		surface = _nextVideoTrack->decodeNextFrame();
+
+		if (_nextVideoTrack->hasDirtyPalette()) {
+			memcpy(frame.palette, _nextVideoTrack->getPalette(), sizeof(frame.palette));
+			frame.dirtyPalette = true;
+		}
+
+		findNextVideoTrack();
+	}
+
+	frame.hasSurface = surface != 0;
+	if (surface) {
+		// Keep the buffer of the frame if it has the right size
+		if (frame.surface.w != surface->w || frame.surface.h != surface->h || frame.surface.format != surface->format)
+			frame.surface.create(surface->w, surface->h, surface->format);
+
+		frame.surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame.curFrame = _decodeAheadTrack->getCurFrame();
+	frame.curFrameDelay = _decodeAheadTrack->getCurFrameDelay();
+	frame.nextFrameStartTime = _decodeAheadTrack->getNextFrameStartTime();
+	frame.endOfTrack = _decodeAheadTrack->endOfTrack();
+}
+
+void VideoDecoder::decodeAhead() {
+	for (;;) {
+		DecodedFrame *frame;
+
+		{
+			Common::StackLock lock(_decodeAheadMutex);
+			if (_decodeAheadStop || _decodeAheadEnded || _readyFrames.size() >= (int)_decodeAheadFrames)
+				return;
+
+			frame = takeFreeFrame();
+		}
+
+		decodeFrame(*frame);
+
+		Common::StackLock lock(_decodeAheadMutex);
+		_readyFrames.push(frame);
+		_decodeAheadEnded = frame->endOfTrack;
+	}
+}
+
+void VideoDecoder::scheduleDecodeAhead() {
+	// The worker may still be decoding, but then it goes on until the queue
+	// is full or it is stopped
+	if (_decodeAheadGroup && !_decodeAheadGroup->isDone())
+		return;
+
+	if (_decodeAheadEnded || findDecodeAheadTrack() != _decodeAheadTrack)
+		return;
+
+	if (!_decodeAheadGroup)
+		_decodeAheadGroup = new Common::TaskGroup();
+
+	_decodeAheadActive = true;
+	_decodeAheadGroup->run([this]() { decodeAhead(); });
+}
+
+const Graphics::Surface *VideoDecoder::showDecodedFrame(DecodedFrame *frame) {
+	if (_shownFrame) {
+		Common::StackLock lock(_decodeAheadMutex);
+		_freeFrames.push_back(_shownFrame);
+	}
+
+	_shownFrame = frame;
+
+	// The palette of the track changes as the next frames are decoded
+	if (frame->dirtyPalette) {
+		memcpy(_decodeAheadPalette, frame->palette, sizeof(_decodeAheadPalette));
+		_palette = _decodeAheadPalette;
+		_dirtyPalette = true;
+	}
+
+	scheduleDecodeAhead();
+
+	return frame->hasSurface ? &frame->surface : 0;
+}
+
+VideoDecoder::DecodedFrame *VideoDecoder::takeDecodedFrame() {
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		if (!_readyFrames.empty())
+			return _readyFrames.pop();
+	}
+
+	// The next frame is still being decoded, let the worker finish it
+	stopDecodeAhead();
+
+	Common::StackLock lock(_decodeAheadMutex);
+	if (!_readyFrames.empty())
+		return _readyFrames.pop();
+
+	return 0;
+}
+
+VideoDecoder::DecodedFrame *VideoDecoder::takeFreeFrame() {
+	if (_freeFrames.empty())
+		return new DecodedFrame();
+
+	DecodedFrame *frame = _freeFrames.back();
+	_freeFrames.pop_back();
+	return frame;
+}
+
+void VideoDecoder::stopDecodeAhead() {
+	if (!_decodeAheadGroup)
+		return;
+
+	_decodeAheadMutex.lock();
+	_decodeAheadStop = true;
+	_decodeAheadMutex.unlock();
+
+	_decodeAheadGroup->wait();
+
+	_decodeAheadMutex.lock();
+	_decodeAheadStop = false;
+	_decodeAheadMutex.unlock();
+}
+
+void VideoDecoder::discardDecodedFrames() {
+	stopDecodeAhead();
+
+	Common::StackLock lock(_decodeAheadMutex);
+	while (!_readyFrames.empty())
+		_freeFrames.push_back(_readyFrames.pop());
+
+	_decodeAheadActive = false;
+	_decodeAheadEnded = false;
+}
+
+void VideoDecoder::freeDecodedFrames() {
+	for (uint i = 0; i < _freeFrames.size(); i++)
+		delete _freeFrames[i];
+
+	_freeFrames.clear();
+
+	delete _shownFrame;
+	_shownFrame = 0;
+}
+
+bool VideoDecoder::rewindDecodeAhead() {
+	stopDecodeAhead();
+
+	if (!_decodeAheadActive)
+		return true;
+
+	bool framesLeft;
+	{
+		Common::StackLock lock(_decodeAheadMutex);
+		framesLeft = !_readyFrames.empty();
+	}
+
+	if (!framesLeft) {
+		_decodeAheadActive = false;
+		return true;
+	}
+
+	// Seek the tracks back to the frame after the one shown
+	Audio::Timestamp time = _decodeAheadTrack->getFrameTime(_shownFrame->curFrame + 1);
+	if (!isSeekable() || time < 0)
+		return false;
+
+	discardDecodedFrames();
+
+	if (!seekIntern(time))
+		return false;
+
+	findNextVideoTrack();
+	return true;
+}
+
+int VideoDecoder::getTrackCurFrame(const VideoTrack *track) const {
+	if (_decodeAheadActive && track == _decodeAheadTrack)
+		return _shownFrame->curFrame;
+
+	return track->getCurFrame();
+}
+
+int VideoDecoder::getTrackCurFrameDelay(const VideoTrack *track) const {
+	if (_decodeAheadActive && track == _decodeAheadTrack)
+		return _shownFrame->curFrameDelay;
+
+	return track->getCurFrameDelay();
+}
+
+uint32 VideoDecoder::getTrackNextFrameStartTime(const VideoTrack *track) const {
+	if (_decodeAheadActive && track == _decodeAheadTrack)
+		return _shownFrame->nextFrameStartTime;
+
+	return track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::trackEnded(const Track *track) const {
+	if (_decodeAheadActive && track == _decodeAheadTrack)
+		return _shownFrame->endOfTrack;
+
+	return track->endOfTrack();
+}
+
+const VideoDecoder::VideoTrack *VideoDecoder::getShownNextVideoTrack() const {
+	// The worker moves _nextVideoTrack on while decoding ahead
+	if (_decodeAheadActive)
+		return _shownFrame->endOfTrack ? 0 : _decodeAheadTrack;
+
+	return _nextVideoTrack;
+}
+
 } // End of namespace Video
@@ -25,7 +25,9 @@
 #include "audio/mixer.h"
 #include "audio/timestamp.h"	// TODO: Move this to common/ ?
 #include "common/array.h"
+#include "common/mutex.h"
 #include "common/path.h"
+#include "common/queue.h"
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
@@ -39,6 +41,7 @@ class SeekableAudioStream;
 
 namespace Common {
 class SeekableReadStream;
+class TaskGroup;
 }
 
 namespace Graphics {
@@ -53,7 +56,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -371,6 +374,43 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame straight into a surface, converting it to the
+	 * pixel format of that surface.
+	 *
+	 * This is meant for surfaces provided by the backend, such as the one
+	 * returned by OSystem::lockScreen(). Tracks which convert their frames,
+	 * e.g. from YUV, write them into @p dst directly. The frames of the
+	 * other tracks are blitted once into @p dst, instead of being converted
+	 * into an intermediate surface first.
+	 *
+	 * The frame is clipped to the size of @p dst, so use
+	 * Graphics::Surface::getSubArea() to place it.
+	 *
+	 * @param dst The surface to decode into
+	 * @return whether a frame was decoded into @p dst
+	 * @note If this returns false, the last frame should be kept on screen
+	 */
+	bool decodeNextFrameInto(Graphics::Surface &dst);
+
+	/**
+	 * Set how many frames to decode ahead of the one shown.
+	 *
+	 * The next frames are then decoded on the worker threads of the task
+	 * pool while the current one is shown, so that a frame which takes long
+	 * to decode does not hold up playback. Each frame decoded ahead is
+	 * copied into a surface of its own, so this costs up to @p frames
+	 * more frame buffers.
+	 *
+	 * This only applies to decoders which support it, to videos with a
+	 * single video track played forward, and when the task pool has worker
+	 * threads. Otherwise, and by default, frames are decoded when
+	 * decodeNextFrame() is called.
+	 *
+	 * @param frames The number of frames to decode ahead, 0 to disable it
+	 */
+	void setDecodeAhead(uint frames);
+
 	/**
 	 * Set the video to decode frames in reverse.
 	 *
@@ -661,6 +701,20 @@ protected:
 		 */
 		virtual const Graphics::Surface *decodeNextFrame() = 0;
 
+		/**
+		 * Set a surface for the next frames to be decoded into.
+		 *
+		 * A track supporting this converts its frames straight into
+		 * @p surface, in the pixel format of @p surface, and
+		 * decodeNextFrame() returns @p surface. By default, tracks
+		 * decode into a surface of their own.
+		 *
+		 * @param surface The surface to decode into, or 0 to use the track's own
+		 * @return true if the frames are decoded into @p surface, false otherwise
+		 * @see VideoDecoder::decodeNextFrameInto()
+		 */
+		virtual bool setOutputSurface(Graphics::Surface *surface) { return !surface; }
+
 		/**
 		 * Get the palette currently in use by this track
 		 */
@@ -997,6 +1051,23 @@ protected:
 	 */
 	virtual bool supportsAudioTrackSwitching() const { return false; }
 
+	/**
+	 * Can frames be decoded ahead on another thread?
+	 *
+	 * While frames are decoded ahead, readNextPacket() and decodeNextFrame()
+	 * of the video track run on a worker thread. Meanwhile, the calling
+	 * thread still queries the audio tracks and the properties of the video
+	 * track which do not change during playback.
+	 *
+	 * Only subclasses audited for this return true. They must not override
+	 * decodeNextFrame(), and readNextPacket() must only pass audio to the
+	 * audio tracks through streams safe to use from another thread, such as
+	 * QueuingAudioStream.
+	 *
+	 * @see setDecodeAhead()
+	 */
+	virtual bool supportsDecodeAhead() const { return false; }
+
 	/**
 	 * Get the audio track for the given index.
 	 *
@@ -1053,6 +1124,39 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Decoding frames ahead on the task pool
+	struct DecodedFrame;
+
+	VideoTrack *findDecodeAheadTrack() const;
+	void decodeFrame(DecodedFrame &frame);
+	void decodeAhead();
+	void scheduleDecodeAhead();
+	const Graphics::Surface *showDecodedFrame(DecodedFrame *frame);
+	DecodedFrame *takeDecodedFrame();
+	DecodedFrame *takeFreeFrame();
+	void stopDecodeAhead();
+	void discardDecodedFrames();
+	void freeDecodedFrames();
+	bool rewindDecodeAhead();
+
+	int getTrackCurFrame(const VideoTrack *track) const;
+	int getTrackCurFrameDelay(const VideoTrack *track) const;
+	uint32 getTrackNextFrameStartTime(const VideoTrack *track) const;
+	bool trackEnded(const Track *track) const;
+	const VideoTrack *getShownNextVideoTrack() const;
+
+	uint _decodeAheadFrames;
+	bool _decodeAheadActive;        ///< The tracks are ahead of the frame shown
+	bool _decodeAheadStop;          ///< Tells the worker to stop after the current frame
+	bool _decodeAheadEnded;         ///< The last frame of the track was decoded
+	VideoTrack *_decodeAheadTrack;
+	Common::TaskGroup *_decodeAheadGroup;
+	Common::Mutex _decodeAheadMutex;
+	Common::Queue<DecodedFrame *> _readyFrames;
+	Common::Array<DecodedFrame *> _freeFrames;
+	DecodedFrame *_shownFrame;
+	byte _decodeAheadPalette[256 * 3];
 };
 
 } // End of namespace Video